@@ -0,0 +1,676 @@
+/**
+ * \file BatchFFT.cpp
+ * \brief 2D DFT of many planes of the same size with a choice of backends
+ * \version 1.0
+ * \date October 17, 2026
+ *
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the distribution
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "BatchFFT.h"
+#include "Profiler.h"
+#include <cstring>
+#include <map>
+#ifdef HAVE_FFTW
+#include <fftw3.h>
+#endif
+
+/*!
+ *  \brief Get the largest prime factor of an integer
+ */
+static int largestPrimeFactor(int n){
+	int res=1;
+	for(int p=2;p*p<=n;p++)
+		while(n%p==0){
+			res=p;
+			n/=p;
+		}
+	return n>1 ? std::max(res,n) : res;
+}
+
+template<typename T> void FFTEngine_<T>::executeStack(const T* in,T* out,const int& count,const bool& inverse){
+	const size_t planeSize=2*(size_t)getSize().area();
+	AutoBuffer<const T*> inBuffer(count);
+	AutoBuffer<T*> outBuffer(count);
+	const T** ins=inBuffer;
+	T** outs=outBuffer;
+	for(int k=0;k<count;k++){
+		ins[k]=in+k*planeSize;
+		outs[k]=out+k*planeSize;
+	}
+	execute(ins,outs,count,inverse);
+}
+
+template<typename T> FFTEngine_<T>::~FFTEngine_() {
+}
+
+/*! \class OpenCVEngine
+   * \brief Backend which calls cv::dft on each plane
+   */
+template<typename T> class OpenCVEngine : public FFTEngine_<T> {
+private:
+	int rows;		/*!< Number of rows of the planes */
+	int cols;		/*!< Number of columns of the planes */
+public:
+	OpenCVEngine(const int& rows,const int& cols) : rows(rows), cols(cols) {
+	}
+	virtual void execute(const T* const* in,T* const* out,const int& count,const bool& inverse){
+		const int type=CV_MAKETYPE(DataType<T>::depth,2);
+		for(int k=0;k<count;k++){
+			Mat X(rows,cols,type,(void*)in[k]);
+			Mat Y(rows,cols,type,out[k]);
+			dft(X,Y,inverse ? DFT_INVERSE : 0,0);
+		}
+	}
+	virtual Size getSize() const{
+		return Size(cols,rows);
+	}
+};
+
+/*!
+ *  \brief Tables of the 1D FFT of one dimension of the planes
+ *
+ *  Stockham autosort formulation: the stage s of radix R reads the vectors j+r.n/R and writes
+ *  the vectors (j/Ns).Ns.R+j%Ns+r.Ns (r<R), where Ns is the product of the previous radices.
+ */
+template<typename T> struct FFTAxis {
+	int n;						/*!< The size of the DFT */
+	vector<int> radices;		/*!< The radix of each stage */
+	vector<int> offsets;		/*!< The first twiddle of each stage (in complex numbers) */
+	vector<T> twiddles[2];		/*!< exp(-+2i.pi.k.r/(Ns.R)) for the forward and inverse DFT (re,im) */
+	vector<int> rootOffsets;	/*!< The first root of each stage of generic radix */
+	vector<T> roots[2];			/*!< exp(-+2i.pi.t/R) for the stages of generic radix */
+	int maxRadix;				/*!< The largest radix */
+
+	FFTAxis() : n(0), maxRadix(1) {
+	}
+	void init(const int& size){
+		n=size;
+		int m=n;
+		while(m%4==0){
+			radices.push_back(4);
+			m/=4;
+		}
+		const int small[]={2,3,5};
+		for(int i=0;i<3;i++)
+			while(m%small[i]==0){
+				radices.push_back(small[i]);
+				m/=small[i];
+			}
+		for(int p=7;m>1;p+=2)
+			while(m%p==0){
+				radices.push_back(p);
+				m/=p;
+			}
+
+		maxRadix=1;
+		int Ns=1;
+		for(size_t s=0;s<radices.size();s++){
+			const int R=radices[s];
+			maxRadix=std::max(maxRadix,R);
+			offsets.push_back((int)twiddles[0].size()/2);
+			for(int k=0;k<Ns;k++)
+				for(int r=0;r<R;r++){
+					double a=-2*CV_PI*k*r/(Ns*R);
+					twiddles[0].push_back((T)std::cos(a));
+					twiddles[0].push_back((T)std::sin(a));
+					twiddles[1].push_back((T)std::cos(a));
+					twiddles[1].push_back((T)-std::sin(a));
+				}
+			rootOffsets.push_back((int)roots[0].size()/2);
+			if(R>5)
+				for(int t=0;t<R;t++){
+					double a=-2*CV_PI*t/R;
+					roots[0].push_back((T)std::cos(a));
+					roots[0].push_back((T)std::sin(a));
+					roots[1].push_back((T)std::cos(a));
+					roots[1].push_back((T)-std::sin(a));
+				}
+			Ns*=R;
+		}
+	}
+};
+
+/*!
+ *  \brief Butterflies of radix 2 on vectors of L complex numbers
+ *
+ *  x (resp. y) is the first input (output) vector, the next ones are is (os) values further.
+ *  w are the twiddles of the inputs.
+ */
+template<typename T> static void butterfly2(const T* x,const size_t& is,T* y,const size_t& os,const T* w,const int& L){
+	const T* x1=x+is;
+	T* y1=y+os;
+	const T wr=w[2],wi=w[3];
+	for(int l=0;l<2*L;l+=2){
+		T br=x1[l]*wr-x1[l+1]*wi;
+		T bi=x1[l]*wi+x1[l+1]*wr;
+		y[l]=x[l]+br;
+		y[l+1]=x[l+1]+bi;
+		y1[l]=x[l]-br;
+		y1[l+1]=x[l+1]-bi;
+	}
+}
+
+template<typename T> static void butterfly3(const T* x,const size_t& is,T* y,const size_t& os,const T* w,const int& L,const T& sign){
+	const T* x1=x+is;
+	const T* x2=x1+is;
+	T* y1=y+os;
+	T* y2=y1+os;
+	const T s3=sign*(T)0.86602540378443864676;
+	for(int l=0;l<2*L;l+=2){
+		T br=x1[l]*w[2]-x1[l+1]*w[3];
+		T bi=x1[l]*w[3]+x1[l+1]*w[2];
+		T cr=x2[l]*w[4]-x2[l+1]*w[5];
+		T ci=x2[l]*w[5]+x2[l+1]*w[4];
+		T t1r=br+cr,t1i=bi+ci;
+		T t2r=x[l]-t1r/2,t2i=x[l+1]-t1i/2;
+		T t3r=s3*(br-cr),t3i=s3*(bi-ci);
+		y[l]=x[l]+t1r;
+		y[l+1]=x[l+1]+t1i;
+		y1[l]=t2r-t3i;
+		y1[l+1]=t2i+t3r;
+		y2[l]=t2r+t3i;
+		y2[l+1]=t2i-t3r;
+	}
+}
+
+template<typename T> static void butterfly4(const T* x,const size_t& is,T* y,const size_t& os,const T* w,const int& L,const T& sign){
+	const T* x1=x+is;
+	const T* x2=x1+is;
+	const T* x3=x2+is;
+	T* y1=y+os;
+	T* y2=y1+os;
+	T* y3=y2+os;
+	for(int l=0;l<2*L;l+=2){
+		T br=x1[l]*w[2]-x1[l+1]*w[3];
+		T bi=x1[l]*w[3]+x1[l+1]*w[2];
+		T cr=x2[l]*w[4]-x2[l+1]*w[5];
+		T ci=x2[l]*w[5]+x2[l+1]*w[4];
+		T dr=x3[l]*w[6]-x3[l+1]*w[7];
+		T di=x3[l]*w[7]+x3[l+1]*w[6];
+		T a0r=x[l]+cr,a0i=x[l+1]+ci;
+		T a1r=x[l]-cr,a1i=x[l+1]-ci;
+		T a2r=br+dr,a2i=bi+di;
+		// a3=sign.i.(b-d)
+		T a3r=-sign*(bi-di),a3i=sign*(br-dr);
+		y[l]=a0r+a2r;
+		y[l+1]=a0i+a2i;
+		y1[l]=a1r+a3r;
+		y1[l+1]=a1i+a3i;
+		y2[l]=a0r-a2r;
+		y2[l+1]=a0i-a2i;
+		y3[l]=a1r-a3r;
+		y3[l+1]=a1i-a3i;
+	}
+}
+
+template<typename T> static void butterfly5(const T* x,const size_t& is,T* y,const size_t& os,const T* w,const int& L,const T& sign){
+	const T* x1=x+is;
+	const T* x2=x1+is;
+	const T* x3=x2+is;
+	const T* x4=x3+is;
+	T* y1=y+os;
+	T* y2=y1+os;
+	T* y3=y2+os;
+	T* y4=y3+os;
+	const T c1=(T)0.30901699437494742410,c2=(T)-0.80901699437494742410;
+	const T s1=sign*(T)0.95105651629515357212,s2=sign*(T)0.58778525229247312917;
+	for(int l=0;l<2*L;l+=2){
+		T v1r=x1[l]*w[2]-x1[l+1]*w[3],v1i=x1[l]*w[3]+x1[l+1]*w[2];
+		T v2r=x2[l]*w[4]-x2[l+1]*w[5],v2i=x2[l]*w[5]+x2[l+1]*w[4];
+		T v3r=x3[l]*w[6]-x3[l+1]*w[7],v3i=x3[l]*w[7]+x3[l+1]*w[6];
+		T v4r=x4[l]*w[8]-x4[l+1]*w[9],v4i=x4[l]*w[9]+x4[l+1]*w[8];
+		T a1r=v1r+v4r,a1i=v1i+v4i,b1r=v1r-v4r,b1i=v1i-v4i;
+		T a2r=v2r+v3r,a2i=v2i+v3i,b2r=v2r-v3r,b2i=v2i-v3i;
+		T p1r=x[l]+c1*a1r+c2*a2r,p1i=x[l+1]+c1*a1i+c2*a2i;
+		T p2r=x[l]+c2*a1r+c1*a2r,p2i=x[l+1]+c2*a1i+c1*a2i;
+		// q1=s1.b1+s2.b2 and q2=s2.b1-s1.b2 are multiplied by i
+		T q1r=s1*b1r+s2*b2r,q1i=s1*b1i+s2*b2i;
+		T q2r=s2*b1r-s1*b2r,q2i=s2*b1i-s1*b2i;
+		y[l]=x[l]+a1r+a2r;
+		y[l+1]=x[l+1]+a1i+a2i;
+		y1[l]=p1r-q1i;
+		y1[l+1]=p1i+q1r;
+		y4[l]=p1r+q1i;
+		y4[l+1]=p1i-q1r;
+		y2[l]=p2r-q2i;
+		y2[l+1]=p2i+q2r;
+		y3[l]=p2r+q2i;
+		y3[l+1]=p2i-q2r;
+	}
+}
+
+/*!
+ *  \brief Butterflies of any radix R (a DFT of size R), tmp holds 2R values
+ */
+template<typename T> static void butterflyGeneric(const T* x,const size_t& is,T* y,const size_t& os,const T* w,const int& L,const int& R,const T* roots,T* tmp){
+	for(int l=0;l<2*L;l+=2){
+		for(int r=0;r<R;r++){
+			const T* xr=x+r*is+l;
+			tmp[2*r]=xr[0]*w[2*r]-xr[1]*w[2*r+1];
+			tmp[2*r+1]=xr[0]*w[2*r+1]+xr[1]*w[2*r];
+		}
+		for(int q=0;q<R;q++){
+			T sr=0,si=0;
+			for(int r=0,t=0;r<R;r++,t=(t+q)%R){
+				sr+=tmp[2*r]*roots[2*t]-tmp[2*r+1]*roots[2*t+1];
+				si+=tmp[2*r]*roots[2*t+1]+tmp[2*r+1]*roots[2*t];
+			}
+			y[q*os+l]=sr;
+			y[q*os+l+1]=si;
+		}
+	}
+}
+
+/*!
+ *  \brief Transpose a rows x cols complex array by blocks
+ */
+template<typename T> static void transposeComplex(const T* src,T* dst,const int& rows,const int& cols){
+	const int B=16;
+	for(int i0=0;i0<rows;i0+=B)
+		for(int j0=0;j0<cols;j0+=B){
+			const int i1=std::min(i0+B,rows);
+			const int j1=std::min(j0+B,cols);
+			for(int i=i0;i<i1;i++)
+				for(int j=j0;j<j1;j++){
+					dst[2*((size_t)j*rows+i)]=src[2*((size_t)i*cols+j)];
+					dst[2*((size_t)j*rows+i)+1]=src[2*((size_t)i*cols+j)+1];
+				}
+		}
+}
+
+/*! \class BuiltinEngine
+   * \brief Backend which uses the mixed-radix FFT of FFTAxis
+   */
+template<typename T> class BuiltinEngine : public FFTEngine_<T> {
+private:
+	int rows;				/*!< Number of rows of the planes */
+	int cols;				/*!< Number of columns of the planes */
+	FFTAxis<T> rowAxis;		/*!< The DFT along a row (of size cols) */
+	FFTAxis<T> colAxis;		/*!< The DFT along a column (of size rows) */
+	vector<T> work[2];		/*!< Two planes of work */
+	vector<T> tmp;			/*!< The values of a generic butterfly */
+
+	/*!
+	 *  \brief Compute the DFT of n vectors of L complex numbers (the DFT of L sequences at once)
+	 *
+	 *  \param axis : The tables of a DFT of size n
+	 *  \param src : The n input vectors, one after the other
+	 *  \param dst : The output (may be src)
+	 *  \param buffer : An array of the size of src, used by one stage out of two
+	 *  \param L : The length of the vectors
+	 *  \param inverse : Compute the inverse DFT
+	 */
+	void transformVectors(const FFTAxis<T>& axis,const T* src,T* dst,T* buffer,const int& L,const bool& inverse){
+		const int S=(int)axis.radices.size();
+		const size_t vs=2*(size_t)L;
+		if(S==0){
+			if(src!=dst)
+				memcpy(dst,src,vs*sizeof(T));
+			return;
+		}
+		// The stages write alternately in dst and in buffer so that the last one writes in dst
+		const T* in=src;
+		if(S%2==1 && src==dst){
+			memcpy(buffer,src,axis.n*vs*sizeof(T));
+			in=buffer;
+		}
+		T* out=S%2==1 ? dst : buffer;
+		const T sign=inverse ? 1 : -1;
+		int Ns=1;
+		for(int s=0;s<S;s++){
+			const int R=axis.radices[s];
+			const int m=axis.n/R;
+			const T* tw=&axis.twiddles[inverse][2*axis.offsets[s]];
+			const T* roots=R>5 ? &axis.roots[inverse][2*axis.rootOffsets[s]] : 0;
+			for(int j=0;j<m;j++){
+				const int k=j%Ns;
+				const T* w=tw+2*k*R;
+				const T* x=in+j*vs;
+				T* y=out+((j/Ns)*Ns*R+k)*vs;
+				switch(R){
+				case 2:
+					butterfly2(x,m*vs,y,Ns*vs,w,L);
+					break;
+				case 3:
+					butterfly3(x,m*vs,y,Ns*vs,w,L,sign);
+					break;
+				case 4:
+					butterfly4(x,m*vs,y,Ns*vs,w,L,sign);
+					break;
+				case 5:
+					butterfly5(x,m*vs,y,Ns*vs,w,L,sign);
+					break;
+				default:
+					butterflyGeneric(x,m*vs,y,Ns*vs,w,L,R,roots,&tmp[0]);
+				}
+			}
+			Ns*=R;
+			in=out;
+			out=out==dst ? buffer : dst;
+		}
+	}
+
+public:
+	BuiltinEngine(const int& rows,const int& cols) : rows(rows), cols(cols) {
+		rowAxis.init(cols);
+		colAxis.init(rows);
+		work[0].resize(2*(size_t)rows*cols);
+		work[1].resize(2*(size_t)rows*cols);
+		tmp.resize(2*std::max(rowAxis.maxRadix,colAxis.maxRadix));
+	}
+	virtual void execute(const T* const* in,T* const* out,const int& count,const bool& inverse){
+		T* A=&work[0][0];
+		T* B=&work[1][0];
+		for(int k=0;k<count;k++){
+			// DFT of the columns: the rows of the plane are the vectors
+			transformVectors(colAxis,in[k],out[k],A,cols,inverse);
+			// DFT of the rows: the columns of the transposed plane are the vectors
+			transposeComplex(out[k],A,rows,cols);
+			transformVectors(rowAxis,A,B,out[k],rows,inverse);
+			transposeComplex(B,out[k],cols,rows);
+		}
+	}
+	virtual Size getSize() const{
+		return Size(cols,rows);
+	}
+};
+
+#ifdef HAVE_FFTW
+/*! Protect the planner of FFTW, which is not thread safe */
+static Mutex fftwMutex;
+
+template<typename T> struct FFTWTraits;
+
+template<> struct FFTWTraits<double> {
+	typedef fftw_plan Plan;
+	typedef fftw_complex Complex;
+	static Plan plan(const int* n,const int& howmany,Complex* in,Complex* out,const int& sign){
+		const int dist=n[0]*n[1];
+		return fftw_plan_many_dft(2,n,howmany,in,0,1,dist,out,0,1,dist,sign,FFTW_MEASURE|FFTW_UNALIGNED);
+	}
+	static void execute(const Plan& p,const double* in,double* out){
+		fftw_execute_dft(p,(Complex*)in,(Complex*)out);
+	}
+	static Complex* alloc(const size_t& n){
+		return fftw_alloc_complex(n);
+	}
+	static void free(Complex* p){
+		fftw_free(p);
+	}
+};
+
+template<> struct FFTWTraits<float> {
+	typedef fftwf_plan Plan;
+	typedef fftwf_complex Complex;
+	static Plan plan(const int* n,const int& howmany,Complex* in,Complex* out,const int& sign){
+		const int dist=n[0]*n[1];
+		return fftwf_plan_many_dft(2,n,howmany,in,0,1,dist,out,0,1,dist,sign,FFTW_MEASURE|FFTW_UNALIGNED);
+	}
+	static void execute(const Plan& p,const float* in,float* out){
+		fftwf_execute_dft(p,(Complex*)in,(Complex*)out);
+	}
+	static Complex* alloc(const size_t& n){
+		return fftwf_alloc_complex(n);
+	}
+	static void free(Complex* p){
+		fftwf_free(p);
+	}
+};
+
+/*!
+ *  \brief The plans of FFTW, shared by the engines and kept until the end of the program
+ *
+ *  FFTW_MEASURE times several algorithms, which costs much more than the DFTs of an image,
+ *  so a plan is made once for each size, number of planes, placement and direction, and is
+ *  then used by all the engines of this size (executing a plan on new arrays is thread safe).
+ */
+template<typename T> struct FFTWPlanCache {
+	typedef FFTWTraits<T> Traits;
+	static std::map<vector<int>,typename Traits::Plan> plans;	/*!< The plans, keyed by rows, cols, howmany, inPlace and inverse */
+	/*!
+	 *  \brief Get a plan, made on the first call for its parameters
+	 */
+	static typename Traits::Plan get(const int& rows,const int& cols,const int& howmany,const bool& inPlace,const bool& inverse){
+		const int k[5]={rows,cols,howmany,inPlace,inverse};
+		const vector<int> key(k,k+5);
+		AutoLock lock(fftwMutex);
+		typename std::map<vector<int>,typename Traits::Plan>::const_iterator it=plans.find(key);
+		if(it!=plans.end())
+			return it->second;
+		// FFTW_MEASURE overwrites the arrays: plan on temporary ones
+		const int n[2]={rows,cols};
+		const size_t size=(size_t)rows*cols*howmany;
+		typename Traits::Complex* a=Traits::alloc(size);
+		typename Traits::Complex* b=inPlace ? a : Traits::alloc(size);
+		typename Traits::Plan p=Traits::plan(n,howmany,a,b,inverse ? FFTW_BACKWARD : FFTW_FORWARD);
+		if(!inPlace)
+			Traits::free(b);
+		Traits::free(a);
+		plans[key]=p;
+		return p;
+	}
+};
+
+template<typename T> std::map<vector<int>,typename FFTWTraits<T>::Plan> FFTWPlanCache<T>::plans;
+
+/*! \class FFTWEngine
+   * \brief Backend which uses FFTW
+   *
+   *  plans[inverse][0] transforms one plane out of place, plans[inverse][1] one plane in place
+   *  and plans[inverse][2] a stack of batch planes out of place. The plans belong to
+   *  FFTWPlanCache, so building an engine of a size already planned costs nothing.
+   */
+template<typename T> class FFTWEngine : public FFTEngine_<T> {
+private:
+	typedef FFTWTraits<T> Traits;
+	int rows;							/*!< Number of rows of the planes */
+	int cols;							/*!< Number of columns of the planes */
+	int batch;							/*!< Number of planes of plans[.][2] */
+	typename Traits::Plan plans[2][3];	/*!< The plans (owned by FFTWPlanCache) */
+
+	FFTWEngine(const FFTWEngine&);
+	FFTWEngine& operator=(const FFTWEngine&);
+public:
+	FFTWEngine(const int& rows,const int& cols,const int& batch) : rows(rows), cols(cols), batch(batch) {
+		for(int inv=0;inv<2;inv++){
+			plans[inv][0]=FFTWPlanCache<T>::get(rows,cols,1,false,inv!=0);
+			plans[inv][1]=FFTWPlanCache<T>::get(rows,cols,1,true,inv!=0);
+			plans[inv][2]=batch>1 ? FFTWPlanCache<T>::get(rows,cols,batch,false,inv!=0) : 0;
+		}
+	}
+	virtual void execute(const T* const* in,T* const* out,const int& count,const bool& inverse){
+		for(int k=0;k<count;k++)
+			Traits::execute(plans[inverse][in[k]==out[k] ? 1 : 0],in[k],out[k]);
+	}
+	virtual void executeStack(const T* in,T* out,const int& count,const bool& inverse){
+		if(count==batch && batch>1 && in!=out)
+			Traits::execute(plans[inverse][2],in,out);
+		else
+			FFTEngine_<T>::executeStack(in,out,count,inverse);
+	}
+	virtual Size getSize() const{
+		return Size(cols,rows);
+	}
+};
+#endif
+
+#ifdef HAVE_FFTW
+static Mutex backendChoicesMutex;							/*!< Protect backendChoices */
+static std::map<vector<int>,FFTBackend> backendChoices;		/*!< The backends chosen by BatchFFT_::chooseBackend, keyed by depth, rows and cols */
+
+/*!
+ *  \brief Time the DFT of a plane by an engine: the best of three runs of at least 64k points
+ */
+template<typename T> static double timeEngine(FFTEngine_<T>& engine){
+	const Size size=engine.getSize();
+	vector<T> in(2*(size_t)size.area(),(T)1),out(in.size());
+	const T* ins[1]={&in[0]};
+	T* outs[1]={&out[0]};
+	const int repeats=std::max(1,(1<<16)/size.area());
+	int64 best=0;
+	for(int r=0;r<3;r++){
+		int64 start=getTickCount();
+		for(int i=0;i<repeats;i++)
+			engine.execute(ins,outs,1,false);
+		int64 t=getTickCount()-start;
+		if(r==0 || t<best)
+			best=t;
+	}
+	return (double)best;
+}
+#endif
+
+template<typename T> BatchFFT_<T>::BatchFFT_() : rows(0), cols(0), batch(0), backend(FFT_BACKEND_AUTO) {
+}
+
+template<typename T> BatchFFT_<T>::BatchFFT_(const int& rows,const int& cols,const int& batch,const FFTBackend& backend)
+	: rows(rows), cols(cols), batch(batch), backend(backend) {
+	CV_Assert(rows>0 && cols>0 && batch>0);
+	if(this->backend==FFT_BACKEND_AUTO)
+		this->backend=chooseBackend(rows,cols);
+	if(!isAvailable(this->backend))
+		CV_Error(CV_StsBadArg,"BatchFFT: the backend "+getBackendName(this->backend)+" is not available");
+	switch(this->backend){
+	case FFT_BACKEND_BUILTIN:
+		engine=new BuiltinEngine<T>(rows,cols);
+		break;
+#ifdef HAVE_FFTW
+	case FFT_BACKEND_FFTW:
+		engine=new FFTWEngine<T>(rows,cols,batch);
+		break;
+#endif
+	default:
+		engine=new OpenCVEngine<T>(rows,cols);
+	}
+}
+
+template<typename T> BatchFFT_<T>::BatchFFT_(const Ptr<FFTEngine_<T> >& engine) : batch(1), backend(FFT_BACKEND_AUTO), engine(engine) {
+	CV_Assert(!engine.empty());
+	rows=engine->getSize().height;
+	cols=engine->getSize().width;
+}
+
+template<typename T> void BatchFFT_<T>::scale(T* const* out,const int& count) const{
+	const T s=(T)1/((T)rows*cols);
+	const size_t n=2*(size_t)rows*cols;
+	for(int k=0;k<count;k++)
+		for(size_t i=0;i<n;i++)
+			out[k][i]*=s;
+}
+
+template<typename T> void BatchFFT_<T>::execute(const Mat& in,Mat& out,const int& flags){
+	const int type=CV_MAKETYPE(DataType<T>::depth,2);
+	CV_Assert(!engine.empty() && in.type()==type && in.cols==cols && in.rows%rows==0 && in.isContinuous());
+	const int count=in.rows/rows;
+	GCFD_PROFILE_CREATE(out,in.rows,cols,type);
+	CV_Assert(out.isContinuous());
+	engine->executeStack(in.ptr<T>(),out.ptr<T>(),count,(flags & DFT_INVERSE)!=0);
+	if(flags & DFT_SCALE){
+		T* p=out.ptr<T>();
+		for(int k=0;k<count;k++){
+			T* plane=p+2*(size_t)k*rows*cols;
+			scale(&plane,1);
+		}
+	}
+}
+
+template<typename T> void BatchFFT_<T>::execute(const Mat* in,Mat* out,const int& count,const int& flags){
+	const int type=CV_MAKETYPE(DataType<T>::depth,2);
+	CV_Assert(!engine.empty());
+	AutoBuffer<const T*> inBuffer(count);
+	AutoBuffer<T*> outBuffer(count);
+	const T** ins=inBuffer;
+	T** outs=outBuffer;
+	for(int k=0;k<count;k++){
+		CV_Assert(in[k].type()==type && in[k].size()==getSize() && in[k].isContinuous());
+		GCFD_PROFILE_CREATE(out[k],rows,cols,type);
+		CV_Assert(out[k].isContinuous());
+		ins[k]=in[k].ptr<T>();
+		outs[k]=out[k].ptr<T>();
+	}
+	engine->execute(ins,outs,count,(flags & DFT_INVERSE)!=0);
+	if(flags & DFT_SCALE)
+		scale(outs,count);
+}
+
+template<typename T> Size BatchFFT_<T>::getSize() const{
+	return Size(cols,rows);
+}
+
+template<typename T> FFTBackend BatchFFT_<T>::getBackend() const{
+	return backend;
+}
+
+template<typename T> FFTBackend BatchFFT_<T>::chooseBackend(const int& rows,const int& cols){
+	const bool smooth=largestPrimeFactor(rows)<=7 && largestPrimeFactor(cols)<=7;
+#ifdef HAVE_FFTW
+	if(!smooth)
+		return FFT_BACKEND_FFTW;
+	// Both are fast on these sizes: keep the faster one on this machine, measured once per size
+	const int k[3]={DataType<T>::depth,rows,cols};
+	const vector<int> key(k,k+3);
+	AutoLock lock(backendChoicesMutex);
+	std::map<vector<int>,FFTBackend>::const_iterator it=backendChoices.find(key);
+	if(it!=backendChoices.end())
+		return it->second;
+	BuiltinEngine<T> builtin(rows,cols);
+	FFTWEngine<T> fftw(rows,cols,1);
+	FFTBackend choice=timeEngine(builtin)<=timeEngine(fftw) ? FFT_BACKEND_BUILTIN : FFT_BACKEND_FFTW;
+	backendChoices[key]=choice;
+	return choice;
+#else
+	return smooth ? FFT_BACKEND_BUILTIN : FFT_BACKEND_OPENCV;
+#endif
+}
+
+template<typename T> bool BatchFFT_<T>::isAvailable(const FFTBackend& backend){
+#ifdef HAVE_FFTW
+	(void)backend;
+	return true;
+#else
+	return backend!=FFT_BACKEND_FFTW;
+#endif
+}
+
+template<typename T> string BatchFFT_<T>::getBackendName(const FFTBackend& backend){
+	switch(backend){
+	case FFT_BACKEND_OPENCV:
+		return "opencv";
+	case FFT_BACKEND_BUILTIN:
+		return "builtin";
+	case FFT_BACKEND_FFTW:
+		return "fftw";
+	default:
+		return "auto";
+	}
+}
+
+template<typename T> BatchFFT_<T>::~BatchFFT_() {
+}
+
+template class FFTEngine_<float>;
+template class FFTEngine_<double>;
+template class BatchFFT_<float>;
+template class BatchFFT_<double>;
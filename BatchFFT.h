@@ -0,0 +1,201 @@
+/**
+ * \file BatchFFT.h
+ * \brief 2D DFT of many planes of the same size with a choice of backends
+ * \version 1.0
+ * \date October 17, 2026
+ *
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the distribution
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef BATCHFFT_H_
+#define BATCHFFT_H_
+
+#include <iostream>
+#include <opencv/cv.h>
+#include <opencv/highgui.h>
+#include <vector>
+
+using namespace cv;
+
+/*!
+ *  \brief The implementations of the DFT which can be used by BatchFFT_
+ */
+enum FFTBackend {
+	FFT_BACKEND_AUTO,		/*!< Chosen by BatchFFT_::chooseBackend */
+	FFT_BACKEND_OPENCV,		/*!< cv::dft, one call per plane */
+	FFT_BACKEND_BUILTIN,	/*!< The mixed-radix FFT of BatchFFT.cpp */
+	FFT_BACKEND_FFTW		/*!< FFTW, if the library has been built with HAVE_FFTW */
+};
+
+/*! \class FFTEngine_
+   * \brief Interface of the backends of BatchFFT_
+   *
+   *  An engine is built for one size of plane and may keep work buffers, so it is used by
+   *  one thread at a time. The DFTs are not scaled, as the ones of cv::dft.
+   */
+template<typename T> class FFTEngine_ {
+public:
+	/*!
+	 *  \brief Compute the DFT of several planes
+	 *
+	 *  \param in : The planes, continuous complex arrays of rows x cols elements
+	 *  \param out : The outputs (out[k] may be in[k])
+	 *  \param count : The number of planes
+	 *  \param inverse : Compute the inverse DFT
+	 */
+	virtual void execute(const T* const* in,T* const* out,const int& count,const bool& inverse)=0;
+	/*!
+	 *  \brief Compute the DFT of planes stored one after the other
+	 *
+	 *  By default, calls execute with the address of each plane.
+	 *
+	 *  \param in : The first plane, followed by the others
+	 *  \param out : The first output plane (may be in)
+	 *  \param count : The number of planes
+	 *  \param inverse : Compute the inverse DFT
+	 */
+	virtual void executeStack(const T* in,T* out,const int& count,const bool& inverse);
+	/*!
+	 *  \brief Get the size of the planes
+	 *
+	 *  \return Return the size of the planes handled by the engine
+	 */
+	virtual Size getSize() const=0;
+
+	virtual ~FFTEngine_();
+};
+
+/*! \class BatchFFT_
+   * \brief Compute the 2D DFT of many complex planes of the same size
+   *
+   *  The backend is chosen and its tables (twiddle factors, factorization of the sizes, FFTW
+   *  plans) are built once in the constructor, so transforming a batch only costs the DFTs.
+   *  The FFTW plans are made once per size for the whole program and shared by the objects,
+   *  so building a BatchFFT_ of a size already planned does not run the planner again.
+   *  The planes are given either as one Mat in which they are stacked vertically, or as an
+   *  array of Mat (e.g. the parallel and orthogonal parts of a CFT).
+   *
+   *  The built-in backend is a Stockham mixed-radix FFT (radices 2, 3, 4, 5 and a generic one
+   *  for the other prime factors) with precomputed twiddles. Each pass transforms a whole row
+   *  (or a whole column, after a blocked transposition) of the plane at once, so its inner
+   *  loops are contiguous and can be vectorized. It is the fastest for the small images of the
+   *  descriptors, whose sizes are odd (e.g. 63=7x9), when they have no large prime factor.
+   *
+   *  A BatchFFT_ is not thread safe: use one per thread. T is float or double.
+   */
+template<typename T> class BatchFFT_ {
+private:
+	int rows;						/*!< Number of rows of the planes */
+	int cols;						/*!< Number of columns of the planes */
+	int batch;						/*!< Number of planes of the stacks given to execute */
+	FFTBackend backend;				/*!< The backend of engine */
+	Ptr<FFTEngine_<T> > engine;		/*!< The implementation of the DFT */
+
+	/*!
+	 *  \brief Multiply the planes by 1/(rows.cols)
+	 */
+	void scale(T* const* out,const int& count) const;
+
+public:
+	BatchFFT_();
+	/*!
+	 *  \brief Constructor of BatchFFT_ class
+	 *
+	 *  \param rows : The number of rows of the planes
+	 *  \param cols : The number of columns of the planes
+	 *  \param batch : The usual number of planes of a call (FFTW plans the stacks of this size)
+	 *  \param backend : The implementation to use
+	 *
+	 */
+	BatchFFT_(const int& rows,const int& cols,const int& batch=1,const FFTBackend& backend=FFT_BACKEND_AUTO);
+	/*!
+	 *  \brief Constructor of BatchFFT_ class with a user defined engine
+	 *
+	 *  \param engine : An engine (the size of the planes is given by its getSize())
+	 *
+	 */
+	BatchFFT_(const Ptr<FFTEngine_<T> >& engine);
+	/*!
+	 *  \brief Compute the DFT of stacked planes
+	 *
+	 *  \param in : A continuous complex Mat of T of (n x rows) x cols elements: n planes one below the other
+	 *  \param out : The DFT of each plane, stacked in the same way (may be in)
+	 *  \param flags : 0, or a combination of DFT_INVERSE and DFT_SCALE (as for cv::dft)
+	 */
+	void execute(const Mat& in,Mat& out,const int& flags=0);
+	/*!
+	 *  \brief Compute the DFT of separate planes
+	 *
+	 *  \param in : An array of count continuous complex Mat of T of rows x cols elements
+	 *  \param out : An array of count Mat which receives the DFT of each plane (out[k] may be in[k])
+	 *  \param count : The number of planes
+	 *  \param flags : 0, or a combination of DFT_INVERSE and DFT_SCALE (as for cv::dft)
+	 */
+	void execute(const Mat* in,Mat* out,const int& count,const int& flags=0);
+	/*!
+	 *  \brief Get the size of the planes
+	 *
+	 *  \return Return the size of the planes handled by the object
+	 */
+	Size getSize() const;
+	/*!
+	 *  \brief Get the backend
+	 *
+	 *  \return Return the backend chosen in the constructor
+	 */
+	FFTBackend getBackend() const;
+	/*!
+	 *  \brief Choose the fastest backend for a size of plane
+	 *
+	 *  If no prime factor of the sizes is larger than 7, the built-in FFT, or FFTW if it is
+	 *  available and faster on this size (both are timed on the first call for a size and
+	 *  the choice is kept). Otherwise FFTW if it is available, or cv::dft.
+	 *
+	 *  \param rows : The number of rows of the planes
+	 *  \param cols : The number of columns of the planes
+	 *  \return Return a backend other than FFT_BACKEND_AUTO
+	 */
+	static FFTBackend chooseBackend(const int& rows,const int& cols);
+	/*!
+	 *  \brief Check if a backend can be used
+	 *
+	 *  \param backend : A backend
+	 *  \return Return false for FFT_BACKEND_FFTW if the library has been built without FFTW
+	 */
+	static bool isAvailable(const FFTBackend& backend);
+	/*!
+	 *  \brief Get the name of a backend
+	 *
+	 *  \param backend : A backend
+	 *  \return Return "auto", "opencv", "builtin" or "fftw"
+	 */
+	static string getBackendName(const FFTBackend& backend);
+
+	virtual ~BatchFFT_();
+};
+
+typedef BatchFFT_<double> BatchFFT;
+typedef BatchFFT_<float> BatchFFTf;
+
+#endif /* BATCHFFT_H_ */
@@ -0,0 +1,137 @@
+/**
+ * \file BoundedQueue.h
+ * \brief Blocking queue of bounded capacity shared by several threads
+ * \version 1.0
+ * \date October 17, 2026
+ *
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the distribution
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef BOUNDEDQUEUE_H_
+#define BOUNDEDQUEUE_H_
+
+#include <deque>
+#include <pthread.h>
+
+/*! \class BoundedQueue
+   * \brief FIFO queue between the threads of two stages of a pipeline
+   *
+   *  push() blocks while the queue is full, so a fast producer waits for the consumers
+   *  instead of filling the memory, and pop() blocks while the queue is empty. Once the
+   *  queue is closed, push() fails and pop() returns the remaining elements then fails.
+   *  OpenCV has no condition variable, so the queue uses the pthread ones.
+   */
+template<typename T> class BoundedQueue {
+private:
+	std::deque<T> items;			/*!< The elements of the queue */
+	size_t capacity;				/*!< The maximum number of elements */
+	bool closed;					/*!< True once close() has been called */
+	pthread_mutex_t mutex;			/*!< Protect the queue */
+	pthread_cond_t notFull;			/*!< Signaled when an element is removed or the queue is closed */
+	pthread_cond_t notEmpty;		/*!< Signaled when an element is added or the queue is closed */
+
+	BoundedQueue(const BoundedQueue&);
+	BoundedQueue& operator=(const BoundedQueue&);
+
+public:
+	/*!
+	 *  \brief Constructor of BoundedQueue class
+	 *
+	 *  \param capacity : The maximum number of elements in the queue (at least 1)
+	 *
+	 */
+	BoundedQueue(const size_t& capacity) : capacity(capacity>0 ? capacity : 1), closed(false) {
+		pthread_mutex_init(&mutex,0);
+		pthread_cond_init(&notFull,0);
+		pthread_cond_init(&notEmpty,0);
+	}
+	/*!
+	 *  \brief Add an element at the end of the queue, wait while the queue is full
+	 *
+	 *  \param item : The element to add
+	 *  \return Return false if the queue has been closed (the element is not added)
+	 */
+	bool push(const T& item){
+		pthread_mutex_lock(&mutex);
+		while(items.size()>=capacity && !closed)
+			pthread_cond_wait(&notFull,&mutex);
+		bool ok=!closed;
+		if(ok){
+			items.push_back(item);
+			pthread_cond_signal(&notEmpty);
+		}
+		pthread_mutex_unlock(&mutex);
+		return ok;
+	}
+	/*!
+	 *  \brief Remove the first element of the queue, wait while the queue is empty
+	 *
+	 *  \param item : The output, the removed element
+	 *  \return Return false if the queue is closed and empty
+	 */
+	bool pop(T& item){
+		pthread_mutex_lock(&mutex);
+		while(items.empty() && !closed)
+			pthread_cond_wait(&notEmpty,&mutex);
+		bool ok=!items.empty();
+		if(ok){
+			item=items.front();
+			items.pop_front();
+			pthread_cond_signal(&notFull);
+		}
+		pthread_mutex_unlock(&mutex);
+		return ok;
+	}
+	/*!
+	 *  \brief Close the queue and wake up all the waiting threads
+	 *
+	 *  The elements already in the queue can still be removed by pop().
+	 */
+	void close(){
+		pthread_mutex_lock(&mutex);
+		closed=true;
+		pthread_cond_broadcast(&notFull);
+		pthread_cond_broadcast(&notEmpty);
+		pthread_mutex_unlock(&mutex);
+	}
+	/*!
+	 *  \brief Get the number of elements in the queue
+	 *
+	 *  \return Return the number of elements
+	 */
+	size_t size(){
+		pthread_mutex_lock(&mutex);
+		size_t n=items.size();
+		pthread_mutex_unlock(&mutex);
+		return n;
+	}
+
+	virtual ~BoundedQueue(){
+		pthread_cond_destroy(&notEmpty);
+		pthread_cond_destroy(&notFull);
+		pthread_mutex_destroy(&mutex);
+	}
+};
+
+#endif /* BOUNDEDQUEUE_H_ */
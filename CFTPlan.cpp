@@ -0,0 +1,200 @@
+/**
+ * \file CFTPlan.cpp
+ * \brief Reusable plan to compute the color Clifford Fourier Transform of many images
+ * \version 1.0
+ * \date October 17, 2026
+ *
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the distribution
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "CFTPlan.h"
+#include "Profiler.h"
+
+/*!
+ *  \brief Cross product of two 3D vectors
+ */
+static void cross3(const double* a,const double* b,double* res){
+	res[0]=a[1]*b[2]-a[2]*b[1];
+	res[1]=a[2]*b[0]-a[0]*b[2];
+	res[2]=a[0]*b[1]-a[1]*b[0];
+}
+
+/*!
+ *  \brief Normalize a 3D vector
+ */
+static void normalize3(double* a){
+	double n=std::sqrt(a[0]*a[0]+a[1]*a[1]+a[2]*a[2]);
+	for(int k=0;k<3;k++)
+		a[k]/=n;
+}
+
+template<typename T> CFTPlan_<T>::CFTPlan_() : rows(0), cols(0), preprocessor((Mat_<double>(1,3) << 1,0,0)) {
+	Vec=(Mat_<double>(1,3) << 1,0,0);
+}
+
+template<typename T> CFTPlan_<T>::CFTPlan_(const int& rows,const int& cols,const Mat& Vec,const FFTBackend& backend,const ColorPreprocessing& preprocessing)
+	: rows(rows), cols(cols), preprocessor(Vec,preprocessing), fft(rows,cols,2,backend) {
+	CV_Assert(rows>0 && cols>0 && Vec.total()==3);
+	Vec.convertTo(this->Vec,CV_64F);
+	this->Vec=this->Vec.reshape(1,1);
+	const int depth=DataType<T>::depth;
+	GCFD_PROFILE_CREATE(parIn,rows,cols,CV_MAKETYPE(depth,2));
+	GCFD_PROFILE_CREATE(orthIn,rows,cols,CV_MAKETYPE(depth,2));
+	GCFD_PROFILE_CREATE(parInReal,rows,cols,depth);
+	GCFD_PROFILE_CREATE(planes,4,cols,depth);
+}
+
+template<typename T> void CFTPlan_<T>::getBasis(const Mat& Vec,double* Cn,double* Vn,double* Wn){
+	// Same construction as CFT::computeCFT
+	CV_Assert(Vec.total()==3);
+	Mat v;
+	Vec.convertTo(v,CV_64F);
+	v=v.reshape(1,1);
+	double Mu[3],tmp[3];
+	for(int k=0;k<3;k++)
+		Cn[k]=v.at<double>(0,k);
+	if(Cn[0]+Cn[1]+Cn[2]==0){
+		Cn[0]=1;
+		Cn[1]=0;
+		Cn[2]=0;
+	}
+	normalize3(Cn);
+
+	for(int k=0;k<3;k++)
+		Mu[k]=1/std::sqrt(3.);
+	if(Mu[0]-Cn[0]<1e-6 && Mu[1]-Cn[1]<1e-6 && Mu[2]-Cn[2]<1e-6){
+		Mu[0]=1;
+		Mu[1]=0;
+		Mu[2]=0;
+	}
+	cross3(Mu,Cn,tmp);
+	cross3(Cn,tmp,Vn);
+	normalize3(Vn);
+	cross3(Vn,Cn,Wn);
+	normalize3(Wn);
+}
+
+template<typename T> void CFTPlan_<T>::project(const Mat& in,Mat& par,Mat* orth){
+	GCFD_PROFILE_SCOPE("CFT/projection");
+	CV_Assert(in.rows==rows && in.cols==cols);
+	preprocessor.project(in,par,orth,planes);
+}
+
+template<typename T> void CFTPlan_<T>::project(const vector<Mat>& in,Mat& par,Mat* orth){
+	GCFD_PROFILE_SCOPE("CFT/projection");
+	CV_Assert(!in.empty() && in[0].rows==rows && in[0].cols==cols);
+	preprocessor.project(in,par,orth,planes);
+}
+
+template<typename T> void CFTPlan_<T>::transform(Mat& par,Mat& orth){
+	GCFD_PROFILE_CREATE(par,rows,cols,parIn.type());
+	GCFD_PROFILE_CREATE(orth,rows,cols,orthIn.type());
+	GCFD_PROFILE_SCOPE("FFT2/computeFFT2");
+	const Mat parts[2]={parIn,orthIn};
+	Mat spectra[2]={par,orth};
+	fft.execute(parts,spectra,2);
+}
+
+template<typename T> void CFTPlan_<T>::transformPacked(Mat& par,Mat* orth){
+	GCFD_PROFILE_CREATE(par,rows,cols,parInReal.type());
+	if(orth)
+		GCFD_PROFILE_CREATE(*orth,rows,cols,orthIn.type());
+	GCFD_PROFILE_SCOPE("FFT2/computeFFT2");
+	dft(parInReal,par,0,0);
+	if(orth)
+		fft.execute(&orthIn,orth,1);
+}
+
+template<typename T> void CFTPlan_<T>::execute(const Mat& in,Mat& par,Mat& orth){
+	project(in,parIn,&orthIn);
+	transform(par,orth);
+}
+
+template<typename T> void CFTPlan_<T>::execute(const vector<Mat>& in,Mat& par,Mat& orth){
+	project(in,parIn,&orthIn);
+	transform(par,orth);
+}
+
+template<typename T> void CFTPlan_<T>::executePacked(const Mat& in,Mat& par,Mat& orth){
+	CV_Assert(!ColorPreprocessor_<T>::hasAlpha(in.channels()));
+	project(in,parInReal,&orthIn);
+	transformPacked(par,&orth);
+}
+
+template<typename T> void CFTPlan_<T>::executePacked(const vector<Mat>& in,Mat& par,Mat& orth){
+	CV_Assert(!ColorPreprocessor_<T>::hasAlpha((int)in.size()));
+	project(in,parInReal,&orthIn);
+	transformPacked(par,&orth);
+}
+
+template<typename T> void CFTPlan_<T>::executePacked(const Mat& in,Mat& par){
+	CV_Assert(!ColorPreprocessor_<T>::hasAlpha(in.channels()));
+	project(in,parInReal,0);
+	transformPacked(par,0);
+}
+
+template<typename T> void CFTPlan_<T>::executePacked(const vector<Mat>& in,Mat& par){
+	CV_Assert(!ColorPreprocessor_<T>::hasAlpha((int)in.size()));
+	project(in,parInReal,0);
+	transformPacked(par,0);
+}
+
+template<typename T> bool CFTPlan_<T>::matches(const Size& size,const Mat& Vec,const ColorPreprocessing& preprocessing) const{
+	if(size!=getSize() || Vec.total()!=3 || preprocessing!=getPreprocessing())
+		return false;
+	Mat v;
+	Vec.convertTo(v,CV_64F);
+	v=v.reshape(1,1);
+	for(int k=0;k<3;k++)
+		if(v.at<double>(0,k)!=this->Vec.at<double>(0,k))
+			return false;
+	return true;
+}
+
+template<typename T> Size CFTPlan_<T>::getSize() const{
+	return Size(cols,rows);
+}
+
+template<typename T> Mat CFTPlan_<T>::getVec() const{
+	return Vec.clone();
+}
+
+template<typename T> const ColorPreprocessing& CFTPlan_<T>::getPreprocessing() const{
+	return preprocessor.getConfig();
+}
+
+template<typename T> Mat CFTPlan_<T>::cropToOddSize(const Mat& im){
+	Mat res=im;
+	if(res.cols%2==0)
+		res=res.colRange(0,res.cols-1);
+	if(res.rows%2==0)
+		res=res.rowRange(0,res.rows-1);
+	return res;
+}
+
+template<typename T> CFTPlan_<T>::~CFTPlan_() {
+}
+
+template class CFTPlan_<float>;
+template class CFTPlan_<double>;
@@ -0,0 +1,218 @@
+/**
+ * \file CFTPlan.h
+ * \brief Reusable plan to compute the color Clifford Fourier Transform of many images
+ * \version 1.0
+ * \date October 17, 2026
+ *
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the distribution
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef CFTPLAN_H_
+#define CFTPLAN_H_
+
+#include <iostream>
+#include <opencv/cv.h>
+#include <opencv/highgui.h>
+#include <vector>
+#include "BatchFFT.h"
+#include "ColorPreprocessor.h"
+
+using namespace cv;
+
+/*! \class CFTPlan_
+   * \brief Plan used to compute the color Clifford Fourier Transform of many images of the same size
+   *
+   *  The projection basis derived from the bivector (see CFT::computeCFT) is computed once in the
+   *  constructor and the complex work buffers are kept between two calls, so computing the CFT of
+   *  another image of the same size does not allocate anything once the outputs have been created.
+   *  The complex DFTs are computed by a BatchFFT_, which transforms the parallel and the
+   *  orthogonal parts in one call. A plan is not thread safe: use one plan per thread.
+   *
+   *  T is the precision of the spectra (float or double). The double plan (CFTPlan) gives the
+   *  same spectra as CFT, the float plan (CFTPlanf) is about twice as fast and is accurate enough
+   *  to rank images with the descriptors.
+   */
+template<typename T> class CFTPlan_ {
+private:
+	int rows;				/*!< Number of rows of the images */
+	int cols;				/*!< Number of columns of the images */
+	Mat Vec;				/*!< A color vector used to build the bivector B=Vec^e4 */
+	Mat parIn;				/*!< Work buffer: the parallel part of the image before the DFT */
+	Mat orthIn;				/*!< Work buffer: the orthogonal part of the image before the DFT */
+	Mat parInReal;			/*!< Work buffer: the (real) parallel part of a RGB image before the DFT */
+	Mat planes;				/*!< Work buffer: the color planes of a row of the image (RGB or RGBA order) */
+	ColorPreprocessor_<T> preprocessor;	/*!< The conversion of the images to the parts of the CFT */
+	BatchFFT_<T> fft;		/*!< The complex DFTs of the parts */
+	/*!
+	 *  \brief Project an image on the basis
+	 *
+	 *  \param in : A color image of the size of the plan
+	 *  \param par : The parallel part (complex or real)
+	 *  \param orth : The orthogonal part (or null)
+	 */
+	void project(const Mat& in,Mat& par,Mat* orth);
+	/*!
+	 *  \brief Project a planar image on the basis
+	 *
+	 *  \param in : The planes of a color image of the size of the plan
+	 *  \param par : The parallel part (complex or real)
+	 *  \param orth : The orthogonal part (or null)
+	 */
+	void project(const vector<Mat>& in,Mat& par,Mat* orth);
+	/*!
+	 *  \brief Compute the DFTs of the projected parts
+	 *
+	 *  \param par : The parallel part of the CFT
+	 *  \param orth : The orthogonal part of the CFT
+	 */
+	void transform(Mat& par,Mat& orth);
+	/*!
+	 *  \brief Compute the DFTs of the projected parts of a RGB image, the parallel part being real
+	 *
+	 *  \param par : The packed parallel part of the CFT
+	 *  \param orth : The orthogonal part of the CFT (or null if it is not needed)
+	 */
+	void transformPacked(Mat& par,Mat* orth);
+
+public:
+	CFTPlan_();
+	/*!
+	 *  \brief Constructor of CFTPlan_ class
+	 *
+	 *  \param rows : The number of rows of the images
+	 *  \param cols : The number of columns of the images
+	 *  \param Vec : A color vector used to build the bivector B=Vec^e4
+	 *  \param backend : The implementation of the complex DFTs (see BatchFFT_)
+	 *  \param preprocessing : The order of the channels and the scaling of the images
+	 *
+	 */
+	CFTPlan_(const int& rows,const int& cols,const Mat& Vec,const FFTBackend& backend=FFT_BACKEND_AUTO,const ColorPreprocessing& preprocessing=ColorPreprocessing());
+	/*!
+	 *  \brief Compute the CFT of an image
+	 *
+	 *  Gives the same parallel and orthogonal parts as CFT::computeCFT(in,Vec).
+	 *
+	 *  \param in : A color image (1, 3 or 4 channels, uchar, float or double) of the size of the plan
+	 *  \param par : The parallel part of the CFT (a complex Mat of T)
+	 *  \param orth : The orthogonal part of the CFT (a complex Mat of T)
+	 */
+	void execute(const Mat& in,Mat& par,Mat& orth);
+	/*!
+	 *  \brief Compute the CFT of a planar image
+	 *
+	 *  \param in : 1, 3 or 4 planes of one channel (uchar, float or double) of the size of the plan
+	 *  \param par : The parallel part of the CFT (a complex Mat of T)
+	 *  \param orth : The orthogonal part of the CFT (a complex Mat of T)
+	 */
+	void execute(const vector<Mat>& in,Mat& par,Mat& orth);
+	/*!
+	 *  \brief Compute the CFT of a RGB image with a packed parallel part
+	 *
+	 *  The parallel part of a RGB image is the spectrum of a real image, so it is computed with
+	 *  a real DFT and given in the packed format of RealFFT2, which is about twice as fast.
+	 *  The orthogonal part is the same as the one given by execute().
+	 *
+	 *  \param in : A color image (1 or 3 channels, uchar, float or double) of the size of the plan
+	 *  \param par : The packed parallel part of the CFT (a Mat of T)
+	 *  \param orth : The orthogonal part of the CFT (a complex Mat of T)
+	 */
+	void executePacked(const Mat& in,Mat& par,Mat& orth);
+	/*!
+	 *  \brief Compute the CFT of a planar RGB image with a packed parallel part
+	 *
+	 *  \param in : 1 or 3 planes of one channel (uchar, float or double) of the size of the plan
+	 *  \param par : The packed parallel part of the CFT (a Mat of T)
+	 *  \param orth : The orthogonal part of the CFT (a complex Mat of T)
+	 */
+	void executePacked(const vector<Mat>& in,Mat& par,Mat& orth);
+	/*!
+	 *  \brief Compute only the packed parallel part of the CFT of a RGB image
+	 *
+	 *  \param in : A color image (1 or 3 channels, uchar, float or double) of the size of the plan
+	 *  \param par : The packed parallel part of the CFT (a Mat of T)
+	 */
+	void executePacked(const Mat& in,Mat& par);
+	/*!
+	 *  \brief Compute only the packed parallel part of the CFT of a planar RGB image
+	 *
+	 *  \param in : 1 or 3 planes of one channel (uchar, float or double) of the size of the plan
+	 *  \param par : The packed parallel part of the CFT (a Mat of T)
+	 */
+	void executePacked(const vector<Mat>& in,Mat& par);
+	/*!
+	 *  \brief Check if the plan can be used for an image and a color vector
+	 *
+	 *  \param size : The size of the image
+	 *  \param Vec : A color vector used to build the bivector B=Vec^e4
+	 *  \param preprocessing : The order of the channels and the scaling of the image
+	 *  \return Return true if the plan has been built for this size, this vector and this preprocessing
+	 */
+	bool matches(const Size& size,const Mat& Vec,const ColorPreprocessing& preprocessing=ColorPreprocessing()) const;
+	/*!
+	 *  \brief Get the size of the images
+	 *
+	 *  \return Return the size of the images handled by the plan
+	 */
+	Size getSize() const;
+	/*!
+	 *  \brief Get the color vector
+	 *
+	 *  \return Return the color vector used to build the bivector
+	 */
+	Mat getVec() const;
+	/*!
+	 *  \brief Get the preprocessing of the images
+	 *
+	 *  \return Return the order of the channels and the scaling of the images
+	 */
+	const ColorPreprocessing& getPreprocessing() const;
+	/*!
+	 *  \brief Compute the projection basis of a color vector
+	 *
+	 *  The parallel part of the CFT of an image x (RGB) is Cn.x+i e4.x and its orthogonal part
+	 *  is Vn.x+i Wn.x, see CFT::computeCFT.
+	 *
+	 *  \param Vec : A color vector used to build the bivector B=Vec^e4
+	 *  \param Cn : The output, the normalized color vector (3 elements)
+	 *  \param Vn : The output, the first vector of the orthogonal plane (3 elements)
+	 *  \param Wn : The output, the second vector of the orthogonal plane (3 elements)
+	 */
+	static void getBasis(const Mat& Vec,double* Cn,double* Vn,double* Wn);
+	/*!
+	 *  \brief Remove the last row and the last column of an image if its sizes are even
+	 *
+	 *  Same cropping as the one done by the descriptors before computing the CFT.
+	 *
+	 *  \param im : An image
+	 *  \return Return a header on the cropped image (the data is not copied)
+	 */
+	static Mat cropToOddSize(const Mat& im);
+
+	virtual ~CFTPlan_();
+};
+
+typedef CFTPlan_<double> CFTPlan;
+typedef CFTPlan_<float> CFTPlanf;
+
+#endif /* CFTPLAN_H_ */
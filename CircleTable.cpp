@@ -0,0 +1,260 @@
+/**
+ * \file CircleTable.cpp
+ * \brief Single-pass integration of a spectrum on discrete circles
+ * \version 1.0
+ * \date October 17, 2026
+ *
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the distribution
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "CircleTable.h"
+#include "SimdTools.h"
+#include "Profiler.h"
+#include <map>
+
+CircleTable::CircleTable() : rows(0), cols(0), nbCircles(0), rowStart(1,0) {
+}
+
+CircleTable::CircleTable(const vector<Mat>& Dcircles) : rows(0), cols(0), nbCircles(0) {
+	compile(Dcircles);
+}
+
+CircleTable::CircleTable(const int& maxR) : rows(0), cols(0), nbCircles(0) {
+	compile(MyTools::computeDiscreteCircles(maxR));
+}
+
+void CircleTable::compile(const vector<Mat>& Dcircles){
+	nbCircles=(int)Dcircles.size();
+	rowStart.assign(1,0);
+	entryCol.clear();
+	entryCircle.clear();
+	entryWeight.clear();
+	halfU.clear();
+	halfV.clear();
+	halfCircle.clear();
+	halfWeight.clear();
+	if(nbCircles==0){
+		rows=0;
+		cols=0;
+		return;
+	}
+	rows=Dcircles[0].rows;
+	cols=Dcircles[0].cols;
+	for(int k=0;k<nbCircles;k++)
+		CV_Assert(Dcircles[k].rows==rows && Dcircles[k].cols==cols && Dcircles[k].type()==CV_64FC1);
+
+	// FFT2::fftshift puts the element (i+rows/2+1,j+cols/2+1) (modulo the size) of the spectrum at (i,j),
+	// so the element (u,v) of the unshifted spectrum is read by the masks at (u+rows-rows/2-1,v+cols-cols/2-1)
+	int shiftR=rows-rows/2-1;
+	int shiftC=cols-cols/2-1;
+	rowStart.resize(rows+1);
+	for(int u=0;u<rows;u++){
+		rowStart[u]=(int)entryCol.size();
+		int i=(u+shiftR)%rows;
+		for(int v=0;v<cols;v++){
+			int j=(v+shiftC)%cols;
+			for(int k=0;k<nbCircles;k++){
+				double w=Dcircles[k].at<double>(i,j);
+				if(w!=0){
+					entryCol.push_back(v);
+					entryCircle.push_back(k);
+					entryWeight.push_back(w);
+				}
+			}
+		}
+	}
+	rowStart[rows]=(int)entryCol.size();
+
+	// Half plane table: the entry of the frequency (fu,fv) and the one of its mirror (-fu,-fv) are
+	// merged, the energies of a real image being the same at both frequencies
+	if(rows%2==0 || cols%2==0)
+		return;
+	std::map<std::pair<std::pair<int,int>,int>,double> half;
+	for(int u=0;u<rows;u++){
+		for(int e=rowStart[u];e<rowStart[u+1];e++){
+			int fu=u<=rows/2 ? u : u-rows;
+			int fv=entryCol[e]<=cols/2 ? entryCol[e] : entryCol[e]-cols;
+			if(fv<0 || (fv==0 && fu<0)){
+				fu=-fu;
+				fv=-fv;
+			}
+			half[std::make_pair(std::make_pair(fu,fv),entryCircle[e])]+=entryWeight[e];
+		}
+	}
+	for(std::map<std::pair<std::pair<int,int>,int>,double>::const_iterator it=half.begin();it!=half.end();++it){
+		halfU.push_back(it->first.first.first);
+		halfV.push_back(it->first.first.second);
+		halfCircle.push_back(it->first.second);
+		halfWeight.push_back(it->second);
+	}
+}
+
+vector<double> CircleTable::integrate(const Mat& X) const{
+	vector<double> res(nbCircles+1);
+	integrate(X,&res[0]);
+	return res;
+}
+
+void CircleTable::integrate(const Mat& X,double* res) const{
+	GCFD_PROFILE_SCOPE("MyTools/integrOnCircles");
+	for(int k=0;k<nbCircles;k++)
+		res[k+1]=0;
+	res[0]=accumulate(X,res+1);
+	for(int k=0;k<nbCircles;k++)
+		res[k+1]/=res[0];
+}
+
+void CircleTable::integrate(const Mat& X,const Mat& Y,double* res) const{
+	GCFD_PROFILE_SCOPE("MyTools/integrOnCircles");
+	for(int k=0;k<nbCircles;k++)
+		res[k+1]=0;
+	res[0]=accumulate(X,res+1);
+	res[0]+=accumulate(Y,res+1);
+	for(int k=0;k<nbCircles;k++)
+		res[k+1]/=res[0];
+}
+
+double CircleTable::accumulate(const Mat& X,double* sums) const{
+	// A larger spectrum is integrated as if it had been cropped around the null frequency
+	CV_Assert((X.rows==rows && X.cols==cols) || (rows==cols && rows%2==1 && std::min(X.rows,X.cols)>=rows));
+	CV_Assert(X.depth()==CV_64F || X.depth()==CV_32F);
+	if(X.depth()==CV_32F)
+		return accumulate_<float>(X,sums);
+	return accumulate_<double>(X,sums);
+}
+
+template<typename T> double CircleTable::accumulate_(const Mat& X,double* sums) const{
+	const int cn=X.channels();
+	const int half=rows/2;
+	const int rowOffset=X.rows-rows;
+	// The energies of the columns read by the table: [0,cols/2] and the last cols-cols/2-1 columns of X
+	const int low=cols/2+1;
+	const int high=cols-low;
+	AutoBuffer<T> buffer(cols);
+	T* energy=buffer;
+
+	for(int u=0;u<rows;u++){
+		const T* x=X.ptr<T>(u<=half ? u : u+rowOffset);
+		rowEnergy(x,cn,energy,low);
+		rowEnergy(x+(X.cols-high)*cn,cn,energy+low,high);
+		for(int e=rowStart[u];e<rowStart[u+1];e++)
+			sums[entryCircle[e]]+=entryWeight[e]*energy[entryCol[e]];
+	}
+
+	const T* p0=X.ptr<T>(0);
+	double energy0=0;
+	for(int c=0;c<cn;c++)
+		energy0+=(double)p0[c]*p0[c];
+	return energy0;
+}
+
+template<typename T> void CircleTable::rowEnergy(const T* x,const int& cn,T* energy,const int& n){
+	if(cn==2){
+		SimdTools::energy(x,energy,n);
+		return;
+	}
+	for(int v=0;v<n;v++){
+		T e=0;
+		for(int c=0;c<cn;c++)
+			e+=x[v*cn+c]*x[v*cn+c];
+		energy[v]=e;
+	}
+}
+
+void CircleTable::integrateCCS(const Mat& X,double* res) const{
+	GCFD_PROFILE_SCOPE("MyTools/integrOnCircles");
+	for(int k=0;k<nbCircles;k++)
+		res[k+1]=0;
+	res[0]=accumulateCCS(X,res+1);
+	for(int k=0;k<nbCircles;k++)
+		res[k+1]/=res[0];
+}
+
+void CircleTable::integrateCCS(const Mat& X,const Mat& Y,double* res) const{
+	GCFD_PROFILE_SCOPE("MyTools/integrOnCircles");
+	for(int k=0;k<nbCircles;k++)
+		res[k+1]=0;
+	res[0]=accumulateCCS(X,res+1);
+	res[0]+=accumulate(Y,res+1);
+	for(int k=0;k<nbCircles;k++)
+		res[k+1]/=res[0];
+}
+
+double CircleTable::accumulateCCS(const Mat& X,double* sums) const{
+	CV_Assert(rows%2==1 && cols%2==1 && X.rows%2==1 && X.cols%2==1);
+	CV_Assert((X.rows==rows && X.cols==cols) || (rows==cols && std::min(X.rows,X.cols)>=rows));
+	CV_Assert(X.type()==CV_64FC1 || X.type()==CV_32FC1);
+	if(X.depth()==CV_32F)
+		return accumulateCCS_<float>(X,sums);
+	return accumulateCCS_<double>(X,sums);
+}
+
+template<typename T> double CircleTable::accumulateCCS_(const Mat& X,double* sums) const{
+	const int nbEntries=(int)halfU.size();
+	const T* col0=X.ptr<T>(0);
+	const size_t step=X.step1();
+
+	for(int e=0;e<nbEntries;e++){
+		const int fu=halfU[e];
+		const int fv=halfV[e];
+		double re,im;
+		if(fv>0){
+			// The columns 2fv-1 and 2fv contain the complex spectrum of the column fv
+			const T* p=X.ptr<T>(fu>=0 ? fu : fu+X.rows)+2*fv-1;
+			re=p[0];
+			im=p[1];
+		}
+		else if(fu>0){
+			// The first column contains the packed spectrum of the real column 0
+			re=col0[(2*fu-1)*step];
+			im=col0[2*fu*step];
+		}
+		else{
+			re=col0[0];
+			im=0;
+		}
+		sums[halfCircle[e]]+=halfWeight[e]*(re*re+im*im);
+	}
+	return (double)col0[0]*col0[0];
+}
+
+int CircleTable::getNbCircles() const{
+	return nbCircles;
+}
+
+Size CircleTable::getSize() const{
+	return Size(cols,rows);
+}
+
+bool CircleTable::empty() const{
+	return nbCircles==0;
+}
+
+size_t CircleTable::getMemorySize() const{
+	return sizeof(*this)+(rowStart.capacity()+entryCol.capacity()+entryCircle.capacity()+halfU.capacity()+halfV.capacity()+halfCircle.capacity())*sizeof(int)
+		+(entryWeight.capacity()+halfWeight.capacity())*sizeof(double);
+}
+
+CircleTable::~CircleTable() {
+}
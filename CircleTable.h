@@ -0,0 +1,198 @@
+/**
+ * \file CircleTable.h
+ * \brief Single-pass integration of a spectrum on discrete circles
+ * \version 1.0
+ * \date October 17, 2026
+ *
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the distribution
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef CIRCLETABLE_H_
+#define CIRCLETABLE_H_
+
+#include <iostream>
+#include <opencv/cv.h>
+#include <opencv/highgui.h>
+#include <vector>
+#include "MyTools.h"
+
+using namespace cv;
+
+template<typename T,int N> class FixedSizeKernel_;
+
+/*! \class CircleTable
+   * \brief Pixel to circle table used to integrate a spectrum on discrete circles
+   *
+   *  The masks built by MyTools::computeDiscreteCircles are compiled once into a list of
+   *  (pixel, circle, weight) entries grouped by row of the spectrum. The fftshift done by
+   *  MyTools::integrOnCircles is folded into the pixel indices, so the whole integration
+   *  is a single pass over the unshifted spectrum instead of one full product per circle.
+   */
+class CircleTable {
+private:
+	int rows;					/*!< Number of rows of the masks */
+	int cols;					/*!< Number of columns of the masks */
+	int nbCircles;				/*!< Number of discrete circles */
+	vector<int> rowStart;		/*!< First entry of each row of the unshifted spectrum (rows+1 elements) */
+	vector<int> entryCol;		/*!< Column of each entry in the unshifted spectrum */
+	vector<int> entryCircle;	/*!< Circle of each entry */
+	vector<double> entryWeight;	/*!< Mask value of each entry */
+	vector<int> halfU;			/*!< Row frequency of each entry of the half plane (in [-rows/2,rows/2]) */
+	vector<int> halfV;			/*!< Column frequency of each entry of the half plane (in [0,cols/2]) */
+	vector<int> halfCircle;		/*!< Circle of each entry of the half plane */
+	vector<double> halfWeight;	/*!< Sum of the mask values of an entry and of its mirror */
+	/*!
+	 *  \brief Build the table from a vector of masks
+	 *
+	 *  \param Dcircles : Each Mat contains a mask used to integrate image values on discrete circles
+	 */
+	void compile(const vector<Mat>& Dcircles);
+	/*!
+	 *  \brief Add the energy of a spectrum on each circle
+	 *
+	 *	\param X : An unshifted spectrum (a Mat of float or double with one or several channels)
+	 *	\param sums : The energies on each circle are added to this array
+	 *	\return Return the energy at the null frequency
+	 */
+	double accumulate(const Mat& X,double* sums) const;
+	template<typename T> double accumulate_(const Mat& X,double* sums) const;
+	/*!
+	 *  \brief Compute the energy of each element of a row
+	 *
+	 *	\param x : The row (cn values per element)
+	 *	\param cn : The number of channels, the elements with 2 channels are complex numbers
+	 *	\param energy : The output, n energies
+	 *	\param n : The number of elements
+	 */
+	template<typename T> static void rowEnergy(const T* x,const int& cn,T* energy,const int& n);
+	/*!
+	 *  \brief Add the energy of a packed spectrum on each circle
+	 *
+	 *	\param X : The packed spectrum of a real image (a Mat of float or double, see RealFFT2)
+	 *	\param sums : The energies on each circle are added to this array
+	 *	\return Return the energy at the null frequency
+	 */
+	double accumulateCCS(const Mat& X,double* sums) const;
+	template<typename T> double accumulateCCS_(const Mat& X,double* sums) const;
+
+	template<typename T,int N> friend class FixedSizeKernel_;
+
+public:
+	CircleTable();
+	/*!
+	 *  \brief Constructor of CircleTable class
+	 *
+	 *  \param Dcircles : Each Mat contains a mask used to integrate image values on discrete circles
+	 *
+	 */
+	CircleTable(const vector<Mat>& Dcircles);
+	/*!
+	 *  \brief Constructor of CircleTable class
+	 *
+	 *  \param maxR : The maximum of radius in the image, i.e. for an image of size 127x127, maxR=63
+	 *
+	 */
+	CircleTable(const int& maxR);
+	/*!
+	 *  \brief Integrate an image on the discrete circles
+	 *
+	 *  Gives the same result as MyTools::integrOnCircles(X,Dcircles): the first element is the
+	 *  energy at the null frequency, the others are the energies on each circle divided by it.
+	 *  For a square table of odd size, X can also be a larger spectrum: only its frequencies
+	 *  up to the radius of the table are read, as if it had been cropped around the null
+	 *  frequency (FFT2::cropSpectrum(X) when the table has the size of the smallest side of X).
+	 *
+	 *	\param X : An unshifted spectrum (a Mat of float or double with one or several channels)
+	 *	\return Return the results of each integration
+	 */
+	vector<double> integrate(const Mat& X) const;
+	/*!
+	 *  \brief Integrate an image on the discrete circles without allocation
+	 *
+	 *	\param X : An unshifted spectrum (a Mat of float or double with one or several channels)
+	 *	\param res : The output, it must have getNbCircles()+1 elements
+	 */
+	void integrate(const Mat& X,double* res) const;
+	/*!
+	 *  \brief Integrate the sum of the energies of two spectra on the discrete circles
+	 *
+	 *  Used to integrate a CFT from its parallel and orthogonal parts, the energy of the
+	 *  reconstructed CFT being the sum of the energies of the two parts.
+	 *
+	 *	\param X : An unshifted spectrum (a Mat of float or double with one or several channels)
+	 *	\param Y : An unshifted spectrum of the same size as X
+	 *	\param res : The output, it must have getNbCircles()+1 elements
+	 */
+	void integrate(const Mat& X,const Mat& Y,double* res) const;
+	/*!
+	 *  \brief Integrate a packed spectrum on the discrete circles
+	 *
+	 *  The spectrum of a real image is hermitian: only the half plane is read and each
+	 *  coefficient is weighted by the masks of the coefficient and of its mirror. Gives the
+	 *  same result as integrate() on the unpacked spectrum. The sizes must be odd and, as for
+	 *  integrate(), X can be larger than a square table.
+	 *
+	 *	\param X : The packed spectrum of a real image (a Mat of float or double, see RealFFT2)
+	 *	\param res : The output, it must have getNbCircles()+1 elements
+	 */
+	void integrateCCS(const Mat& X,double* res) const;
+	/*!
+	 *  \brief Integrate the sum of the energies of a packed spectrum and of a spectrum on the discrete circles
+	 *
+	 *  Used to integrate a CFT when its parallel part is the spectrum of a real image.
+	 *
+	 *	\param X : The packed spectrum of a real image (a Mat of float or double, see RealFFT2)
+	 *	\param Y : An unshifted spectrum of the same size as X
+	 *	\param res : The output, it must have getNbCircles()+1 elements
+	 */
+	void integrateCCS(const Mat& X,const Mat& Y,double* res) const;
+	/*!
+	 *  \brief Get the number of discrete circles
+	 *
+	 *  \return Return the number of discrete circles
+	 */
+	int getNbCircles() const;
+	/*!
+	 *  \brief Get the size of the spectra which can be integrated with this table
+	 *
+	 *  \return Return the size of the masks
+	 */
+	Size getSize() const;
+	/*!
+	 *  \brief Check if the table has been built
+	 *
+	 *  \return Return true if the table contains no circle
+	 */
+	bool empty() const;
+	/*!
+	 *  \brief Get the memory used by the table
+	 *
+	 *  \return Return the size of the entries (in bytes)
+	 */
+	size_t getMemorySize() const;
+
+	virtual ~CircleTable();
+};
+
+#endif /* CIRCLETABLE_H_ */
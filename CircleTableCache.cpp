@@ -0,0 +1,147 @@
+/**
+ * \file CircleTableCache.cpp
+ * \brief Process-wide cache of the circle tables shared by the descriptors
+ * \version 1.0
+ * \date October 17, 2026
+ *
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the distribution
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "CircleTableCache.h"
+#include "Profiler.h"
+#include <list>
+#include <map>
+
+/*!
+ *  \brief A table of the cache and its position in the LRU list
+ */
+struct CircleTableEntry {
+	Ptr<const CircleTable> table;		/*!< The table */
+	size_t bytes;						/*!< Memory used by the table */
+	std::list<int>::iterator use;		/*!< Position of the radius in the LRU list */
+};
+
+static Mutex cacheMutex;								/*!< Protect all the variables below */
+static std::map<int,CircleTableEntry> cacheEntries;		/*!< The tables, keyed by the maximum radius */
+static std::list<int> cacheUses;						/*!< The radii from the most to the least recently used */
+static CircleTableCacheStats cacheStats={0,0,0,0,0,128<<20};
+
+/*!
+ *  \brief Evict the least recently used tables until the memory limit is respected, the cache mutex must be locked
+ */
+static void evictTables(){
+	while(cacheStats.bytes>cacheStats.maxBytes && cacheUses.size()>1){
+		std::map<int,CircleTableEntry>::iterator it=cacheEntries.find(cacheUses.back());
+		cacheStats.bytes-=it->second.bytes;
+		cacheStats.evictions++;
+		cacheEntries.erase(it);
+		cacheUses.pop_back();
+	}
+	cacheStats.entries=(int)cacheEntries.size();
+}
+
+/*!
+ *  \brief Find a table and mark it as the most recently used, the cache mutex must be locked
+ */
+static bool findTable(const int& maxR,Ptr<const CircleTable>& table){
+	std::map<int,CircleTableEntry>::iterator it=cacheEntries.find(maxR);
+	if(it==cacheEntries.end())
+		return false;
+	cacheUses.splice(cacheUses.begin(),cacheUses,it->second.use);
+	table=it->second.table;
+	return true;
+}
+
+/*!
+ *  \brief Find a table and count the request as a hit or a miss
+ */
+static bool lookupTable(const int& maxR,Ptr<const CircleTable>& table){
+	AutoLock lock(cacheMutex);
+	bool found=findTable(maxR,table);
+	if(found)
+		cacheStats.hits++;
+	else
+		cacheStats.misses++;
+	return found;
+}
+
+/*!
+ *  \brief Build a table, outside of the cache mutex
+ */
+static Ptr<const CircleTable> buildTable(const int& maxR){
+	GCFD_PROFILE_SCOPE("Descriptors/buildPlan");
+	return Ptr<const CircleTable>(new CircleTable(maxR));
+}
+
+Ptr<const CircleTable> CircleTableCache::get(const int& maxR){
+	CV_Assert(maxR>=0);
+	Ptr<const CircleTable> table;
+	if(lookupTable(maxR,table))
+		return table;
+
+	// The table is built without the lock, so that the other sizes are still served. If two
+	// threads build the same table, the first one inserted is kept.
+	table=buildTable(maxR);
+	AutoLock lock(cacheMutex);
+	Ptr<const CircleTable> inserted;
+	if(findTable(maxR,inserted))
+		return inserted;
+	CircleTableEntry& entry=cacheEntries[maxR];
+	entry.table=table;
+	entry.bytes=table->getMemorySize();
+	entry.use=cacheUses.insert(cacheUses.begin(),maxR);
+	cacheStats.bytes+=entry.bytes;
+	evictTables();
+	return table;
+}
+
+Ptr<const CircleTable> CircleTableCache::get(const Size& size){
+	return get(std::min(size.width-(size.width%2==0),size.height-(size.height%2==0))/2);
+}
+
+void CircleTableCache::setMaxMemory(const size_t& bytes){
+	AutoLock lock(cacheMutex);
+	cacheStats.maxBytes=bytes;
+	evictTables();
+}
+
+CircleTableCacheStats CircleTableCache::getStats(){
+	AutoLock lock(cacheMutex);
+	return cacheStats;
+}
+
+void CircleTableCache::resetStats(){
+	AutoLock lock(cacheMutex);
+	cacheStats.hits=0;
+	cacheStats.misses=0;
+	cacheStats.evictions=0;
+}
+
+void CircleTableCache::clear(){
+	AutoLock lock(cacheMutex);
+	cacheEntries.clear();
+	cacheUses.clear();
+	cacheStats.entries=0;
+	cacheStats.bytes=0;
+}
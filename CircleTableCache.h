@@ -0,0 +1,103 @@
+/**
+ * \file CircleTableCache.h
+ * \brief Process-wide cache of the circle tables shared by the descriptors
+ * \version 1.0
+ * \date October 17, 2026
+ *
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the distribution
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef CIRCLETABLECACHE_H_
+#define CIRCLETABLECACHE_H_
+
+#include <iostream>
+#include <opencv/cv.h>
+#include <opencv/highgui.h>
+#include <vector>
+#include "CircleTable.h"
+
+using namespace cv;
+
+/*!
+ *  \brief Counters of the circle table cache
+ */
+struct CircleTableCacheStats {
+	long long hits;			/*!< Number of requests served by a cached table */
+	long long misses;		/*!< Number of requests which have built a table */
+	long long evictions;	/*!< Number of tables removed to respect the memory limit */
+	int entries;			/*!< Number of tables in the cache */
+	size_t bytes;			/*!< Memory used by the tables of the cache */
+	size_t maxBytes;		/*!< Memory limit of the cache */
+};
+
+/*! \class CircleTableCache
+   * \brief Process-wide cache of the circle tables, keyed by the maximum radius
+   *
+   *  Building the masks of MyTools::computeDiscreteCircles and compiling them costs far more
+   *  than integrating a spectrum, so the tables are built once per size and shared by all the
+   *  threads. A table is never modified once built: it is returned as a Ptr and stays valid
+   *  for its holders even after it has been evicted. When the tables exceed the memory limit,
+   *  the least recently used ones are evicted.
+   */
+class CircleTableCache {
+public:
+	/*!
+	 *  \brief Get the table of a maximum radius, it is built on the first request
+	 *
+	 *  \param maxR : The maximum of radius in the image, i.e. for an image of size 127x127, maxR=63
+	 *  \return Return the shared table
+	 */
+	static Ptr<const CircleTable> get(const int& maxR);
+	/*!
+	 *  \brief Get the table of an image size
+	 *
+	 *  \param size : The size of the image, the table is the one of the image made odd (see CFTPlan::cropToOddSize)
+	 *  \return Return the shared table
+	 */
+	static Ptr<const CircleTable> get(const Size& size);
+	/*!
+	 *  \brief Set the memory limit of the cache
+	 *
+	 *  The table returned last is always kept, even if it is larger than the limit.
+	 *
+	 *  \param bytes : The memory limit (in bytes), 0 keeps only the table returned last
+	 */
+	static void setMaxMemory(const size_t& bytes);
+	/*!
+	 *  \brief Get the counters of the cache
+	 *
+	 *  \return Return the counters
+	 */
+	static CircleTableCacheStats getStats();
+	/*!
+	 *  \brief Reset the counters of hits, misses and evictions
+	 */
+	static void resetStats();
+	/*!
+	 *  \brief Remove all the tables from the cache
+	 */
+	static void clear();
+};
+
+#endif /* CIRCLETABLECACHE_H_ */
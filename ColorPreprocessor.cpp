@@ -0,0 +1,298 @@
+/**
+ * \file ColorPreprocessor.cpp
+ * \brief Conversion of the color images to the normalized planes and parts of the CFT
+ * \version 1.0
+ * \date October 17, 2026
+ *
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the distribution
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "ColorPreprocessor.h"
+#include "CFTPlan.h"
+#include "SimdTools.h"
+
+/*! Rows of ColorPreprocessor_::coef */
+enum { PAR_RE=0, PAR_IM=1, ORTH_RE=2, ORTH_IM=3 };
+
+/*!
+ *  \brief Get the channels of R, G, B and alpha (-1 if there is no alpha) in a pixel
+ */
+static void getChannelIndices(const ColorOrder& order,const int& cn,int index[4]){
+	if(cn==1){
+		index[0]=index[1]=index[2]=0;
+		index[3]=-1;
+		return;
+	}
+	const bool bgr=order==COLOR_ORDER_BGR || (order==COLOR_ORDER_AUTO && cn==3);
+	index[0]=bgr ? 2 : 0;
+	index[1]=1;
+	index[2]=bgr ? 0 : 2;
+	index[3]=cn==4 ? 3 : -1;
+}
+
+/*!
+ *  \brief Divide the channels of a row by the range, as (T)x/(T)range
+ */
+template<typename S,typename T> static void splitChannels(const uchar* const src[4],const int& step,const int& cols,const T& range,T* const planes[4]){
+	for(int k=0;k<4;k++){
+		if(!src[k])
+			continue;
+		const S* s=(const S*)src[k];
+		T* x=planes[k];
+		for(int j=0;j<cols;j++,s+=step)
+			x[j]=(T)*s/range;
+	}
+}
+
+/*!
+ *  \brief Project a row of a uchar image with the lookup tables
+ *
+ *  lut(3*k+c,v) is the coefficient of the color c in the part k times v/range and lut(9,v)
+ *  is v/range: these are the products computed by splitChannels and SimdTools, so both
+ *  paths give the same results.
+ */
+template<typename T> static void lutRow(const Mat& lut,const uchar* const src[4],const int& step,const int& cols,T* par,const int& parStep,T* orth){
+	const T* parR=lut.ptr<T>(0);
+	const T* parG=lut.ptr<T>(1);
+	const T* parB=lut.ptr<T>(2);
+	const T* orthReR=lut.ptr<T>(3);
+	const T* orthReG=lut.ptr<T>(4);
+	const T* orthReB=lut.ptr<T>(5);
+	const T* orthImR=lut.ptr<T>(6);
+	const T* orthImG=lut.ptr<T>(7);
+	const T* orthImB=lut.ptr<T>(8);
+	const T* alpha=lut.ptr<T>(9);
+	const uchar* r=src[0];
+	const uchar* g=src[1];
+	const uchar* b=src[2];
+	const uchar* a=src[3];
+	for(int j=0;j<cols;j++,r+=step,g+=step,b+=step,par+=parStep){
+		par[0]=parR[*r]+parG[*g]+parB[*b];
+		if(parStep==2)
+			par[1]=a ? alpha[a[j*step]] : 0;
+		if(orth){
+			orth[0]=orthReR[*r]+orthReG[*g]+orthReB[*b];
+			orth[1]=orthImR[*r]+orthImG[*g]+orthImB[*b];
+			orth+=2;
+		}
+	}
+}
+
+/*!
+ *  \brief Reconstruct the channels of a row from the parts, see ColorPreprocessor_::reconstruct
+ */
+template<typename S,typename T> static void reconstructChannels(const T* par,const T* orth,const T coef[4][4],const int index[4],const int& cn,const int& cols,const T& range,S* out){
+	for(int j=0;j<cols;j++,par+=2,orth+=2,out+=cn){
+		for(int k=0;k<3;k++)
+			out[index[k]]=saturate_cast<S>(range*(coef[PAR_RE][k]*par[0]+coef[ORTH_RE][k]*orth[0]+coef[ORTH_IM][k]*orth[1]));
+		if(index[3]>=0)
+			out[index[3]]=saturate_cast<S>(range*par[1]);
+	}
+}
+
+ColorPreprocessing::ColorPreprocessing(const ColorOrder& order,const double& range) : order(order), range(range) {
+}
+
+bool ColorPreprocessing::operator==(const ColorPreprocessing& p) const{
+	return order==p.order && range==p.range;
+}
+
+bool ColorPreprocessing::operator!=(const ColorPreprocessing& p) const{
+	return !(*this==p);
+}
+
+template<typename T> ColorPreprocessor_<T>::ColorPreprocessor_(const ColorPreprocessing& config) : config(config), projection(false) {
+	CV_Assert(config.range>0);
+	for(int k=0;k<4;k++)
+		for(int c=0;c<4;c++)
+			coef[k][c]=0;
+}
+
+template<typename T> ColorPreprocessor_<T>::ColorPreprocessor_(const Mat& Vec,const ColorPreprocessing& config) : config(config), projection(true) {
+	CV_Assert(config.range>0);
+	double Cn[3],Vn[3],Wn[3];
+	CFTPlan::getBasis(Vec,Cn,Vn,Wn);
+
+	// The parallel part is Cn.x+i e4.x, the orthogonal part is Vn.x+i Wn.x
+	for(int k=0;k<3;k++){
+		coef[PAR_RE][k]=(T)Cn[k];
+		coef[PAR_IM][k]=0;
+		coef[ORTH_RE][k]=(T)Vn[k];
+		coef[ORTH_IM][k]=(T)Wn[k];
+	}
+	coef[PAR_RE][3]=0;
+	coef[PAR_IM][3]=1;
+	coef[ORTH_RE][3]=0;
+	coef[ORTH_IM][3]=0;
+
+	lut.create(10,256,DataType<T>::depth);
+	const T range=(T)config.range;
+	for(int v=0;v<256;v++){
+		T x=(T)v/range;
+		for(int k=0;k<3;k++)
+			for(int c=0;c<3;c++)
+				lut.at<T>(3*k+c,v)=coef[k==0 ? PAR_RE : k==1 ? ORTH_RE : ORTH_IM][c]*x;
+		lut.at<T>(9,v)=x;
+	}
+}
+
+template<typename T> int ColorPreprocessor_<T>::checkSource(const Mat* in,const int& nbMats) const{
+	const int cn=nbMats==1 ? in[0].channels() : nbMats;
+	CV_Assert(cn==1 || cn==3 || cn==4);
+	const int depth=in[0].depth();
+	if(depth!=CV_8U && depth!=CV_32F && depth!=CV_64F)
+		CV_Error(CV_StsUnsupportedFormat,"ColorPreprocessor: the image must be of uchar, float or double");
+	for(int k=1;k<nbMats;k++)
+		CV_Assert(in[k].size()==in[0].size() && in[k].type()==in[0].type() && in[k].channels()==1);
+	return depth;
+}
+
+template<typename T> void ColorPreprocessor_<T>::getRows(const Mat* in,const int& nbMats,const int& i,const uchar* src[4],int& step) const{
+	const int cn=nbMats==1 ? in[0].channels() : nbMats;
+	int index[4];
+	getChannelIndices(config.order,cn,index);
+	for(int k=0;k<4;k++){
+		if(index[k]<0)
+			src[k]=0;
+		else if(nbMats==1)
+			src[k]=in[0].ptr(i)+index[k]*in[0].elemSize1();
+		else
+			src[k]=in[index[k]].ptr(i);
+	}
+	step=nbMats==1 ? cn : 1;
+}
+
+template<typename T> void ColorPreprocessor_<T>::splitRow(const Mat* in,const int& nbMats,const int& i,T* const planes[4]) const{
+	const uchar* src[4];
+	int step;
+	getRows(in,nbMats,i,src,step);
+	const int cols=in[0].cols;
+	const T range=(T)config.range;
+	switch(in[0].depth()){
+	case CV_8U:
+		splitChannels<uchar,T>(src,step,cols,range,planes);
+		break;
+	case CV_32F:
+		splitChannels<float,T>(src,step,cols,range,planes);
+		break;
+	default:
+		splitChannels<double,T>(src,step,cols,range,planes);
+		break;
+	}
+}
+
+template<typename T> void ColorPreprocessor_<T>::projectRow(const Mat* in,const int& nbMats,const int& i,T* par,const int& parStep,T* orth,T* buffer) const{
+	const uchar* src[4];
+	int step;
+	getRows(in,nbMats,i,src,step);
+	const int cols=in[0].cols;
+	if(in[0].depth()==CV_8U){
+		// Fused path: one read of the image, no intermediate plane
+		lutRow(lut,src,step,cols,par,parStep,orth);
+		return;
+	}
+	T* const planes[4]={buffer,buffer+cols,buffer+2*cols,src[3] ? buffer+3*cols : 0};
+	splitRow(in,nbMats,i,planes);
+	if(parStep==2)
+		SimdTools::combineComplex(planes[0],planes[1],planes[2],planes[3],coef[PAR_RE],coef[PAR_IM],par,cols);
+	else
+		SimdTools::combineReal(planes[0],planes[1],planes[2],coef[PAR_RE],par,cols);
+	if(orth)
+		SimdTools::combineComplex(planes[0],planes[1],planes[2],0,coef[ORTH_RE],coef[ORTH_IM],orth,cols);
+}
+
+template<typename T> void ColorPreprocessor_<T>::project(const Mat* in,const int& nbMats,Mat& par,Mat* orth,Mat& buffer) const{
+	CV_Assert(projection);
+	const int depth=checkSource(in,nbMats);
+	const int rows=in[0].rows;
+	const int cols=in[0].cols;
+	const bool alpha=hasAlpha(nbMats==1 ? in[0].channels() : nbMats);
+	CV_Assert(par.rows==rows && par.cols==cols && par.depth()==DataType<T>::depth && (par.channels()==2 || (par.channels()==1 && !alpha)));
+	CV_Assert(!orth || (orth->rows==rows && orth->cols==cols && orth->type()==CV_MAKETYPE(DataType<T>::depth,2)));
+	if(depth!=CV_8U && (!buffer.isContinuous() || buffer.depth()!=DataType<T>::depth || buffer.total()*buffer.channels()<4*(size_t)cols))
+		buffer.create(4,cols,DataType<T>::depth);
+	T* b=depth==CV_8U ? 0 : buffer.ptr<T>(0);
+	for(int i=0;i<rows;i++)
+		projectRow(in,nbMats,i,par.ptr<T>(i),par.channels(),orth ? orth->ptr<T>(i) : 0,b);
+}
+
+template<typename T> void ColorPreprocessor_<T>::split(const Mat& in,const int& i,T* const planes[4]) const{
+	checkSource(&in,1);
+	splitRow(&in,1,i,planes);
+}
+
+template<typename T> void ColorPreprocessor_<T>::split(const vector<Mat>& in,const int& i,T* const planes[4]) const{
+	CV_Assert(!in.empty());
+	checkSource(&in[0],(int)in.size());
+	splitRow(&in[0],(int)in.size(),i,planes);
+}
+
+template<typename T> void ColorPreprocessor_<T>::project(const Mat& in,const int& i,T* par,const int& parStep,T* orth,T* buffer) const{
+	CV_Assert(projection && (parStep==2 || !hasAlpha(in.channels())));
+	checkSource(&in,1);
+	projectRow(&in,1,i,par,parStep,orth,buffer);
+}
+
+template<typename T> void ColorPreprocessor_<T>::project(const Mat& in,Mat& par,Mat* orth,Mat& buffer) const{
+	project(&in,1,par,orth,buffer);
+}
+
+template<typename T> void ColorPreprocessor_<T>::project(const vector<Mat>& in,Mat& par,Mat* orth,Mat& buffer) const{
+	CV_Assert(!in.empty());
+	project(&in[0],(int)in.size(),par,orth,buffer);
+}
+
+template<typename T> void ColorPreprocessor_<T>::reconstruct(const T* par,const T* orth,Mat& out,const int& i) const{
+	CV_Assert(projection && (out.channels()==3 || out.channels()==4) && i>=0 && i<out.rows);
+	int index[4];
+	getChannelIndices(config.order,out.channels(),index);
+	const T range=(T)config.range;
+	switch(out.depth()){
+	case CV_8U:
+		reconstructChannels(par,orth,coef,index,out.channels(),out.cols,range,out.ptr<uchar>(i));
+		break;
+	case CV_32F:
+		reconstructChannels(par,orth,coef,index,out.channels(),out.cols,range,out.ptr<float>(i));
+		break;
+	case CV_64F:
+		reconstructChannels(par,orth,coef,index,out.channels(),out.cols,range,out.ptr<double>(i));
+		break;
+	default:
+		CV_Error(CV_StsUnsupportedFormat,"ColorPreprocessor: the image must be of uchar, float or double");
+	}
+}
+
+template<typename T> const ColorPreprocessing& ColorPreprocessor_<T>::getConfig() const{
+	return config;
+}
+
+template<typename T> bool ColorPreprocessor_<T>::hasAlpha(const int& nbChannels){
+	return nbChannels==4;
+}
+
+template<typename T> ColorPreprocessor_<T>::~ColorPreprocessor_() {
+}
+
+template class ColorPreprocessor_<float>;
+template class ColorPreprocessor_<double>;
@@ -0,0 +1,238 @@
+/**
+ * \file ColorPreprocessor.h
+ * \brief Conversion of the color images to the normalized planes and parts of the CFT
+ * \version 1.0
+ * \date October 17, 2026
+ *
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the distribution
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef COLORPREPROCESSOR_H_
+#define COLORPREPROCESSOR_H_
+
+#include <iostream>
+#include <opencv/cv.h>
+#include <opencv/highgui.h>
+#include <vector>
+
+using namespace cv;
+
+/*!
+ *  \brief The order of the channels of the color images
+ */
+enum ColorOrder {
+	COLOR_ORDER_AUTO,		/*!< As the legacy descriptors: BGR for 3 channels (see MyTools::reorderColorChannel), RGBA for 4 channels */
+	COLOR_ORDER_BGR,		/*!< BGR or BGRA */
+	COLOR_ORDER_RGB			/*!< RGB or RGBA */
+};
+
+/*! \struct ColorPreprocessing
+   * \brief Configuration of the conversion of the images by ColorPreprocessor_
+   */
+struct ColorPreprocessing {
+	ColorOrder order;		/*!< The order of the channels of the color images (a gray image gives the three colors) */
+	double range;			/*!< The value of a channel mapped to 1 (255 for the 8 bit images of the legacy descriptors) */
+	/*!
+	 *  \brief Constructor of ColorPreprocessing struct
+	 *
+	 *  \param order : The order of the channels of the color images
+	 *  \param range : The value of a channel mapped to 1
+	 */
+	ColorPreprocessing(const ColorOrder& order=COLOR_ORDER_AUTO,const double& range=255);
+	bool operator==(const ColorPreprocessing& p) const;
+	bool operator!=(const ColorPreprocessing& p) const;
+};
+
+/*! \class ColorPreprocessor_
+   * \brief Convert the images to the normalized color planes and to the parts of the CFT
+   *
+   *  The legacy descriptors reorder the channels (MyTools::reorderColorChannel), convert the
+   *  image to double and divide it by 255 before projecting it on the basis of the bivector,
+   *  each step being a pass on the whole image. A preprocessor does all of them in one pass on
+   *  each row, straight from the image to the planes (R,G,B and alpha divided by the range) or
+   *  to the parallel and orthogonal parts given to the DFTs:
+   *    - uchar images: the products of the coefficients by the 256 values are tabulated, so a
+   *      part is three lookups and two additions per pixel;
+   *    - float and double images: the row is split in planes and the parts are computed by the
+   *      vectorised kernels of SimdTools.
+   *
+   *  The source is either interleaved (one Mat of 1, 3 or 4 channels) or planar (1, 3 or 4 Mats
+   *  of one channel, e.g. given by cv::split or by a decoder), the order of the channels being
+   *  the one of the configuration in both cases. A gray image is used for the three colors. A
+   *  preprocessor is never modified after its construction and can be shared by threads.
+   *
+   *  T is the precision of the planes and of the parts (float or double), see CFTPlan_.
+   */
+template<typename T> class ColorPreprocessor_ {
+private:
+	ColorPreprocessing config;	/*!< The order of the channels and the scaling */
+	bool projection;			/*!< True if the coefficients of a bivector have been computed */
+	T coef[4][4];				/*!< The coefficients of the real and imaginary parts of the parallel and orthogonal parts (R,G,B,alpha) */
+	Mat lut;					/*!< Products of the coefficients by the 256 values of a uchar image divided by the range */
+
+	/*!
+	 *  \brief Get the rows of the color channels of a source
+	 *
+	 *  \param in : The source, one interleaved Mat or nbMats planes
+	 *  \param nbMats : The number of Mats of the source
+	 *  \param i : The row
+	 *  \param src : The output, the rows of R, G, B and alpha (null if there is no alpha)
+	 *  \param step : The output, the distance between two pixels of a channel (in elements)
+	 */
+	void getRows(const Mat* in,const int& nbMats,const int& i,const uchar* src[4],int& step) const;
+	/*!
+	 *  \brief Check a source and get its depth
+	 *
+	 *  \param in : The source, one interleaved Mat or nbMats planes
+	 *  \param nbMats : The number of Mats of the source
+	 *  \return Return the depth of the source
+	 */
+	int checkSource(const Mat* in,const int& nbMats) const;
+	/*!
+	 *  \brief Split a row of a source in planes divided by the range
+	 *
+	 *  \param in : The source, one interleaved Mat or nbMats planes
+	 *  \param nbMats : The number of Mats of the source
+	 *  \param i : The row
+	 *  \param planes : The rows of the R, G, B and alpha planes
+	 */
+	void splitRow(const Mat* in,const int& nbMats,const int& i,T* const planes[4]) const;
+	/*!
+	 *  \brief Project a row of a source on the basis
+	 *
+	 *  \param in : The source, one interleaved Mat or nbMats planes
+	 *  \param nbMats : The number of Mats of the source
+	 *  \param i : The row
+	 *  \param par : The row of the parallel part
+	 *  \param parStep : 2 if par is complex, 1 if it is real
+	 *  \param orth : The row of the orthogonal part (or null)
+	 *  \param buffer : Work buffer of 4 rows of planes
+	 */
+	void projectRow(const Mat* in,const int& nbMats,const int& i,T* par,const int& parStep,T* orth,T* buffer) const;
+	/*!
+	 *  \brief Project a source on the basis
+	 *
+	 *  \param in : The source, one interleaved Mat or nbMats planes
+	 *  \param nbMats : The number of Mats of the source
+	 *  \param par : The parallel part (complex or real)
+	 *  \param orth : The orthogonal part (or null)
+	 *  \param buffer : Work buffer of 4 rows of planes
+	 */
+	void project(const Mat* in,const int& nbMats,Mat& par,Mat* orth,Mat& buffer) const;
+
+public:
+	/*!
+	 *  \brief Constructor of ColorPreprocessor_ class, for the planes only
+	 *
+	 *  \param config : The order of the channels and the scaling
+	 */
+	ColorPreprocessor_(const ColorPreprocessing& config=ColorPreprocessing());
+	/*!
+	 *  \brief Constructor of ColorPreprocessor_ class, for the planes and the parts of a bivector
+	 *
+	 *  \param Vec : A color vector used to build the bivector B=Vec^e4
+	 *  \param config : The order of the channels and the scaling
+	 */
+	ColorPreprocessor_(const Mat& Vec,const ColorPreprocessing& config=ColorPreprocessing());
+	/*!
+	 *  \brief Split a row of an image in planes divided by the range
+	 *
+	 *  \param in : An image of 1, 3 or 4 channels (uchar, float or double)
+	 *  \param i : The row
+	 *  \param planes : The rows of the R, G, B and alpha planes (the alpha one is written only if the image has 4 channels)
+	 */
+	void split(const Mat& in,const int& i,T* const planes[4]) const;
+	/*!
+	 *  \brief Split a row of a planar image in planes divided by the range
+	 *
+	 *  \param in : 1, 3 or 4 planes of one channel (uchar, float or double), in the order of the configuration
+	 *  \param i : The row
+	 *  \param planes : The rows of the R, G, B and alpha planes (the alpha one is written only if there are 4 planes)
+	 */
+	void split(const vector<Mat>& in,const int& i,T* const planes[4]) const;
+	/*!
+	 *  \brief Project a row of an image on the basis: par=Cn.x+i.alpha, orth=Vn.x+i.Wn.x
+	 *
+	 *  \param in : An image of 1, 3 or 4 channels (uchar, float or double)
+	 *  \param i : The row
+	 *  \param par : The row of the parallel part
+	 *  \param parStep : 2 if par is complex, 1 if it is real (only without alpha)
+	 *  \param orth : The row of the orthogonal part (or null if it is not needed)
+	 *  \param buffer : Work buffer of 4*in.cols elements (not used for a uchar image)
+	 */
+	void project(const Mat& in,const int& i,T* par,const int& parStep,T* orth,T* buffer) const;
+	/*!
+	 *  \brief Project an image on the basis
+	 *
+	 *  \param in : An image of 1, 3 or 4 channels (uchar, float or double)
+	 *  \param par : The parallel part, a Mat of T of the size of the image (complex, or real without alpha)
+	 *  \param orth : The orthogonal part, a complex Mat of T of the size of the image (or null)
+	 *  \param buffer : Work buffer, reallocated only if it is smaller than 4 rows of the image
+	 */
+	void project(const Mat& in,Mat& par,Mat* orth,Mat& buffer) const;
+	/*!
+	 *  \brief Project a planar image on the basis
+	 *
+	 *  \param in : 1, 3 or 4 planes of one channel (uchar, float or double), in the order of the configuration
+	 *  \param par : The parallel part, a Mat of T of the size of the planes (complex, or real without alpha)
+	 *  \param orth : The orthogonal part, a complex Mat of T of the size of the planes (or null)
+	 *  \param buffer : Work buffer, reallocated only if it is smaller than 4 rows of the image
+	 */
+	void project(const vector<Mat>& in,Mat& par,Mat* orth,Mat& buffer) const;
+	/*!
+	 *  \brief Reconstruct a row of an image from its parts, the inverse of project
+	 *
+	 *  The basis is orthonormal, so the color is Cn.Re(par)+Vn.Re(orth)+Wn.Im(orth) and the
+	 *  alpha channel is Im(par), multiplied by the range and written in the order of the
+	 *  configuration (saturated for a uchar image).
+	 *
+	 *  \param par : The row of the parallel part (complex)
+	 *  \param orth : The row of the orthogonal part (complex)
+	 *  \param out : An image of 3 or 4 channels (uchar, float or double)
+	 *  \param i : The row of out
+	 */
+	void reconstruct(const T* par,const T* orth,Mat& out,const int& i) const;
+	/*!
+	 *  \brief Get the configuration
+	 *
+	 *  \return Return the order of the channels and the scaling
+	 */
+	const ColorPreprocessing& getConfig() const;
+	/*!
+	 *  \brief Check if an image has an alpha channel
+	 *
+	 *  Without alpha the parallel part is real (see CFTPlan_::executePacked).
+	 *
+	 *  \param nbChannels : The number of channels (or of planes) of the image
+	 *  \return Return true if the image has 4 channels
+	 */
+	static bool hasAlpha(const int& nbChannels);
+
+	virtual ~ColorPreprocessor_();
+};
+
+typedef ColorPreprocessor_<double> ColorPreprocessor;
+typedef ColorPreprocessor_<float> ColorPreprocessorf;
+
+#endif /* COLORPREPROCESSOR_H_ */
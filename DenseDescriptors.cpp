@@ -0,0 +1,283 @@
+/**
+ * \file DenseDescriptors.cpp
+ * \brief Descriptors of dense sliding windows over a large image
+ * \version 1.0
+ * \date October 17, 2026
+ *
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the distribution
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "DenseDescriptors.h"
+#include "CircleTableCache.h"
+#include "Profiler.h"
+#include <cmath>
+#include <cstring>
+
+/*!
+ *  \brief Work buffers of the sliding DFT of a band of rows of windows
+ */
+struct DenseScratch {
+	int nx;						/*!< The number of windows in a row */
+	size_t rowSize;				/*!< The number of complex values of the segments of a row (all the parts) */
+	vector<double> ring;		/*!< The segments of the last rows (the row r in r%rows), 0 before the first row of the band */
+	vector<double> spectra;		/*!< The spectrum of each window of the current row of windows: [part][x][v][u] */
+	vector<double> segments;	/*!< The DFT of the segments of the current row: [part][x][v] */
+	vector<double> projected;	/*!< The parts of the current row */
+	vector<double> planes;		/*!< The color planes of the current row (float and double images) */
+	vector<double> running;		/*!< The DFT of the current segment */
+};
+
+/*! \class DenseDescriptorsBody
+   * \brief Body of the parallel loop of DenseDescriptors_, one band of rows of windows per iteration
+   */
+template<typename T> class DenseDescriptorsBody : public ParallelLoopBody {
+private:
+	const DenseDescriptors_<T>* dense;	/*!< The extractor */
+	const Mat* im;						/*!< The image */
+	Mat* features;						/*!< The feature map */
+	int nbBands;						/*!< The number of bands */
+public:
+	DenseDescriptorsBody(const DenseDescriptors_<T>* dense,const Mat* im,Mat* features,const int& nbBands)
+		: dense(dense), im(im), features(features), nbBands(nbBands) {
+	}
+	virtual void operator()(const Range& range) const{
+		for(int b=range.start;b<range.end;b++){
+			Range rows(b*features->rows/nbBands,(b+1)*features->rows/nbBands);
+			if(rows.start==rows.end)
+				continue;
+			if(dense->strategy==DENSE_SLIDING)
+				dense->computeSliding(*im,*features,rows);
+			else
+				dense->computeFFT(*im,*features,rows);
+		}
+	}
+};
+
+/*!
+ *  \brief Build the table exp(-2i.pi.k.t/n) for t,k<n (rows t, columns k)
+ */
+static Mat dftTable(const int& n){
+	Mat res(n,n,CV_64FC2);
+	for(int t=0;t<n;t++){
+		double* p=res.ptr<double>(t);
+		for(int k=0;k<n;k++){
+			// t.k is reduced modulo n to keep the angles small
+			double a=-2*CV_PI*((t*k)%n)/n;
+			p[2*k]=std::cos(a);
+			p[2*k+1]=std::sin(a);
+		}
+	}
+	return res;
+}
+
+template<typename T> DenseDescriptors_<T>::DenseDescriptors_(const DescriptorType& type,const Mat& Biv,const Size& window,const Size& stride,const DenseStrategy& strategy,const ColorPreprocessing& preprocessing)
+	: type(type), window(window), stride(stride), strategy(strategy) {
+	CV_Assert(window.width>0 && window.height>0 && stride.width>0 && stride.height>0);
+	Biv.convertTo(this->Biv,CV_64F);
+	oddWindow=Size(window.width-(window.width%2==0),window.height-(window.height%2==0));
+	CV_Assert(oddWindow.width>0 && oddWindow.height>0);
+	if(this->strategy==DENSE_AUTO)
+		this->strategy=chooseStrategy(window,stride);
+	preprocessor=ColorPreprocessor(this->Biv,preprocessing);
+	phiRows=dftTable(oddWindow.height);
+	phiCols=dftTable(oddWindow.width);
+	table=CircleTableCache::get(oddWindow);
+}
+
+template<typename T> void DenseDescriptors_<T>::transformRow(const Mat& im,const int& r,DenseScratch& s) const{
+	const int nbParts=type==GFD1_DESCRIPTOR ? 1 : 2;
+	const int cols=im.cols;
+	const int wc=oddWindow.width;
+	const int nx=s.nx;
+	double* projected=&s.projected[0];
+	double* running=&s.running[0];
+	double* orth=nbParts==2 ? projected+2*cols : 0;
+	preprocessor.project(im,r,projected,2,orth,&s.planes[0]);
+
+	const int lastX=(nx-1)*stride.width;
+	for(int p=0;p<nbParts;p++){
+		const double* f=projected+2*p*cols;
+		double* out=&s.segments[2*(size_t)p*nx*wc];
+		// DFT of the first segment, with the phases of the image columns
+		for(int v=0;v<2*wc;v++)
+			running[v]=0;
+		for(int c=0;c<wc;c++){
+			const double* phi=phiCols.ptr<double>(c);
+			for(int v=0;v<wc;v++){
+				running[2*v]+=f[2*c]*phi[2*v]-f[2*c+1]*phi[2*v+1];
+				running[2*v+1]+=f[2*c]*phi[2*v+1]+f[2*c+1]*phi[2*v];
+			}
+		}
+		memcpy(out,running,2*wc*sizeof(double));
+		// Moving right: the column x leaves, the column x+wc enters, both have the phases of x
+		for(int x=0;x<lastX;x++){
+			const double dr=f[2*(x+wc)]-f[2*x];
+			const double di=f[2*(x+wc)+1]-f[2*x+1];
+			const double* phi=phiCols.ptr<double>(x%wc);
+			for(int v=0;v<wc;v++){
+				running[2*v]+=dr*phi[2*v]-di*phi[2*v+1];
+				running[2*v+1]+=dr*phi[2*v+1]+di*phi[2*v];
+			}
+			if((x+1)%stride.width==0)
+				memcpy(out+2*(size_t)((x+1)/stride.width)*wc,running,2*wc*sizeof(double));
+		}
+	}
+}
+
+template<typename T> void DenseDescriptors_<T>::addRow(const Mat& im,const int& r,DenseScratch& s) const{
+	GCFD_PROFILE_SCOPE("Dense/slidingDFT");
+	const int wr=oddWindow.height;
+	transformRow(im,r,s);
+	// The row r-wr has the same phases as the row r and is in the same slot
+	const int slot=r%wr;
+	double* old=&s.ring[2*s.rowSize*slot];
+	const double* phi=phiRows.ptr<double>(slot);
+	for(size_t k=0;k<s.rowSize;k++){
+		const double dr=s.segments[2*k]-old[2*k];
+		const double di=s.segments[2*k+1]-old[2*k+1];
+		double* g=&s.spectra[2*k*wr];
+		for(int u=0;u<wr;u++){
+			g[2*u]+=dr*phi[2*u]-di*phi[2*u+1];
+			g[2*u+1]+=dr*phi[2*u+1]+di*phi[2*u];
+		}
+		old[2*k]=s.segments[2*k];
+		old[2*k+1]=s.segments[2*k+1];
+	}
+}
+
+template<typename T> void DenseDescriptors_<T>::computeSliding(const Mat& im,Mat& features,const Range& windowRows) const{
+	const int nbParts=type==GFD1_DESCRIPTOR ? 1 : 2;
+	const int wr=oddWindow.height;
+	const int wc=oddWindow.width;
+	const int D=getDescriptorSize();
+	const int nx=features.cols/D;
+
+	DenseScratch s;
+	s.nx=nx;
+	s.rowSize=(size_t)nbParts*nx*wc;
+	s.ring.assign(2*s.rowSize*wr,0.);
+	s.spectra.assign(2*s.rowSize*wr,0.);
+	s.segments.resize(2*s.rowSize);
+	s.projected.resize(2*nbParts*im.cols);
+	s.planes.resize(4*im.cols);
+	s.running.resize(2*wc);
+	Mat par(wr,wc,CV_64FC2),orth(wr,wc,CV_64FC2);
+	AutoBuffer<double> buffer(D);
+	double* descriptor=buffer;
+
+	const int firstRow=windowRows.start*stride.height;
+	const int endRow=(windowRows.end-1)*stride.height+wr;
+	int y=windowRows.start;
+	for(int r=firstRow;r<endRow;r++){
+		addRow(im,r,s);
+		if(r<y*stride.height+wr-1)
+			continue;
+
+		// The rows of the windows of the row y of the map have all been added
+		T* out=features.ptr<T>(y);
+		for(int x=0;x<nx;x++){
+			for(int p=0;p<nbParts;p++){
+				Mat& X=p==0 ? par : orth;
+				const double* g=&s.spectra[2*((size_t)p*nx+x)*wc*wr];
+				for(int u=0;u<wr;u++){
+					double* dst=X.ptr<double>(u);
+					for(int v=0;v<wc;v++){
+						dst[2*v]=g[2*(v*wr+u)];
+						dst[2*v+1]=g[2*(v*wr+u)+1];
+					}
+				}
+			}
+			DescriptorBatch::integrate(type,*table,par,orth,descriptor);
+			for(int k=0;k<D;k++)
+				out[x*D+k]=(T)descriptor[k];
+		}
+		y++;
+	}
+}
+
+template<typename T> void DenseDescriptors_<T>::computeFFT(const Mat& im,Mat& features,const Range& windowRows) const{
+	const int D=getDescriptorSize();
+	const int nx=features.cols/D;
+	CFTPlan_<T> plan(oddWindow.height,oddWindow.width,Biv,FFT_BACKEND_AUTO,preprocessor.getConfig());
+	Mat par,orth;
+	AutoBuffer<double> buffer(D);
+	double* descriptor=buffer;
+	for(int y=windowRows.start;y<windowRows.end;y++){
+		T* out=features.ptr<T>(y);
+		for(int x=0;x<nx;x++){
+			Rect r=getWindow(x,y);
+			Mat X=im(Rect(r.x,r.y,oddWindow.width,oddWindow.height));
+			DescriptorBatch_<T>::transform(type,plan,X,par,orth);
+			DescriptorBatch_<T>::integrate(type,*table,par,orth,descriptor);
+			for(int k=0;k<D;k++)
+				out[x*D+k]=(T)descriptor[k];
+		}
+	}
+}
+
+template<typename T> Mat DenseDescriptors_<T>::compute(const Mat& im) const{
+	CV_Assert(im.channels()==1 || im.channels()==3 || im.channels()==4);
+	Size mapSize=getMapSize(im.size());
+	if(mapSize.area()==0)
+		return Mat();
+	const int D=getDescriptorSize();
+	Mat features(mapSize.height,mapSize.width*D,DataType<T>::depth);
+	// Each band of the sliding DFT starts with the rows of a whole window: use one band per
+	// thread. The bands of the per-window CFT are single rows of windows.
+	int nbBands=strategy==DENSE_SLIDING ? std::min(mapSize.height,getNumThreads()) : mapSize.height;
+	parallel_for_(Range(0,nbBands),DenseDescriptorsBody<T>(this,&im,&features,nbBands),nbBands);
+	return features;
+}
+
+template<typename T> Size DenseDescriptors_<T>::getMapSize(const Size& imageSize) const{
+	if(imageSize.width<window.width || imageSize.height<window.height)
+		return Size(0,0);
+	return Size((imageSize.width-window.width)/stride.width+1,(imageSize.height-window.height)/stride.height+1);
+}
+
+template<typename T> Rect DenseDescriptors_<T>::getWindow(const int& x,const int& y) const{
+	return Rect(x*stride.width,y*stride.height,window.width,window.height);
+}
+
+template<typename T> int DenseDescriptors_<T>::getDescriptorSize() const{
+	return DescriptorBatch::getDescriptorSize(type,oddWindow);
+}
+
+template<typename T> DenseStrategy DenseDescriptors_<T>::getStrategy() const{
+	return strategy;
+}
+
+template<typename T> DenseStrategy DenseDescriptors_<T>::chooseStrategy(const Size& window,const Size& stride){
+	const double rows=window.height-(window.height%2==0);
+	const double cols=window.width-(window.width%2==0);
+	double sliding=8.*stride.height*(1+stride.width/rows);
+	double fft=2.5*std::log(rows*cols)/std::log(2.);
+	return sliding<fft ? DENSE_SLIDING : DENSE_FFT;
+}
+
+template<typename T> DenseDescriptors_<T>::~DenseDescriptors_() {
+}
+
+template class DenseDescriptors_<float>;
+template class DenseDescriptors_<double>;
@@ -0,0 +1,190 @@
+/**
+ * \file DenseDescriptors.h
+ * \brief Descriptors of dense sliding windows over a large image
+ * \version 1.0
+ * \date October 17, 2026
+ *
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the distribution
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DENSEDESCRIPTORS_H_
+#define DENSEDESCRIPTORS_H_
+
+#include <iostream>
+#include <opencv/cv.h>
+#include <opencv/highgui.h>
+#include <vector>
+#include "DescriptorBatch.h"
+
+using namespace cv;
+
+/*!
+ *  \brief The ways DenseDescriptors_ computes the spectra of the windows
+ */
+enum DenseStrategy {
+	DENSE_AUTO,			/*!< Chosen from the size of the windows and the stride */
+	DENSE_SLIDING,		/*!< Sliding DFT: the spectra are updated from one window to the next */
+	DENSE_FFT			/*!< One CFT per window (with CFTPlan) */
+};
+
+struct DenseScratch;
+template<typename T> class DenseDescriptorsBody;
+
+/*! \class DenseDescriptors_
+   * \brief Compute the descriptors of all the windows of an image, on a regular grid
+   *
+   *  The window (x,y) of the map is the sub-image of the window size whose top left corner is
+   *  (x.stride.width,y.stride.height); its descriptor is the one given by GFD1, GCFD1 or GCFD3
+   *  on this sub-image (cropped to an odd size, as the descriptors do).
+   *
+   *  With the sliding strategy, the spectra of neighbouring windows are not recomputed: the DFT
+   *  of each row segment is updated when the window moves right (the column which leaves is
+   *  subtracted and the one which enters is added), and the 2D spectra are updated in the same
+   *  way when a row leaves and another enters. The phases are referred to the image origin
+   *  instead of the window corner, which leaves the energies (thus the descriptors) unchanged
+   *  and makes every update a sum, without accumulated rotations. A window costs
+   *  O(stride.height x rows x cols) instead of O(rows x cols x log(rows x cols)) for a CFT, so
+   *  this is the fastest for small strides; DENSE_AUTO takes the per-window CFT for the others.
+   *  The sliding sums are kept in double.
+   *
+   *  The rows of windows are computed in parallel. T is the precision of the feature map (and
+   *  of the CFTs of the per-window strategy).
+   */
+template<typename T> class DenseDescriptors_ {
+private:
+	DescriptorType type;	/*!< The descriptor of each window */
+	Mat Biv;				/*!< A color vector used to build the bivector B=Biv^e4 */
+	Size window;			/*!< The size of the windows */
+	Size oddWindow;			/*!< The size of the windows once made odd: the part which is transformed */
+	Size stride;			/*!< The step between two windows */
+	DenseStrategy strategy;	/*!< The strategy (not DENSE_AUTO) */
+	ColorPreprocessor preprocessor;	/*!< The projection of the rows on the bivector (in double, as the sliding DFT) */
+	Mat phiRows;			/*!< phiRows(r,u)=exp(-2i.pi.u.r/rows) for the odd window */
+	Mat phiCols;			/*!< phiCols(c,v)=exp(-2i.pi.v.c/cols) for the odd window */
+	Ptr<const CircleTable> table;	/*!< The discrete circles of the odd window, shared by CircleTableCache */
+
+	friend class DenseDescriptorsBody<T>;
+	/*!
+	 *  \brief Project a row of the image on the basis and compute the DFT of each of its window segments
+	 *
+	 *  \param im : The image
+	 *  \param r : The row
+	 *  \param s : The work buffers, the DFTs are written in s.segments
+	 */
+	void transformRow(const Mat& im,const int& r,DenseScratch& s) const;
+	/*!
+	 *  \brief Add a row to the spectra of the windows and remove the row which leaves them
+	 *
+	 *  \param im : The image
+	 *  \param r : The row which enters the windows (the row r-rows leaves them)
+	 *  \param s : The work buffers
+	 */
+	void addRow(const Mat& im,const int& r,DenseScratch& s) const;
+	/*!
+	 *  \brief Compute rows of the map with the sliding DFT
+	 *
+	 *  \param im : The image
+	 *  \param features : The map
+	 *  \param windowRows : The rows of the map to compute
+	 */
+	void computeSliding(const Mat& im,Mat& features,const Range& windowRows) const;
+	/*!
+	 *  \brief Compute rows of the map with one CFT per window
+	 *
+	 *  \param im : The image
+	 *  \param features : The map
+	 *  \param windowRows : The rows of the map to compute
+	 */
+	void computeFFT(const Mat& im,Mat& features,const Range& windowRows) const;
+
+public:
+	/*!
+	 *  \brief Constructor of DenseDescriptors_ class
+	 *
+	 *  \param type : The descriptor to compute
+	 *  \param Biv : A color vector used to build the bivector B=Biv^e4
+	 *  \param window : The size of the windows
+	 *  \param stride : The step between two windows, horizontally and vertically
+	 *  \param strategy : The way the spectra are computed
+	 *  \param preprocessing : The order of the channels and the scaling of the images (see ColorPreprocessor_)
+	 *
+	 */
+	DenseDescriptors_(const DescriptorType& type,const Mat& Biv,const Size& window,const Size& stride,const DenseStrategy& strategy=DENSE_AUTO,const ColorPreprocessing& preprocessing=ColorPreprocessing());
+	/*!
+	 *  \brief Compute the descriptors of all the windows of an image
+	 *
+	 *  \param im : A color image (1, 3 or 4 channels, uchar, float or double)
+	 *  \return Return the feature map: a Mat of T with one row per row of windows and the
+	 *  descriptors of the windows of the row one after the other (getMapSize(im.size()).width
+	 *  times getDescriptorSize() values). It can be seen as a map with one channel per value
+	 *  with reshape(getDescriptorSize()). It is empty if the image is smaller than a window.
+	 */
+	Mat compute(const Mat& im) const;
+	/*!
+	 *  \brief Get the size of the feature map
+	 *
+	 *  \param imageSize : The size of the image
+	 *  \return Return the number of windows horizontally and vertically
+	 */
+	Size getMapSize(const Size& imageSize) const;
+	/*!
+	 *  \brief Get the window of an element of the map
+	 *
+	 *  \param x : The column of the map
+	 *  \param y : The row of the map
+	 *  \return Return the rectangle of the window in the image
+	 */
+	Rect getWindow(const int& x,const int& y) const;
+	/*!
+	 *  \brief Get the size of a descriptor
+	 *
+	 *  \return Return the number of values of the descriptor of a window
+	 */
+	int getDescriptorSize() const;
+	/*!
+	 *  \brief Get the strategy
+	 *
+	 *  \return Return the strategy used (DENSE_SLIDING or DENSE_FFT)
+	 */
+	DenseStrategy getStrategy() const;
+	/*!
+	 *  \brief Choose the fastest strategy
+	 *
+	 *  The sliding DFT costs about 8.stride.height.(1+stride.width/rows) flops per frequency and
+	 *  window, a CFT about 2.5.log2(rows.cols): the sliding DFT is chosen when it is cheaper,
+	 *  i.e. for strides up to 2 or 3 pixels.
+	 *
+	 *  \param window : The size of the windows
+	 *  \param stride : The step between two windows
+	 *  \return Return DENSE_SLIDING or DENSE_FFT
+	 */
+	static DenseStrategy chooseStrategy(const Size& window,const Size& stride);
+
+	virtual ~DenseDescriptors_();
+};
+
+typedef DenseDescriptors_<double> DenseDescriptors;
+typedef DenseDescriptors_<float> DenseDescriptorsf;
+
+#endif /* DENSEDESCRIPTORS_H_ */
@@ -0,0 +1,221 @@
+/**
+ * \file DescriptorBatch.cpp
+ * \brief Parallel computation of the descriptors of a set of images
+ * \version 1.0
+ * \date October 17, 2026
+ *
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the distribution
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "DescriptorBatch.h"
+#include <algorithm>
+
+/*!
+ *  \brief Scratch used by one thread: the extractor is rebuilt only when the size changes
+ */
+template<typename T> struct BatchScratch {
+	Ptr<DescriptorExtractor_<T> > extractor;	/*!< The extractor of the current size */
+	DescriptorWorkspace_<T> workspace;			/*!< The plan and the spectra of the thread */
+};
+
+/*! \class DescriptorBatchBody
+   * \brief Body of the parallel loop of DescriptorBatch
+   */
+template<typename T> class DescriptorBatchBody : public ParallelLoopBody {
+private:
+	DescriptorBatch_<T>* batch;			/*!< The batch which owns the scratches */
+	const vector<Mat>* images;			/*!< The images (or null if the images are read from files) */
+	const vector<string>* paths;		/*!< The paths of the images (or null) */
+	const Mat* firstImage;				/*!< The image of index first, already read from its file (or null) */
+	int first;							/*!< The index of firstImage */
+	Mat* res;							/*!< The descriptors, one per row */
+	vector<int>* failed;				/*!< The indices of the images which have not been computed */
+	Mutex* failedMutex;					/*!< Protect failed */
+public:
+	DescriptorBatchBody(DescriptorBatch_<T>* batch,const vector<Mat>* images,const vector<string>* paths,const Mat* firstImage,const int& first,Mat* res,vector<int>* failed,Mutex* failedMutex)
+		: batch(batch), images(images), paths(paths), firstImage(firstImage), first(first), res(res), failed(failed), failedMutex(failedMutex) {
+	}
+	virtual void operator()(const Range& range) const{
+		BatchScratch<T>* s=batch->acquireScratch();
+		AutoBuffer<double> buffer(res->cols);
+		double* descriptor=buffer;
+		try{
+			for(int i=range.start;i<range.end;i++){
+				T* row=res->ptr<T>(i);
+				Mat im;
+				if(images)
+					im=(*images)[i];
+				else if(firstImage && i==first)
+					im=*firstImage;
+				else
+					im=imread((*paths)[i],1);
+				if(im.empty() || DescriptorBatch::getDescriptorSize(batch->type,im.size())!=res->cols){
+					std::fill(row,row+res->cols,(T)0);
+					AutoLock lock(*failedMutex);
+					failed->push_back(i);
+					continue;
+				}
+				batch->computeOne(im,*s,descriptor);
+				for(int k=0;k<res->cols;k++)
+					row[k]=(T)descriptor[k];
+			}
+		}
+		catch(...){
+			batch->releaseScratch(s);
+			throw;
+		}
+		batch->releaseScratch(s);
+	}
+};
+
+template<typename T> DescriptorBatch_<T>::DescriptorBatch_(const DescriptorType& type,const Mat& Biv,const FFTBackend& backend) : type(type), backend(backend) {
+	Biv.convertTo(this->Biv,CV_64F);
+}
+
+template<typename T> BatchScratch<T>* DescriptorBatch_<T>::acquireScratch(){
+	AutoLock lock(poolMutex);
+	if(pool.empty())
+		return new BatchScratch<T>();
+	BatchScratch<T>* s=pool.back();
+	pool.pop_back();
+	return s;
+}
+
+template<typename T> void DescriptorBatch_<T>::releaseScratch(BatchScratch<T>* s){
+	AutoLock lock(poolMutex);
+	pool.push_back(s);
+}
+
+template<typename T> void DescriptorBatch_<T>::computeOne(const Mat& im,BatchScratch<T>& s,double* res){
+	Mat X=CFTPlan::cropToOddSize(im);
+	DescriptorCacheKey key;
+	if(!cache.empty()){
+		key=DescriptorCache::makeKey(X,type,Biv,DataType<T>::depth);
+		if(cache->lookup(key,res,getDescriptorSize(type,X.size())))
+			return;
+	}
+	if(s.extractor.empty() || s.extractor->getSize()!=X.size())
+		s.extractor=new DescriptorExtractor_<T>(type,Biv,X.size(),backend);
+	s.extractor->extract(X,res,s.workspace);
+	if(!cache.empty())
+		cache->insert(key,res,getDescriptorSize(type,X.size()));
+}
+
+template<typename T> Mat DescriptorBatch_<T>::compute(const vector<Mat>& images){
+	if(images.empty())
+		return Mat();
+	int D=getDescriptorSize(type,images[0].size());
+	for(size_t i=1;i<images.size();i++)
+		CV_Assert(getDescriptorSize(type,images[i].size())==D);
+
+	Mat res((int)images.size(),D,DataType<T>::depth);
+	vector<int> failed;
+	Mutex failedMutex;
+	parallel_for_(Range(0,res.rows),DescriptorBatchBody<T>(this,&images,0,0,-1,&res,&failed,&failedMutex),res.rows);
+	CV_Assert(failed.empty());
+	return res;
+}
+
+template<typename T> Mat DescriptorBatch_<T>::compute(const vector<string>& paths,vector<int>* failed){
+	vector<int> notComputed;
+	// The first image which can be read gives the size and is given to the threads, so that no file is read twice
+	int D=0,first=0;
+	Mat firstImage;
+	for(;first<(int)paths.size();first++){
+		firstImage=imread(paths[first],1);
+		if(!firstImage.empty())
+			D=getDescriptorSize(type,firstImage.size());
+		if(D>0)
+			break;
+		notComputed.push_back(first);
+	}
+	Mat res((int)paths.size(),D,DataType<T>::depth);
+	if(D>0){
+		res.rowRange(0,first).setTo(Scalar::all(0));
+		Mutex failedMutex;
+		parallel_for_(Range(first,res.rows),DescriptorBatchBody<T>(this,0,&paths,&firstImage,first,&res,&notComputed,&failedMutex),res.rows-first);
+		std::sort(notComputed.begin(),notComputed.end());
+	}
+	if(failed)
+		*failed=notComputed;
+	return res;
+}
+
+template<typename T> void DescriptorBatch_<T>::setCache(const Ptr<DescriptorCache>& cache){
+	this->cache=cache;
+}
+
+template<typename T> Ptr<DescriptorCache> DescriptorBatch_<T>::getCache() const{
+	return cache;
+}
+
+template<typename T> void DescriptorBatch_<T>::transform(const DescriptorType& type,CFTPlan_<T>& plan,const Mat& X,Mat& par,Mat& orth){
+	if(!ColorPreprocessor_<T>::hasAlpha(X.channels())){
+		// The parallel part of a RGB (or gray) image is real: use the packed spectrum
+		if(type==GFD1_DESCRIPTOR)
+			plan.executePacked(X,par);
+		else
+			plan.executePacked(X,par,orth);
+		return;
+	}
+	plan.execute(X,par,orth);
+}
+
+template<typename T> void DescriptorBatch_<T>::integrate(const DescriptorType& type,const CircleTable& table,const Mat& par,const Mat& orth,double* res){
+	const bool packed=par.channels()==1;
+	switch(type){
+	case GFD1_DESCRIPTOR:
+		if(packed)
+			table.integrateCCS(par,res);
+		else
+			table.integrate(par,res);
+		break;
+	case GCFD1_DESCRIPTOR:
+		if(packed)
+			table.integrateCCS(par,res);
+		else
+			table.integrate(par,res);
+		table.integrate(orth,res+table.getNbCircles()+1);
+		break;
+	case GCFD3_DESCRIPTOR:
+		if(packed)
+			table.integrateCCS(par,orth,res);
+		else
+			table.integrate(par,orth,res);
+		break;
+	}
+}
+
+template<typename T> int DescriptorBatch_<T>::getDescriptorSize(const DescriptorType& type,const Size& size){
+	int n=std::min(size.width-(size.width%2==0),size.height-(size.height%2==0))/2+1;
+	return type==GCFD1_DESCRIPTOR ? 2*n : n;
+}
+
+template<typename T> DescriptorBatch_<T>::~DescriptorBatch_() {
+	for(size_t i=0;i<pool.size();i++)
+		delete pool[i];
+}
+
+template class DescriptorBatch_<float>;
+template class DescriptorBatch_<double>;
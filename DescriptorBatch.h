@@ -0,0 +1,181 @@
+/**
+ * \file DescriptorBatch.h
+ * \brief Parallel computation of the descriptors of a set of images
+ * \version 1.0
+ * \date October 17, 2026
+ *
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the distribution
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DESCRIPTORBATCH_H_
+#define DESCRIPTORBATCH_H_
+
+#include <iostream>
+#include <opencv/cv.h>
+#include <opencv/highgui.h>
+#include <vector>
+#include <string>
+#include "CFTPlan.h"
+#include "CircleTable.h"
+#include "DescriptorCache.h"
+#include "DescriptorExtractor.h"
+
+using namespace cv;
+
+template<typename T> struct BatchScratch;
+template<typename T> class DescriptorBatchBody;
+
+/*! \class DescriptorBatch_
+   * \brief Compute the descriptors of a set of images in parallel
+   *
+   *  The images are spread over the threads of cv::parallel_for_. Each thread takes a scratch
+   *  (a DescriptorExtractor_ and its workspace) from a pool kept by the batch, so the plans are
+   *  only rebuilt when the size of the images changes and are reused from one call to another.
+   *  The results are the same as the ones of GFD1, GCFD1 and GCFD3.
+   *
+   *  T is the precision of the spectra and of the descriptors (float or double): the float
+   *  batch (DescriptorBatchf) uses CFTPlanf and is about twice as fast as the double one.
+   *
+   *  With a DescriptorCache (see setCache), the descriptor of an image which has already been
+   *  computed with the same parameters is copied from the cache instead of being computed.
+   */
+template<typename T> class DescriptorBatch_ {
+private:
+	DescriptorType type;			/*!< The descriptor computed for each image */
+	Mat Biv;						/*!< A color vector used to build the bivector B=Biv^e4 */
+	FFTBackend backend;				/*!< The implementation of the DFTs of the plans */
+	Ptr<DescriptorCache> cache;		/*!< The cache of the descriptors (or null) */
+	vector<BatchScratch<T>*> pool;	/*!< The scratches which are not used by a thread */
+	Mutex poolMutex;				/*!< Protect the pool */
+
+	friend class DescriptorBatchBody<T>;
+	/*!
+	 *  \brief Take a scratch from the pool (or create one)
+	 *
+	 *  \return Return a scratch which is used by only one thread
+	 */
+	BatchScratch<T>* acquireScratch();
+	/*!
+	 *  \brief Give back a scratch to the pool
+	 *
+	 *  \param s : A scratch given by acquireScratch
+	 */
+	void releaseScratch(BatchScratch<T>* s);
+	/*!
+	 *  \brief Compute the descriptor of one image, or take it from the cache
+	 *
+	 *  \param im : A color image
+	 *  \param s : The scratch of the thread
+	 *  \param res : The output, it must have getDescriptorSize(type,im.size()) elements
+	 */
+	void computeOne(const Mat& im,BatchScratch<T>& s,double* res);
+
+	DescriptorBatch_(const DescriptorBatch_&);
+	DescriptorBatch_& operator=(const DescriptorBatch_&);
+
+public:
+	/*!
+	 *  \brief Constructor of DescriptorBatch_ class
+	 *
+	 *  \param type : The descriptor to compute
+	 *  \param Biv : A color vector used to build the bivector B=Biv^e4
+	 *  \param backend : The implementation of the DFTs (see BatchFFT_)
+	 *
+	 */
+	DescriptorBatch_(const DescriptorType& type,const Mat& Biv,const FFTBackend& backend=FFT_BACKEND_AUTO);
+	/*!
+	 *  \brief Compute the descriptors of a set of images
+	 *
+	 *  All the images must give descriptors of the same size, i.e. the smallest of their sizes
+	 *  (once made odd) must be the same.
+	 *
+	 *  \param images : Color images
+	 *  \return Return a Mat of T with one descriptor per row
+	 */
+	Mat compute(const vector<Mat>& images);
+	/*!
+	 *  \brief Compute the descriptors of a set of image files
+	 *
+	 *  The images are read by the threads. The size of the descriptors is given by the first
+	 *  image which can be read. The rows of the images which cannot be read or which give
+	 *  descriptors of another size are set to 0.
+	 *
+	 *  \param paths : The paths of color images
+	 *  \param failed : If not null, receives the (sorted) indices of the images which have not been computed
+	 *  \return Return a Mat of T with one descriptor per row
+	 */
+	Mat compute(const vector<string>& paths,vector<int>* failed=0);
+	/*!
+	 *  \brief Use a cache of the descriptors
+	 *
+	 *  The cache can be shared by several batches and extractors, the parameters of each one
+	 *  are part of the keys.
+	 *
+	 *  \param cache : A cache (or null to compute all the descriptors)
+	 */
+	void setCache(const Ptr<DescriptorCache>& cache);
+	/*!
+	 *  \brief Get the cache of the descriptors
+	 *
+	 *  \return Return the cache given to setCache (or null)
+	 */
+	Ptr<DescriptorCache> getCache() const;
+	/*!
+	 *  \brief Get the size of a descriptor
+	 *
+	 *  \param type : A descriptor
+	 *  \param size : The size of the image
+	 *  \return Return the number of values of the descriptor of an image of this size
+	 */
+	static int getDescriptorSize(const DescriptorType& type,const Size& size);
+	/*!
+	 *  \brief Compute the spectra needed by a descriptor
+	 *
+	 *  The parallel part of a 3 channel image is given as a packed spectrum (see RealFFT2).
+	 *
+	 *  \param type : A descriptor
+	 *  \param plan : A plan of the size of X
+	 *  \param X : A color image of odd size
+	 *  \param par : The output, the parallel part of the CFT
+	 *  \param orth : The output, the orthogonal part of the CFT (not computed for GFD1 on a 3 channel image)
+	 */
+	static void transform(const DescriptorType& type,CFTPlan_<T>& plan,const Mat& X,Mat& par,Mat& orth);
+	/*!
+	 *  \brief Integrate the spectra given by transform on the discrete circles
+	 *
+	 *  \param type : A descriptor
+	 *  \param table : A table of the size of the cropped spectra
+	 *  \param par : The parallel part of the CFT (packed if it has one channel)
+	 *  \param orth : The orthogonal part of the CFT
+	 *  \param res : The output, it must have getDescriptorSize(type,par.size()) elements
+	 */
+	static void integrate(const DescriptorType& type,const CircleTable& table,const Mat& par,const Mat& orth,double* res);
+
+	virtual ~DescriptorBatch_();
+};
+
+typedef DescriptorBatch_<double> DescriptorBatch;
+typedef DescriptorBatch_<float> DescriptorBatchf;
+
+#endif /* DESCRIPTORBATCH_H_ */
@@ -0,0 +1,313 @@
+/**
+ * \file DescriptorCache.cpp
+ * \brief Cache of the descriptors keyed by the content of the images
+ * \version 1.0
+ * \date October 17, 2026
+ *
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the distribution
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "DescriptorCache.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <cstring>
+#include <cstdio>
+#include <sys/stat.h>
+
+static const uint64 PRIME1=CV_BIG_UINT(0x9E3779B185EBCA87);
+static const uint64 PRIME2=CV_BIG_UINT(0xC2B2AE3D27D4EB4F);
+static const uint64 PRIME3=CV_BIG_UINT(0x165667B19E3779F9);
+static const uint64 PRIME4=CV_BIG_UINT(0x85EBCA77C2B2AE63);
+static const uint64 PRIME5=CV_BIG_UINT(0x27D4EB2F165667C5);
+static const uint64 DISK_MAGIC=CV_BIG_UINT(0x4743464443410001);	/*!< "GCFDCA" and the version of the file of the disk tier */
+static const int SLOT_HEADER=3;										/*!< Words before the values of a slot: content, params and size */
+
+static inline uint64 rotl(const uint64& x,const int& r){
+	return (x<<r) | (x>>(64-r));
+}
+
+static inline uint64 hashRound(uint64 acc,const uint64& input){
+	acc+=input*PRIME2;
+	acc=rotl(acc,31);
+	return acc*PRIME1;
+}
+
+static inline uint64 readWord(const uchar* p){
+	uint64 w;
+	memcpy(&w,p,sizeof(w));
+	return w;
+}
+
+/*!
+ *  \brief Hash of a stream of bytes given by pieces (e.g. the rows of an image), as xxHash64
+ */
+struct ContentHasher {
+	uint64 v[4];			/*!< The four lanes */
+	uchar tail[32];			/*!< The bytes which do not fill a stripe yet */
+	int tailSize;			/*!< Number of bytes in tail */
+	uint64 total;			/*!< Number of bytes hashed */
+	uint64 seed;			/*!< The seed of the lanes */
+
+	ContentHasher(const uint64& seed) : tailSize(0), total(0), seed(seed) {
+		v[0]=seed+PRIME1+PRIME2;
+		v[1]=seed+PRIME2;
+		v[2]=seed;
+		v[3]=seed-PRIME1;
+	}
+	void stripe(const uchar* p){
+		v[0]=hashRound(v[0],readWord(p));
+		v[1]=hashRound(v[1],readWord(p+8));
+		v[2]=hashRound(v[2],readWord(p+16));
+		v[3]=hashRound(v[3],readWord(p+24));
+	}
+	void update(const uchar* p,size_t n){
+		total+=n;
+		if(tailSize>0){
+			size_t k=std::min(n,(size_t)(32-tailSize));
+			memcpy(tail+tailSize,p,k);
+			tailSize+=(int)k;
+			p+=k;
+			n-=k;
+			if(tailSize<32)
+				return;
+			stripe(tail);
+			tailSize=0;
+		}
+		for(;n>=32;p+=32,n-=32)
+			stripe(p);
+		memcpy(tail,p,n);
+		tailSize=(int)n;
+	}
+	uint64 digest() const{
+		uint64 h;
+		if(total>=32){
+			h=rotl(v[0],1)+rotl(v[1],7)+rotl(v[2],12)+rotl(v[3],18);
+			for(int k=0;k<4;k++){
+				h^=hashRound(0,v[k]);
+				h=h*PRIME1+PRIME4;
+			}
+		}
+		else
+			h=seed+PRIME5;
+		h+=total;
+		int i=0;
+		for(;i+8<=tailSize;i+=8){
+			h^=hashRound(0,readWord(tail+i));
+			h=rotl(h,27)*PRIME1+PRIME4;
+		}
+		for(;i<tailSize;i++){
+			h^=tail[i]*PRIME5;
+			h=rotl(h,11)*PRIME1;
+		}
+		h^=h>>33;
+		h*=PRIME2;
+		h^=h>>29;
+		h*=PRIME3;
+		h^=h>>32;
+		return h;
+	}
+};
+
+DescriptorCacheKey::DescriptorCacheKey() : content(0), params(0), imageBytes(0) {
+}
+
+bool DescriptorCacheKey::operator<(const DescriptorCacheKey& k) const{
+	return content<k.content || (content==k.content && params<k.params);
+}
+
+bool DescriptorCacheKey::operator==(const DescriptorCacheKey& k) const{
+	return content==k.content && params==k.params;
+}
+
+DescriptorCacheConfig::DescriptorCacheConfig() : maxMemory(64<<20), diskSlots(16384), diskValues(256) {
+}
+
+DescriptorCache::DescriptorCache(const DescriptorCacheConfig& config) : config(config) {
+	resetStats();
+	stats.entries=0;
+	stats.bytes=0;
+	stats.maxBytes=config.maxMemory;
+	if(!config.diskPath.empty())
+		openDisk();
+}
+
+void DescriptorCache::openDisk(){
+	CV_Assert(config.diskSlots>0 && config.diskValues>0);
+	const int rows=config.diskSlots+1,cols=SLOT_HEADER+config.diskValues;
+	struct stat st;
+	if(stat(config.diskPath.c_str(),&st)==0 && (size_t)st.st_size==(size_t)rows*cols*sizeof(double)){
+		disk.open(config.diskPath,rows,cols,CV_64F,0,true);
+		const double* header=disk.getMat().ptr<double>(0);
+		if(readWord((const uchar*)header)==DISK_MAGIC && header[1]==config.diskSlots && header[2]==config.diskValues)
+			return;
+		disk.close();
+	}
+
+	// A missing file or a file of another configuration: recreate it, the slots are then zero
+	// (i.e. empty) and the file stays sparse until they are written
+	remove(config.diskPath.c_str());
+	disk.create(config.diskPath,rows,cols,CV_64F);
+	double* header=disk.getMat().ptr<double>(0);
+	memcpy(header,&DISK_MAGIC,sizeof(DISK_MAGIC));
+	header[1]=config.diskSlots;
+	header[2]=config.diskValues;
+}
+
+uchar* DescriptorCache::getSlot(const DescriptorCacheKey& key) const{
+	return disk.getMat().ptr(1+(int)((key.content^key.params)%(uint64)config.diskSlots));
+}
+
+void DescriptorCache::insertMemory(const DescriptorCacheKey& key,const double* values,const int& size){
+	std::map<DescriptorCacheKey,Entry>::iterator it=entries.find(key);
+	if(it!=entries.end()){
+		uses.splice(uses.begin(),uses,it->second.use);
+		return;
+	}
+	Entry& entry=entries[key];
+	entry.values.assign(values,values+size);
+	entry.use=uses.insert(uses.begin(),key);
+	stats.bytes+=size*sizeof(double)+sizeof(DescriptorCacheKey);
+	while(stats.bytes>stats.maxBytes && uses.size()>1){
+		it=entries.find(uses.back());
+		stats.bytes-=it->second.values.size()*sizeof(double)+sizeof(DescriptorCacheKey);
+		stats.evictions++;
+		entries.erase(it);
+		uses.pop_back();
+	}
+	stats.entries=(int)entries.size();
+}
+
+bool DescriptorCache::lookup(const DescriptorCacheKey& key,double* res,const int& size){
+	AutoLock lock(mutex);
+	std::map<DescriptorCacheKey,Entry>::iterator it=entries.find(key);
+	if(it!=entries.end() && (int)it->second.values.size()==size){
+		uses.splice(uses.begin(),uses,it->second.use);
+		std::copy(it->second.values.begin(),it->second.values.end(),res);
+		stats.hits++;
+		stats.bytesSaved+=key.imageBytes;
+		return true;
+	}
+	if(!disk.getMat().empty() && size<=config.diskValues){
+		const uchar* slot=getSlot(key);
+		const double* values=(const double*)slot+SLOT_HEADER;
+		if(readWord(slot)==key.content && readWord(slot+8)==key.params && ((const double*)slot)[2]==size){
+			std::copy(values,values+size,res);
+			insertMemory(key,values,size);
+			stats.diskHits++;
+			stats.bytesSaved+=key.imageBytes;
+			return true;
+		}
+	}
+	stats.misses++;
+	return false;
+}
+
+void DescriptorCache::insert(const DescriptorCacheKey& key,const double* values,const int& size){
+	AutoLock lock(mutex);
+	insertMemory(key,values,size);
+	stats.insertions++;
+	if(disk.getMat().empty() || size>config.diskValues)
+		return;
+
+	// The size is cleared before the values are written and the key after them, so a slot
+	// left half written by a stopped process is never matched
+	uchar* slot=getSlot(key);
+	double* header=(double*)slot;
+	header[2]=0;
+	std::copy(values,values+size,header+SLOT_HEADER);
+	memcpy(slot,&key.content,sizeof(uint64));
+	memcpy(slot+8,&key.params,sizeof(uint64));
+	header[2]=size;
+}
+
+void DescriptorCache::flush(){
+	AutoLock lock(mutex);
+	disk.flush();
+}
+
+void DescriptorCache::clear(){
+	AutoLock lock(mutex);
+	entries.clear();
+	uses.clear();
+	stats.entries=0;
+	stats.bytes=0;
+}
+
+DescriptorCacheStats DescriptorCache::getStats(){
+	AutoLock lock(mutex);
+	long long found=stats.hits+stats.diskHits;
+	stats.hitRate=found+stats.misses>0 ? (double)found/(found+stats.misses) : 0;
+	return stats;
+}
+
+void DescriptorCache::resetStats(){
+	AutoLock lock(mutex);
+	stats.hits=0;
+	stats.diskHits=0;
+	stats.misses=0;
+	stats.insertions=0;
+	stats.evictions=0;
+	stats.hitRate=0;
+	stats.bytesSaved=0;
+}
+
+DescriptorCacheKey DescriptorCache::makeKey(const Mat& im,const DescriptorType& type,const Mat& Biv,const int& depth,const ColorPreprocessing& preprocessing){
+	DescriptorCacheKey key;
+	key.content=hashImage(im);
+	key.imageBytes=im.total()*im.elemSize();
+
+	Mat vec;
+	Biv.convertTo(vec,CV_64F);
+	vector<double> params;
+	params.push_back(type);
+	params.push_back(depth);
+	params.push_back(im.rows);
+	params.push_back(im.cols);
+	params.push_back(im.type());
+	params.push_back(preprocessing.order);
+	params.push_back(preprocessing.range);
+	for(int i=0;i<vec.rows;i++)
+		for(int j=0;j<vec.cols;j++)
+			params.push_back(vec.at<double>(i,j));
+	ContentHasher hasher(PRIME3);
+	hasher.update((const uchar*)&params[0],params.size()*sizeof(double));
+	key.params=hasher.digest();
+	return key;
+}
+
+uint64 DescriptorCache::hashImage(const Mat& im){
+	GCFD_PROFILE_SCOPE("Cache/hash");
+	ContentHasher hasher(0);
+	const size_t rowBytes=im.cols*im.elemSize();
+	if(im.isContinuous())
+		hasher.update(im.data,rowBytes*im.rows);
+	else
+		for(int i=0;i<im.rows;i++)
+			hasher.update(im.ptr(i),rowBytes);
+	return hasher.digest();
+}
+
+DescriptorCache::~DescriptorCache() {
+	disk.flush();
+}
@@ -0,0 +1,214 @@
+/**
+ * \file DescriptorCache.h
+ * \brief Cache of the descriptors keyed by the content of the images
+ * \version 1.0
+ * \date October 17, 2026
+ *
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the distribution
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DESCRIPTORCACHE_H_
+#define DESCRIPTORCACHE_H_
+
+#include <iostream>
+#include <opencv/cv.h>
+#include <opencv/highgui.h>
+#include <vector>
+#include <list>
+#include <map>
+#include "DescriptorExtractor.h"
+#include "MappedMat.h"
+
+using namespace cv;
+
+/*!
+ *  \brief The key of a descriptor in a DescriptorCache
+ */
+struct DescriptorCacheKey {
+	uint64 content;			/*!< Hash of the pixels of the image */
+	uint64 params;			/*!< Hash of the parameters: descriptor, color vector, preprocessing, precision, size and type of the image */
+	size_t imageBytes;		/*!< Size of the pixels of the image (not part of the key, counted in bytesSaved) */
+	DescriptorCacheKey();
+	bool operator<(const DescriptorCacheKey& k) const;
+	bool operator==(const DescriptorCacheKey& k) const;
+};
+
+/*!
+ *  \brief Counters of a descriptor cache
+ */
+struct DescriptorCacheStats {
+	long long hits;			/*!< Number of lookups served by the memory tier */
+	long long diskHits;		/*!< Number of lookups served by the disk tier */
+	long long misses;		/*!< Number of lookups which have not found the descriptor */
+	long long insertions;	/*!< Number of descriptors added */
+	long long evictions;	/*!< Number of descriptors removed from the memory tier to respect its limit */
+	double hitRate;			/*!< (hits+diskHits)/(hits+diskHits+misses), 0 before the first lookup */
+	double bytesSaved;		/*!< Bytes of pixels of the images whose descriptor has been found, i.e. which have not been transformed */
+	int entries;			/*!< Number of descriptors in the memory tier */
+	size_t bytes;			/*!< Memory used by the memory tier */
+	size_t maxBytes;		/*!< Memory limit of the memory tier */
+};
+
+/*! \struct DescriptorCacheConfig
+   * \brief Parameters of a DescriptorCache
+   */
+struct DescriptorCacheConfig {
+	size_t maxMemory;		/*!< Memory limit of the memory tier (in bytes) */
+	string diskPath;		/*!< File of the disk tier, kept from one run to another (no disk tier if empty) */
+	int diskSlots;			/*!< Number of descriptors of the disk tier */
+	int diskValues;			/*!< Largest descriptor kept by the disk tier (number of values) */
+	/*!
+	 *  \brief Constructor of DescriptorCacheConfig
+	 *
+	 *  64 MB of memory tier and no disk tier; when a path is given, 16384 descriptors of at
+	 *  most 256 values (about 34 MB of file).
+	 */
+	DescriptorCacheConfig();
+};
+
+/*! \class DescriptorCache
+   * \brief Content-addressed cache of the descriptors, shared by the threads of the extractions
+   *
+   *  The descriptor of an image depends only on its pixels and on the parameters of the
+   *  extraction, so duplicated images (re-uploads, regenerated thumbnails, repeated frames) are
+   *  found by a 64-bit hash of their pixels, computed at several GB/s, and the parameters are
+   *  part of the key. DescriptorBatch_ and StreamingExtractor_ look up each image before its CFT
+   *  when they are given a cache, and add the descriptors they compute.
+   *
+   *  The memory tier keeps the least recently used descriptors within a memory limit. The
+   *  optional disk tier is a memory mapped file of fixed slots, the slot of a descriptor being
+   *  given by its key (a new descriptor replaces the one of its slot): it is written through by
+   *  insert(), survives the process and is paged by the system. Its hits are copied in the
+   *  memory tier. The descriptors are stored in double, whatever the precision of the extraction
+   *  (which is part of the key).
+   */
+class DescriptorCache {
+private:
+	/*!
+	 *  \brief A descriptor of the memory tier and its position in the LRU list
+	 */
+	struct Entry {
+		vector<double> values;								/*!< The descriptor */
+		std::list<DescriptorCacheKey>::iterator use;		/*!< Position of the key in the LRU list */
+	};
+
+	DescriptorCacheConfig config;							/*!< The limits and the file of the disk tier */
+	std::map<DescriptorCacheKey,Entry> entries;				/*!< The memory tier */
+	std::list<DescriptorCacheKey> uses;						/*!< The keys from the most to the least recently used */
+	MappedMat disk;											/*!< The disk tier: a header row, then one row per slot */
+	DescriptorCacheStats stats;								/*!< The counters */
+	Mutex mutex;											/*!< Protect all the members */
+
+	/*!
+	 *  \brief Open the file of the disk tier, it is recreated if it does not match the configuration
+	 */
+	void openDisk();
+	/*!
+	 *  \brief Add a descriptor to the memory tier, the mutex must be locked
+	 *
+	 *  \param key : The key of the descriptor
+	 *  \param values : The descriptor
+	 *  \param size : The number of values
+	 */
+	void insertMemory(const DescriptorCacheKey& key,const double* values,const int& size);
+	/*!
+	 *  \brief Get the slot of a key in the disk tier
+	 *
+	 *  \param key : The key of a descriptor
+	 *  \return Return a pointer on the row of the slot (3 words of key and size, then the values)
+	 */
+	uchar* getSlot(const DescriptorCacheKey& key) const;
+
+	DescriptorCache(const DescriptorCache&);
+	DescriptorCache& operator=(const DescriptorCache&);
+
+public:
+	/*!
+	 *  \brief Constructor of DescriptorCache class
+	 *
+	 *  \param config : The limits and the file of the disk tier
+	 *
+	 */
+	DescriptorCache(const DescriptorCacheConfig& config=DescriptorCacheConfig());
+	/*!
+	 *  \brief Look for a descriptor, in memory then on disk
+	 *
+	 *  \param key : The key of the image (see makeKey)
+	 *  \param res : The output, the descriptor if it has been found
+	 *  \param size : The number of values of the descriptor
+	 *  \return Return true if the descriptor has been found
+	 */
+	bool lookup(const DescriptorCacheKey& key,double* res,const int& size);
+	/*!
+	 *  \brief Add a descriptor, to the memory tier and to the disk tier
+	 *
+	 *  \param key : The key of the image (see makeKey)
+	 *  \param values : The descriptor
+	 *  \param size : The number of values of the descriptor
+	 */
+	void insert(const DescriptorCacheKey& key,const double* values,const int& size);
+	/*!
+	 *  \brief Write the modified pages of the disk tier in its file
+	 */
+	void flush();
+	/*!
+	 *  \brief Remove all the descriptors of the memory tier (the disk tier is kept)
+	 */
+	void clear();
+	/*!
+	 *  \brief Get the counters of the cache
+	 *
+	 *  \return Return the counters
+	 */
+	DescriptorCacheStats getStats();
+	/*!
+	 *  \brief Reset the counters of lookups, insertions, evictions and bytes saved
+	 */
+	void resetStats();
+	/*!
+	 *  \brief Compute the key of an image for an extraction
+	 *
+	 *  \param im : The image given to the CFT (e.g. once cropped to an odd size)
+	 *  \param type : The descriptor
+	 *  \param Biv : The color vector used to build the bivector B=Biv^e4
+	 *  \param depth : The precision of the extraction (CV_32F or CV_64F)
+	 *  \param preprocessing : The conversion of the image to the CFT parts
+	 *  \return Return the key
+	 */
+	static DescriptorCacheKey makeKey(const Mat& im,const DescriptorType& type,const Mat& Biv,const int& depth,const ColorPreprocessing& preprocessing=ColorPreprocessing());
+	/*!
+	 *  \brief Hash the pixels of an image
+	 *
+	 *  The rows are hashed as if the image were continuous, 32 bytes at a time with four
+	 *  independent lanes of multiply and rotate (as xxHash64).
+	 *
+	 *  \param im : An image
+	 *  \return Return a 64-bit hash of the pixels (the size and the type are not included)
+	 */
+	static uint64 hashImage(const Mat& im);
+
+	virtual ~DescriptorCache();
+};
+
+#endif /* DESCRIPTORCACHE_H_ */
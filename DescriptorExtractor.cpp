@@ -0,0 +1,134 @@
+/**
+ * \file DescriptorExtractor.cpp
+ * \brief Reusable computation of the descriptors of the images of one size
+ * \version 1.0
+ * \date October 17, 2026
+ *
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the distribution
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "DescriptorExtractor.h"
+#include "DescriptorBatch.h"
+#include "CircleTableCache.h"
+#include "FixedSizeKernel.h"
+#include "Profiler.h"
+
+const char* const descriptorStages[]={"GFD1/computeFeatures","GCFD1/computeFeatures","GCFD3/computeFeatures"};
+
+/*! The last identifier given to an extractor */
+static int lastOwnerId=0;
+
+template<typename T> DescriptorWorkspace_<T>::DescriptorWorkspace_() : ownerId(0) {
+}
+
+template<typename T> void DescriptorWorkspace_<T>::preparePlan(const int& id,const Size& size,const Mat& Biv,const FFTBackend& backend,const ColorPreprocessing& preprocessing){
+	if(ownerId==id)
+		return;
+	// The workspace comes from another extractor: its plan is kept if it has the same size, color vector and preprocessing
+	if(!plan.matches(size,Biv,preprocessing)){
+		GCFD_PROFILE_SCOPE("Descriptors/buildPlan");
+		plan=CFTPlan_<T>(size.height,size.width,Biv,backend,preprocessing);
+	}
+	ownerId=id;
+}
+
+template<typename T> int DescriptorWorkspace_<T>::newOwnerId(){
+	return CV_XADD(&lastOwnerId,1)+1;
+}
+
+template<typename T> DescriptorWorkspace_<T>::~DescriptorWorkspace_() {
+}
+
+template<typename T> DescriptorExtractor_<T>::DescriptorExtractor_(const DescriptorType& type,const Mat& Biv,const Size& size,const FFTBackend& backend,const ColorPreprocessing& preprocessing)
+	: type(type), size(size.width-(size.width%2==0),size.height-(size.height%2==0)), backend(backend), preprocessing(preprocessing) {
+	CV_Assert(this->size.width>0 && this->size.height>0);
+	Biv.convertTo(this->Biv,CV_64F);
+	table=CircleTableCache::get(this->size);
+	kernel=FixedSizeKernelBase_<T>::create(*table);
+	id=DescriptorWorkspace_<T>::newOwnerId();
+}
+
+template<typename T> DescriptorWorkspace_<T>* DescriptorExtractor_<T>::acquireWorkspace() const{
+	AutoLock lock(poolMutex);
+	if(pool.empty())
+		return new DescriptorWorkspace_<T>();
+	DescriptorWorkspace_<T>* workspace=pool.back();
+	pool.pop_back();
+	return workspace;
+}
+
+template<typename T> void DescriptorExtractor_<T>::releaseWorkspace(DescriptorWorkspace_<T>* workspace) const{
+	AutoLock lock(poolMutex);
+	pool.push_back(workspace);
+}
+
+template<typename T> void DescriptorExtractor_<T>::extract(const Mat& im,double* res,DescriptorWorkspace_<T>& workspace) const{
+	GCFD_PROFILE_SCOPE(descriptorStages[type]);
+	Mat X=CFTPlan::cropToOddSize(im);
+	CV_Assert(X.size()==size);
+	workspace.preparePlan(id,size,Biv,backend,preprocessing);
+	DescriptorBatch_<T>::transform(type,workspace.plan,X,workspace.par,workspace.orth);
+	if(kernel.empty())
+		DescriptorBatch_<T>::integrate(type,*table,workspace.par,workspace.orth,res);
+	else
+		kernel->integrate(type,workspace.par,workspace.orth,res);
+}
+
+template<typename T> void DescriptorExtractor_<T>::extract(const Mat& im,double* res) const{
+	DescriptorWorkspace_<T>* workspace=acquireWorkspace();
+	try{
+		extract(im,res,*workspace);
+	}
+	catch(...){
+		releaseWorkspace(workspace);
+		throw;
+	}
+	releaseWorkspace(workspace);
+}
+
+template<typename T> int DescriptorExtractor_<T>::getDescriptorSize() const{
+	return DescriptorBatch_<T>::getDescriptorSize(type,size);
+}
+
+template<typename T> Size DescriptorExtractor_<T>::getSize() const{
+	return size;
+}
+
+template<typename T> DescriptorType DescriptorExtractor_<T>::getType() const{
+	return type;
+}
+
+template<typename T> Mat DescriptorExtractor_<T>::getVec() const{
+	return Biv.clone();
+}
+
+template<typename T> DescriptorExtractor_<T>::~DescriptorExtractor_() {
+	for(size_t i=0;i<pool.size();i++)
+		delete pool[i];
+}
+
+template class DescriptorWorkspace_<float>;
+template class DescriptorWorkspace_<double>;
+template class DescriptorExtractor_<float>;
+template class DescriptorExtractor_<double>;
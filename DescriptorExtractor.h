@@ -0,0 +1,200 @@
+/**
+ * \file DescriptorExtractor.h
+ * \brief Reusable computation of the descriptors of the images of one size
+ * \version 1.0
+ * \date October 17, 2026
+ *
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the distribution
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DESCRIPTOREXTRACTOR_H_
+#define DESCRIPTOREXTRACTOR_H_
+
+#include <iostream>
+#include <opencv/cv.h>
+#include <opencv/highgui.h>
+#include <vector>
+#include "CFTPlan.h"
+#include "CircleTable.h"
+
+using namespace cv;
+
+/*!
+ *  \brief The descriptors which can be computed by DescriptorExtractor_ and DescriptorBatch_
+ */
+enum DescriptorType {
+	GFD1_DESCRIPTOR,		/*!< See GFD1 */
+	GCFD1_DESCRIPTOR,		/*!< See GCFD1 */
+	GCFD3_DESCRIPTOR		/*!< See GCFD3 */
+};
+
+/*! The profiling stage of the extraction of each DescriptorType (see Profiler) */
+extern const char* const descriptorStages[];
+
+template<typename T> class DescriptorExtractor_;
+template<typename T> class FixedSizeKernelBase_;
+template<typename T> class MultiScaleDescriptors_;
+
+/*! \class DescriptorWorkspace_
+   * \brief Work buffers of a DescriptorExtractor_ or of a MultiScaleDescriptors_, used by one thread at a time
+   *
+   *  The workspace holds the CFT plan and the spectra. The plan is built by the first
+   *  extraction and rebuilt only when the workspace is given to an extractor of another size,
+   *  so once warm an extraction does not allocate anything.
+   */
+template<typename T> class DescriptorWorkspace_ {
+private:
+	CFTPlan_<T> plan;	/*!< The CFT plan of the last extractor */
+	Mat par;			/*!< The parallel part of the CFT */
+	Mat orth;			/*!< The orthogonal part of the CFT */
+	int ownerId;		/*!< The identifier of the extractor for which the plan has been checked (0 if none) */
+
+	friend class DescriptorExtractor_<T>;
+	friend class MultiScaleDescriptors_<T>;
+	/*!
+	 *  \brief Check the plan when the workspace is used by another extractor, and rebuild it if needed
+	 *
+	 *  \param id : The identifier of the extractor (see newOwnerId)
+	 *  \param size : The size of the images of the extractor, once made odd
+	 *  \param Biv : The color vector of the extractor
+	 *  \param backend : The implementation of the DFTs of the extractor
+	 *  \param preprocessing : The preprocessing of the images of the extractor
+	 */
+	void preparePlan(const int& id,const Size& size,const Mat& Biv,const FFTBackend& backend,const ColorPreprocessing& preprocessing=ColorPreprocessing());
+	/*!
+	 *  \brief Give an identifier to a new extractor
+	 *
+	 *  \return Return a number which has not been given before
+	 */
+	static int newOwnerId();
+
+public:
+	DescriptorWorkspace_();
+	virtual ~DescriptorWorkspace_();
+};
+
+/*! \class DescriptorExtractor_
+   * \brief Compute a descriptor of the images of one size into memory given by the caller
+   *
+   *  The extractor holds only what is shared by all the images: the descriptor, the color
+   *  vector and the circle table of the size (taken from CircleTableCache), integrated by a
+   *  FixedSizeKernel_ for the usual sizes (64, 127, 128 and 256 pixels). It is never
+   *  modified by extract(), so one extractor can be used by any number of threads, each one
+   *  with its own DescriptorWorkspace_. Unlike GFD1, GCFD1 and GCFD3, nothing is built per
+   *  image: the descriptor is written in the array given by the caller.
+   *
+   *  T is the precision of the spectra (float or double), see CFTPlan_.
+   */
+template<typename T> class DescriptorExtractor_ {
+private:
+	DescriptorType type;						/*!< The descriptor */
+	Mat Biv;									/*!< A color vector used to build the bivector B=Biv^e4 */
+	Size size;									/*!< The size of the images once made odd */
+	FFTBackend backend;							/*!< The implementation of the DFTs of the plans */
+	ColorPreprocessing preprocessing;			/*!< The order of the channels and the scaling of the images */
+	Ptr<const CircleTable> table;				/*!< The discrete circles of the size */
+	Ptr<FixedSizeKernelBase_<T> > kernel;		/*!< The integration compiled for the size (or empty) */
+	int id;										/*!< A number which identifies the extractor in the workspaces */
+	mutable vector<DescriptorWorkspace_<T>*> pool;	/*!< The workspaces of extract(im,res) which are not used by a thread */
+	mutable Mutex poolMutex;					/*!< Protect the pool */
+
+	/*!
+	 *  \brief Take a workspace from the pool (or create one)
+	 *
+	 *  \return Return a workspace which is used by only one thread
+	 */
+	DescriptorWorkspace_<T>* acquireWorkspace() const;
+	/*!
+	 *  \brief Give back a workspace to the pool
+	 *
+	 *  \param workspace : A workspace given by acquireWorkspace
+	 */
+	void releaseWorkspace(DescriptorWorkspace_<T>* workspace) const;
+
+	DescriptorExtractor_(const DescriptorExtractor_&);
+	DescriptorExtractor_& operator=(const DescriptorExtractor_&);
+
+public:
+	/*!
+	 *  \brief Constructor of DescriptorExtractor_ class
+	 *
+	 *  \param type : The descriptor to compute
+	 *  \param Biv : A color vector used to build the bivector B=Biv^e4
+	 *  \param size : The size of the images (the images of the same size once made odd are also accepted)
+	 *  \param backend : The implementation of the DFTs (see BatchFFT_)
+	 *  \param preprocessing : The order of the channels and the scaling of the images (see ColorPreprocessor_)
+	 *
+	 */
+	DescriptorExtractor_(const DescriptorType& type,const Mat& Biv,const Size& size,const FFTBackend& backend=FFT_BACKEND_AUTO,const ColorPreprocessing& preprocessing=ColorPreprocessing());
+	/*!
+	 *  \brief Compute the descriptor of an image with the workspace of the caller
+	 *
+	 *  \param im : A color image (1, 3 or 4 channels, uchar, float or double)
+	 *  \param res : The output, it must have getDescriptorSize() elements
+	 *  \param workspace : A workspace used by no other thread during the call
+	 */
+	void extract(const Mat& im,double* res,DescriptorWorkspace_<T>& workspace) const;
+	/*!
+	 *  \brief Compute the descriptor of an image with a workspace of the extractor
+	 *
+	 *  The workspaces are kept by the extractor, one per thread which has called it at the same time.
+	 *
+	 *  \param im : A color image (1, 3 or 4 channels, uchar, float or double)
+	 *  \param res : The output, it must have getDescriptorSize() elements
+	 */
+	void extract(const Mat& im,double* res) const;
+	/*!
+	 *  \brief Get the number of values of a descriptor
+	 *
+	 *  \return Return the number of values written by extract()
+	 */
+	int getDescriptorSize() const;
+	/*!
+	 *  \brief Get the size of the images once made odd
+	 *
+	 *  \return Return the size of the images handled by the extractor
+	 */
+	Size getSize() const;
+	/*!
+	 *  \brief Get the descriptor
+	 *
+	 *  \return Return the descriptor computed by the extractor
+	 */
+	DescriptorType getType() const;
+	/*!
+	 *  \brief Get the color vector
+	 *
+	 *  \return Return a copy of the color vector used to build the bivector
+	 */
+	Mat getVec() const;
+
+	virtual ~DescriptorExtractor_();
+};
+
+typedef DescriptorWorkspace_<double> DescriptorWorkspace;
+typedef DescriptorWorkspace_<float> DescriptorWorkspacef;
+typedef DescriptorExtractor_<double> DescriptorExtractor;
+typedef DescriptorExtractor_<float> DescriptorExtractorf;
+
+#endif /* DESCRIPTOREXTRACTOR_H_ */
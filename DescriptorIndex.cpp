@@ -0,0 +1,244 @@
+/**
+ * \file DescriptorIndex.cpp
+ * \brief Nearest neighbour search among descriptors
+ * \version 1.0
+ * \date October 17, 2026
+ *
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the distribution
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "DescriptorIndex.h"
+#include "SimdTools.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <queue>
+
+/*! \class DescriptorIndexBody
+   * \brief Body of the parallel loop of DescriptorIndex::knnSearch, one query per iteration
+   */
+class DescriptorIndexBody : public ParallelLoopBody {
+private:
+	const DescriptorIndex* index;		/*!< The index */
+	const Mat* queries;					/*!< The prepared queries */
+	vector<vector<DMatch> >* matches;	/*!< The output */
+	int k;								/*!< The number of neighbours */
+	int nprobe;							/*!< The number of clusters to visit */
+public:
+	DescriptorIndexBody(const DescriptorIndex* index,const Mat* queries,vector<vector<DMatch> >* matches,const int& k,const int& nprobe)
+		: index(index), queries(queries), matches(matches), k(k), nprobe(nprobe) {
+	}
+	virtual void operator()(const Range& range) const{
+		for(int i=range.start;i<range.end;i++){
+			vector<DMatch>& m=(*matches)[i];
+			index->searchOne(queries->ptr<float>(i),k,nprobe,m);
+			for(size_t j=0;j<m.size();j++)
+				m[j].queryIdx=i;
+		}
+	}
+};
+
+/*! \class IndexAssignBody
+   * \brief Body of the parallel loop which finds the nearest centroid of each descriptor
+   */
+class IndexAssignBody : public ParallelLoopBody {
+private:
+	const Mat* data;			/*!< The descriptors */
+	const Mat* centroids;		/*!< The centroids */
+	int start;					/*!< The first row to assign */
+	vector<int>* labels;		/*!< The output, the nearest centroid of each row (from start) */
+public:
+	IndexAssignBody(const Mat* data,const Mat* centroids,const int& start,vector<int>* labels)
+		: data(data), centroids(centroids), start(start), labels(labels) {
+	}
+	virtual void operator()(const Range& range) const{
+		for(int i=range.start;i<range.end;i++){
+			const float* x=data->ptr<float>(i);
+			float best=0;
+			int label=0;
+			for(int c=0;c<centroids->rows;c++){
+				float d=SimdTools::squaredDistance(x,centroids->ptr<float>(c),data->cols);
+				if(c==0 || d<best){
+					best=d;
+					label=c;
+				}
+			}
+			(*labels)[i-start]=label;
+		}
+	}
+};
+
+/*!
+ *  \brief Keep a candidate if it is one of the k best
+ */
+static inline void pushCandidate(std::priority_queue<std::pair<float,int> >& best,const int& k,const float& d,const int& i){
+	if((int)best.size()<k)
+		best.push(std::make_pair(d,i));
+	else if(d<best.top().first){
+		best.pop();
+		best.push(std::make_pair(d,i));
+	}
+}
+
+DescriptorIndex::DescriptorIndex(const IndexMetric& metric) : metric(metric), dim(0) {
+}
+
+void DescriptorIndex::setScaling(const Mat& sample){
+	GCFD_PROFILE_SCOPE("Index/setScaling");
+	CV_Assert(data.empty());
+	CV_Assert(sample.rows>0 && sample.channels()==1 && (dim==0 || sample.cols==dim));
+	dim=sample.cols;
+	colMin.create(1,dim,CV_32F);
+	colScale.create(1,dim,CV_32F);
+	for(int j=0;j<dim;j++){
+		double minVal,maxVal;
+		minMaxLoc(sample.col(j),&minVal,&maxVal);
+		colMin.at<float>(0,j)=(float)minVal;
+		colScale.at<float>(0,j)=maxVal>minVal ? (float)(2/(maxVal-minVal)) : 0.f;
+	}
+}
+
+Mat DescriptorIndex::prepare(const Mat& descriptors) const{
+	GCFD_PROFILE_SCOPE("Index/prepare");
+	CV_Assert(descriptors.channels()==1 && descriptors.cols==dim);
+	Mat res;
+	descriptors.convertTo(res,CV_32F);
+	GCFD_PROFILE_TEMPORARY(res);
+	for(int i=0;i<res.rows;i++){
+		float* x=res.ptr<float>(i);
+		if(!colMin.empty()){
+			const float* m=colMin.ptr<float>(0);
+			const float* s=colScale.ptr<float>(0);
+			for(int j=0;j<dim;j++)
+				x[j]=(x[j]-m[j])*s[j]-1;
+		}
+		if(metric==INDEX_COSINE){
+			double n2=0;
+			for(int j=0;j<dim;j++)
+				n2+=(double)x[j]*x[j];
+			if(n2>0){
+				float inv=(float)(1/std::sqrt(n2));
+				for(int j=0;j<dim;j++)
+					x[j]*=inv;
+			}
+		}
+	}
+	return res;
+}
+
+void DescriptorIndex::add(const Mat& descriptors){
+	if(descriptors.rows==0)
+		return;
+	if(dim==0)
+		dim=descriptors.cols;
+	Mat X=prepare(descriptors);
+	int start=data.rows;
+	data.push_back(X);
+	if(isTrained())
+		assign(start,data.rows);
+}
+
+void DescriptorIndex::add(const DescriptorStore& store){
+	const long long block=65536;
+	for(long long start=0;start<store.getNbRows();start+=block)
+		add(store.getRows(start,std::min(start+block,store.getNbRows()),CV_32F));
+}
+
+void DescriptorIndex::assign(const int& start,const int& end){
+	vector<int> labels(end-start);
+	parallel_for_(Range(start,end),IndexAssignBody(&data,&centroids,start,&labels));
+	for(int i=start;i<end;i++)
+		lists[labels[i-start]].push_back(i);
+}
+
+void DescriptorIndex::train(const int& nlist,const int& maxSamples){
+	CV_Assert(nlist>0 && data.rows>=nlist && maxSamples>=nlist);
+	Mat sample;
+	if(data.rows<=maxSamples)
+		sample=data;
+	else{
+		// A random subset of the descriptors, drawn by a partial Fisher-Yates shuffle
+		vector<int> rows(data.rows);
+		for(int i=0;i<data.rows;i++)
+			rows[i]=i;
+		RNG rng(0);
+		sample.create(maxSamples,dim,CV_32F);
+		for(int i=0;i<maxSamples;i++){
+			int j=i+rng.uniform(0,data.rows-i);
+			std::swap(rows[i],rows[j]);
+			data.row(rows[i]).copyTo(sample.row(i));
+		}
+	}
+	Mat labels;
+	kmeans(sample,nlist,labels,TermCriteria(TermCriteria::COUNT+TermCriteria::EPS,20,1e-4),1,KMEANS_PP_CENTERS,centroids);
+	lists.assign(nlist,vector<int>());
+	assign(0,data.rows);
+}
+
+void DescriptorIndex::searchOne(const float* q,const int& k,const int& nprobe,vector<DMatch>& matches) const{
+	// Max-heap of the k best candidates: the top is the one to replace
+	std::priority_queue<std::pair<float,int> > best;
+	if(nprobe>0 && isTrained()){
+		vector<std::pair<float,int> > nearest(centroids.rows);
+		for(int c=0;c<centroids.rows;c++)
+			nearest[c]=std::make_pair(SimdTools::squaredDistance(q,centroids.ptr<float>(c),dim),c);
+		int nbLists=std::min(nprobe,centroids.rows);
+		std::partial_sort(nearest.begin(),nearest.begin()+nbLists,nearest.end());
+		for(int l=0;l<nbLists;l++){
+			const vector<int>& rows=lists[nearest[l].second];
+			for(size_t e=0;e<rows.size();e++)
+				pushCandidate(best,k,SimdTools::squaredDistance(q,data.ptr<float>(rows[e]),dim),rows[e]);
+		}
+	}
+	else{
+		for(int i=0;i<data.rows;i++)
+			pushCandidate(best,k,SimdTools::squaredDistance(q,data.ptr<float>(i),dim),i);
+	}
+	matches.resize(best.size());
+	for(int j=(int)best.size()-1;j>=0;j--){
+		float d=best.top().first;
+		// For normalized vectors |a-b|^2=2(1-cos(a,b))
+		matches[j]=DMatch(-1,best.top().second,metric==INDEX_COSINE ? d/2 : std::sqrt(d));
+		best.pop();
+	}
+}
+
+void DescriptorIndex::knnSearch(const Mat& queries,vector<vector<DMatch> >& matches,const int& k,const int& nprobe) const{
+	CV_Assert(k>0);
+	matches.assign(queries.rows,vector<DMatch>());
+	if(data.empty() || queries.rows==0)
+		return;
+	Mat Q=prepare(queries);
+	parallel_for_(Range(0,Q.rows),DescriptorIndexBody(this,&Q,&matches,k,nprobe));
+}
+
+int DescriptorIndex::size() const{
+	return data.rows;
+}
+
+bool DescriptorIndex::isTrained() const{
+	return !centroids.empty();
+}
+
+DescriptorIndex::~DescriptorIndex() {
+}
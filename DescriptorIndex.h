@@ -0,0 +1,166 @@
+/**
+ * \file DescriptorIndex.h
+ * \brief Nearest neighbour search among descriptors
+ * \version 1.0
+ * \date October 17, 2026
+ *
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the distribution
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DESCRIPTORINDEX_H_
+#define DESCRIPTORINDEX_H_
+
+#include <iostream>
+#include <opencv/cv.h>
+#include <opencv/highgui.h>
+#include <vector>
+#include "DescriptorStore.h"
+
+using namespace cv;
+
+/*!
+ *  \brief The distances used by DescriptorIndex
+ */
+enum IndexMetric {
+	INDEX_L2,				/*!< Euclidean distance */
+	INDEX_COSINE			/*!< 1-cos(a,b), the descriptors are normalized when they are added */
+};
+
+class DescriptorIndexBody;
+
+/*! \class DescriptorIndex
+   * \brief Search the k nearest neighbours of descriptors
+   *
+   *  The descriptors are stored as float. Without training the search is exact: each query is
+   *  compared to all the descriptors with SimdTools::squaredDistance. train() builds an inverted
+   *  file (IVF): the descriptors are split into clusters by cv::kmeans and a query is then only
+   *  compared to the descriptors of the nprobe clusters with the nearest centroids, which is
+   *  approximate but about nlist/nprobe times faster. The queries of a batch are spread over the
+   *  threads of cv::parallel_for_.
+   *
+   *  The first value of GFD1, GCFD1 and GCFD3 (the energy at the null frequency) is far larger
+   *  than the others and dominates the L2 distance: setScaling() applies to the descriptors and
+   *  to the queries the column scaling of MyTools::scaleDesc.
+   */
+class DescriptorIndex {
+private:
+	IndexMetric metric;				/*!< The distance */
+	int dim;						/*!< Number of values of a descriptor (0 before the first add) */
+	Mat data;						/*!< The descriptors (Mat of float, one per row) */
+	Mat colMin;						/*!< Minimum of each column for the scaling (empty if no scaling) */
+	Mat colScale;					/*!< 2/(max-min) of each column for the scaling */
+	Mat centroids;					/*!< The centroids of the clusters (empty if not trained) */
+	vector<vector<int> > lists;		/*!< The rows of each cluster */
+
+	friend class DescriptorIndexBody;
+	/*!
+	 *  \brief Convert descriptors to float and apply the scaling and the normalization
+	 *
+	 *  \param descriptors : A Mat of float or double with dim columns
+	 *  \return Return a Mat of float
+	 */
+	Mat prepare(const Mat& descriptors) const;
+	/*!
+	 *  \brief Add rows to the cluster of their nearest centroid
+	 *
+	 *  \param start : The first row
+	 *  \param end : The row after the last one
+	 */
+	void assign(const int& start,const int& end);
+	/*!
+	 *  \brief Search the nearest neighbours of one prepared query
+	 *
+	 *  \param q : The query
+	 *  \param k : The number of neighbours
+	 *  \param nprobe : The number of clusters to visit (0 for an exact search)
+	 *  \param matches : The output, sorted by increasing distance
+	 */
+	void searchOne(const float* q,const int& k,const int& nprobe,vector<DMatch>& matches) const;
+
+public:
+	/*!
+	 *  \brief Constructor of DescriptorIndex class
+	 *
+	 *  \param metric : The distance
+	 *
+	 */
+	DescriptorIndex(const IndexMetric& metric=INDEX_L2);
+	/*!
+	 *  \brief Scale the columns as MyTools::scaleDesc
+	 *
+	 *  Must be called before the first add. Each column is mapped to [-1,1] by its minimum and its
+	 *  maximum in the sample; the same mapping is applied to the queries.
+	 *
+	 *  \param sample : Descriptors representative of the ones which will be added (one per row)
+	 */
+	void setScaling(const Mat& sample);
+	/*!
+	 *  \brief Add descriptors
+	 *
+	 *  The row i of the first call is the descriptor of trainIdx i, the rows of the next calls
+	 *  follow. If the index is trained, the descriptors are added to the nearest cluster.
+	 *
+	 *  \param descriptors : A Mat of float or double, one descriptor per row
+	 */
+	void add(const Mat& descriptors);
+	/*!
+	 *  \brief Add all the descriptors of a store
+	 *
+	 *  \param store : An opened DescriptorStore
+	 */
+	void add(const DescriptorStore& store);
+	/*!
+	 *  \brief Build the inverted file
+	 *
+	 *  \param nlist : The number of clusters, about sqrt(size()) is a good choice
+	 *  \param maxSamples : The maximum number of descriptors (taken at random) given to cv::kmeans
+	 */
+	void train(const int& nlist,const int& maxSamples=100000);
+	/*!
+	 *  \brief Find the k nearest neighbours of each query
+	 *
+	 *  \param queries : A Mat of float or double, one descriptor per row
+	 *  \param matches : The output, for each query the (at most) k nearest descriptors sorted by
+	 *  increasing distance; trainIdx is the row of the descriptor in the index
+	 *  \param k : The number of neighbours
+	 *  \param nprobe : The number of clusters visited if the index is trained, 0 for an exact search
+	 */
+	void knnSearch(const Mat& queries,vector<vector<DMatch> >& matches,const int& k,const int& nprobe=0) const;
+	/*!
+	 *  \brief Get the number of descriptors
+	 *
+	 *  \return Return the number of descriptors in the index
+	 */
+	int size() const;
+	/*!
+	 *  \brief Check if the inverted file has been built
+	 *
+	 *  \return Return true if train has been called
+	 */
+	bool isTrained() const;
+
+	virtual ~DescriptorIndex();
+};
+
+#endif /* DESCRIPTORINDEX_H_ */
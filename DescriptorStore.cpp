@@ -0,0 +1,540 @@
+/**
+ * \file DescriptorStore.cpp
+ * \brief Binary memory-mapped storage of descriptors
+ * \version 1.0
+ * \date October 17, 2026
+ *
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the distribution
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "DescriptorStore.h"
+#include <cstddef>
+#include <cstring>
+#include <cmath>
+#include <stdint.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#define STORE_MAGIC "CFDSTORE"
+#define STORE_VERSION 1
+#define STORE_BYTE_ORDER 0x01020304u
+
+/*!
+ *  \brief The header at the beginning of a file (128 bytes, in the byte order of the writer)
+ */
+struct StoreFileHeader {
+	char magic[8];			/*!< STORE_MAGIC */
+	uint32_t version;		/*!< STORE_VERSION */
+	uint32_t byteOrder;		/*!< STORE_BYTE_ORDER, to detect a file written on another architecture */
+	int32_t type;			/*!< The DescriptorType */
+	int32_t encoding;		/*!< The DescriptorEncoding */
+	int32_t dim;			/*!< Number of values of a descriptor */
+	int32_t rows;			/*!< Height of the images */
+	int32_t cols;			/*!< Width of the images */
+	int32_t maxR;			/*!< The maximum of radius of the discrete circles */
+	int32_t stride;			/*!< Number of bytes of a row */
+	int32_t dataOffset;		/*!< Position of the first row: the column table (2*dim floats) is between the header and the rows */
+	double biv[3];			/*!< The color vector of the bivector */
+	int64_t nbRows;			/*!< Number of complete rows */
+	uchar reserved[48];		/*!< Zero */
+};
+
+// The layout of the header is part of the format
+typedef char StoreFileHeaderSizeCheck[sizeof(StoreFileHeader)==128 ? 1 : -1];
+
+static int align(const int& n,const int& a){
+	return (n+a-1)/a*a;
+}
+
+static int valueSize(const DescriptorEncoding& encoding){
+	switch(encoding){
+	case ENCODING_FLOAT64:
+		return 8;
+	case ENCODING_FLOAT32:
+		return 4;
+	case ENCODING_FLOAT16:
+		return 2;
+	default:
+		return 1;
+	}
+}
+
+/*!
+ *  \brief Offset of the identifier in a row
+ */
+static int idOffset(const DescriptorStoreHeader& header){
+	return align(header.dim*valueSize(header.encoding),8);
+}
+
+/*!
+ *  \brief Number of bytes of a row: the values, then the identifier
+ */
+static int rowStride(const DescriptorStoreHeader& header){
+	return align(idOffset(header)+8,16);
+}
+
+/*!
+ *  \brief Position of the first row, after the header and the column table
+ */
+static int rowsOffset(const int& dim){
+	return align((int)sizeof(StoreFileHeader)+2*dim*(int)sizeof(float),64);
+}
+
+/*!
+ *  \brief Check a header read from a file: its fields must be in range and its layout the one written by DescriptorStoreWriter
+ */
+static bool isValidHeader(const StoreFileHeader& h){
+	if(memcmp(h.magic,STORE_MAGIC,8)!=0 || h.version!=STORE_VERSION || h.byteOrder!=STORE_BYTE_ORDER)
+		return false;
+	if(h.type<GFD1_DESCRIPTOR || h.type>GCFD3_DESCRIPTOR || h.encoding<ENCODING_FLOAT64 || h.encoding>ENCODING_INT8)
+		return false;
+	// The bound on dim keeps the offsets below in range of an int
+	if(h.dim<=0 || h.dim>(1<<24) || h.nbRows<0)
+		return false;
+	DescriptorStoreHeader header;
+	header.encoding=(DescriptorEncoding)h.encoding;
+	header.dim=h.dim;
+	return h.stride>=idOffset(header)+8 && h.stride==rowStride(header) && h.dataOffset==rowsOffset(h.dim);
+}
+
+/*!
+ *  \brief Convert a float to a half float (rounded to nearest even)
+ */
+static ushort floatToHalf(const float& value){
+	union { float f; uint32_t u; } v;
+	v.f=value;
+	const uint32_t sign=(v.u>>16)&0x8000;
+	const uint32_t a=v.u&0x7fffffff;
+	if(a>=0x7f800000)
+		return (ushort)(sign|0x7c00|(a>0x7f800000 ? 0x200 : 0));
+	if(a>=0x477ff000)
+		return (ushort)(sign|0x7c00);
+	if(a<0x38800000){
+		// Subnormal half float
+		if(a<0x33000000)
+			return (ushort)sign;
+		const uint32_t m=(a&0x7fffff)|0x800000;
+		const int shift=126-(int)(a>>23);
+		uint32_t q=m>>shift;
+		const uint32_t rem=m&((1u<<shift)-1);
+		const uint32_t halfway=1u<<(shift-1);
+		if(rem>halfway || (rem==halfway && (q&1)))
+			q++;
+		return (ushort)(sign|q);
+	}
+	uint32_t h=(a>>13)-((127-15)<<10);
+	const uint32_t rem=a&0x1fff;
+	if(rem>0x1000 || (rem==0x1000 && (h&1)))
+		h++;
+	return (ushort)(sign|h);
+}
+
+/*!
+ *  \brief Convert a half float to a float
+ */
+static float halfToFloat(const ushort& h){
+	union { float f; uint32_t u; } v;
+	const uint32_t sign=(uint32_t)(h&0x8000)<<16;
+	uint32_t e=(h>>10)&0x1f;
+	uint32_t m=h&0x3ff;
+	if(e==0){
+		if(m==0)
+			v.u=sign;
+		else{
+			e=113;
+			while(!(m&0x400)){
+				m<<=1;
+				e--;
+			}
+			v.u=sign|(e<<23)|((m&0x3ff)<<13);
+		}
+	}
+	else if(e==31)
+		v.u=sign|0x7f800000|(m<<13);
+	else
+		v.u=sign|((e+112)<<23)|(m<<13);
+	return v.f;
+}
+
+DescriptorStoreHeader::DescriptorStoreHeader() : type(GCFD3_DESCRIPTOR), encoding(ENCODING_FLOAT64), dim(0), imageSize(), maxR(0) {
+}
+
+DescriptorStoreHeader::DescriptorStoreHeader(const DescriptorType& type,const Mat& Biv,const Size& imageSize,const DescriptorEncoding& encoding)
+		: type(type), encoding(encoding), imageSize(imageSize) {
+	CV_Assert(Biv.total()==3);
+	Biv.reshape(1,1).convertTo(this->Biv,CV_64F);
+	dim=DescriptorBatch::getDescriptorSize(type,imageSize);
+	maxR=std::min(imageSize.width-(imageSize.width%2==0),imageSize.height-(imageSize.height%2==0))/2;
+}
+
+DescriptorStoreWriter::DescriptorStoreWriter() : file(0), stride(0), dataOffset(0), nbRows(0), positioned(false), quantized(false) {
+}
+
+DescriptorStoreWriter::DescriptorStoreWriter(const string& path,const DescriptorStoreHeader& header)
+		: file(0), stride(0), dataOffset(0), nbRows(0), positioned(false), quantized(false) {
+	create(path,header);
+}
+
+DescriptorStoreWriter::DescriptorStoreWriter(const string& path)
+		: file(0), stride(0), dataOffset(0), nbRows(0), positioned(false), quantized(false) {
+	open(path);
+}
+
+void DescriptorStoreWriter::create(const string& path,const DescriptorStoreHeader& header){
+	CV_Assert(header.dim>0 && header.Biv.total()==3);
+	close();
+	file=fopen(path.c_str(),"w+b");
+	if(!file)
+		CV_Error(CV_StsError,"DescriptorStoreWriter: cannot create "+path);
+	this->header=header;
+	stride=rowStride(header);
+	dataOffset=rowsOffset(header.dim);
+	nbRows=0;
+	quantized=header.encoding!=ENCODING_INT8;
+	scales.assign(header.dim,header.encoding==ENCODING_FLOAT16 ? 1.f : 0.f);
+	offsets.assign(header.dim,0.f);
+	row.assign(stride,0);
+	writeHeader();
+}
+
+void DescriptorStoreWriter::open(const string& path){
+	close();
+	file=fopen(path.c_str(),"r+b");
+	if(!file)
+		CV_Error(CV_StsError,"DescriptorStoreWriter: cannot open "+path);
+	StoreFileHeader h;
+	if(fread(&h,sizeof(h),1,file)!=1 || !isValidHeader(h)){
+		fclose(file);
+		file=0;
+		CV_Error(CV_StsError,"DescriptorStoreWriter: "+path+" is not a descriptor store of this version");
+	}
+	header.type=(DescriptorType)h.type;
+	header.encoding=(DescriptorEncoding)h.encoding;
+	header.dim=h.dim;
+	header.imageSize=Size(h.cols,h.rows);
+	header.maxR=h.maxR;
+	header.Biv=(Mat_<double>(1,3)<<h.biv[0],h.biv[1],h.biv[2]);
+	stride=h.stride;
+	dataOffset=h.dataOffset;
+	nbRows=h.nbRows;
+	scales.resize(header.dim);
+	offsets.resize(header.dim);
+	if(fread(&scales[0],sizeof(float),header.dim,file)!=(size_t)header.dim || fread(&offsets[0],sizeof(float),header.dim,file)!=(size_t)header.dim){
+		fclose(file);
+		file=0;
+		CV_Error(CV_StsError,"DescriptorStoreWriter: "+path+" is truncated");
+	}
+	quantized=header.encoding!=ENCODING_INT8 || scales[0]!=0;
+	row.assign(stride,0);
+	positioned=false;
+}
+
+void DescriptorStoreWriter::writeHeader(){
+	StoreFileHeader h;
+	memset(&h,0,sizeof(h));
+	memcpy(h.magic,STORE_MAGIC,8);
+	h.version=STORE_VERSION;
+	h.byteOrder=STORE_BYTE_ORDER;
+	h.type=header.type;
+	h.encoding=header.encoding;
+	h.dim=header.dim;
+	h.rows=header.imageSize.height;
+	h.cols=header.imageSize.width;
+	h.maxR=header.maxR;
+	h.stride=stride;
+	h.dataOffset=dataOffset;
+	for(int k=0;k<3;k++)
+		h.biv[k]=header.Biv.at<double>(0,k);
+	h.nbRows=nbRows;
+	vector<uchar> padding(dataOffset-sizeof(h)-2*header.dim*sizeof(float),0);
+	fseeko(file,0,SEEK_SET);
+	bool ok=fwrite(&h,sizeof(h),1,file)==1;
+	ok=ok && fwrite(&scales[0],sizeof(float),header.dim,file)==(size_t)header.dim;
+	ok=ok && fwrite(&offsets[0],sizeof(float),header.dim,file)==(size_t)header.dim;
+	ok=ok && (padding.empty() || fwrite(&padding[0],1,padding.size(),file)==padding.size());
+	if(!ok)
+		CV_Error(CV_StsError,"DescriptorStoreWriter: cannot write the header");
+	positioned=false;
+}
+
+void DescriptorStoreWriter::setQuantization(const Mat& sample){
+	CV_Assert(file && (header.encoding==ENCODING_FLOAT16 || header.encoding==ENCODING_INT8) && nbRows==0);
+	CV_Assert(sample.cols==header.dim && sample.rows>0 && sample.channels()==1);
+	Mat S;
+	sample.convertTo(S,CV_64F);
+	for(int j=0;j<header.dim;j++){
+		double minVal,maxVal;
+		minMaxLoc(S.col(j),&minVal,&maxVal);
+		if(header.encoding==ENCODING_FLOAT16){
+			// Only the range matters: the values are scaled into [-1,1]
+			double scale=std::max(fabs(minVal),fabs(maxVal));
+			scales[j]=(float)(scale>0 ? scale : 1);
+			offsets[j]=0;
+		}
+		else{
+			double scale=(maxVal-minVal)/254;
+			scales[j]=(float)(scale>0 ? scale : 1);
+			offsets[j]=(float)((maxVal+minVal)/2);
+		}
+	}
+	quantized=true;
+	writeHeader();
+}
+
+template<typename T> void DescriptorStoreWriter::appendRow(const T* values,const long long& id){
+	uchar* r=&row[0];
+	switch(header.encoding){
+	case ENCODING_FLOAT64:
+		for(int j=0;j<header.dim;j++)
+			((double*)r)[j]=(double)values[j];
+		break;
+	case ENCODING_FLOAT32:
+		for(int j=0;j<header.dim;j++)
+			((float*)r)[j]=(float)values[j];
+		break;
+	case ENCODING_FLOAT16:
+		for(int j=0;j<header.dim;j++)
+			((ushort*)r)[j]=floatToHalf((float)(((double)values[j]-offsets[j])/scales[j]));
+		break;
+	case ENCODING_INT8:
+		for(int j=0;j<header.dim;j++){
+			int q=cvRound(((double)values[j]-offsets[j])/scales[j]);
+			((schar*)r)[j]=(schar)std::max(-127,std::min(127,q));
+		}
+		break;
+	}
+	int64_t id64=id;
+	memcpy(r+idOffset(header),&id64,sizeof(id64));
+	if(!positioned){
+		fseeko(file,(off_t)dataOffset+(off_t)nbRows*stride,SEEK_SET);
+		positioned=true;
+	}
+	if(fwrite(r,1,stride,file)!=(size_t)stride)
+		CV_Error(CV_StsError,"DescriptorStoreWriter: cannot write a row");
+	nbRows++;
+}
+
+void DescriptorStoreWriter::append(const Mat& descriptors,const long long& firstId){
+	CV_Assert(file);
+	CV_Assert(descriptors.cols==header.dim && descriptors.channels()==1);
+	CV_Assert(descriptors.depth()==CV_64F || descriptors.depth()==CV_32F);
+	if(!quantized)
+		CV_Error(CV_StsError,"DescriptorStoreWriter: setQuantization must be called before writing int8 rows");
+	// firstId may be a reference to nbRows, which is incremented by appendRow
+	const long long id0=firstId;
+	for(int i=0;i<descriptors.rows;i++){
+		if(descriptors.depth()==CV_64F)
+			appendRow(descriptors.ptr<double>(i),id0+i);
+		else
+			appendRow(descriptors.ptr<float>(i),id0+i);
+	}
+}
+
+void DescriptorStoreWriter::append(const Mat& descriptors){
+	append(descriptors,nbRows);
+}
+
+void DescriptorStoreWriter::append(const vector<double>& descriptor,const long long& id){
+	CV_Assert(!descriptor.empty());
+	append(Mat(1,(int)descriptor.size(),CV_64F,(void*)&descriptor[0]),id);
+}
+
+void DescriptorStoreWriter::write(const int& index,const string&,const Mat& descriptor){
+	append(descriptor,index);
+}
+
+void DescriptorStoreWriter::flush(){
+	if(!file)
+		return;
+	int64_t n=nbRows;
+	fflush(file);
+	fseeko(file,(off_t)offsetof(StoreFileHeader,nbRows),SEEK_SET);
+	if(fwrite(&n,sizeof(n),1,file)!=1)
+		CV_Error(CV_StsError,"DescriptorStoreWriter: cannot write the header");
+	fflush(file);
+	positioned=false;
+}
+
+void DescriptorStoreWriter::close(){
+	if(!file)
+		return;
+	flush();
+	fclose(file);
+	file=0;
+}
+
+long long DescriptorStoreWriter::getNbRows() const{
+	return nbRows;
+}
+
+const DescriptorStoreHeader& DescriptorStoreWriter::getHeader() const{
+	return header;
+}
+
+DescriptorStoreWriter::~DescriptorStoreWriter() {
+	if(file){
+		int64_t n=nbRows;
+		fseeko(file,(off_t)offsetof(StoreFileHeader,nbRows),SEEK_SET);
+		fwrite(&n,sizeof(n),1,file);
+		fclose(file);
+	}
+}
+
+DescriptorStore::DescriptorStore() : fd(-1), base(0), mapSize(0), stride(0), dataOffset(0), nbRows(0), scales(0), offsets(0) {
+}
+
+DescriptorStore::DescriptorStore(const string& path) : fd(-1), base(0), mapSize(0), stride(0), dataOffset(0), nbRows(0), scales(0), offsets(0) {
+	open(path);
+}
+
+void DescriptorStore::open(const string& path){
+	close();
+	fd=::open(path.c_str(),O_RDONLY);
+	if(fd<0)
+		CV_Error(CV_StsError,"DescriptorStore: cannot open "+path);
+	struct stat st;
+	if(fstat(fd,&st)!=0 || st.st_size<(off_t)sizeof(StoreFileHeader)){
+		close();
+		CV_Error(CV_StsError,"DescriptorStore: "+path+" is not a descriptor store");
+	}
+	mapSize=(size_t)st.st_size;
+	void* p=mmap(0,mapSize,PROT_READ,MAP_SHARED,fd,0);
+	if(p==MAP_FAILED){
+		base=0;
+		close();
+		CV_Error(CV_StsError,"DescriptorStore: cannot map "+path);
+	}
+	base=(uchar*)p;
+	const StoreFileHeader& h=*(const StoreFileHeader*)base;
+	if(!isValidHeader(h) || (size_t)h.dataOffset>mapSize){
+		close();
+		CV_Error(CV_StsError,"DescriptorStore: "+path+" is not a descriptor store of this version");
+	}
+	header.type=(DescriptorType)h.type;
+	header.encoding=(DescriptorEncoding)h.encoding;
+	header.dim=h.dim;
+	header.imageSize=Size(h.cols,h.rows);
+	header.maxR=h.maxR;
+	header.Biv=(Mat_<double>(1,3)<<h.biv[0],h.biv[1],h.biv[2]);
+	stride=h.stride;
+	dataOffset=h.dataOffset;
+	// The rows written after the last flush of the writer are not counted in the header
+	nbRows=std::min((long long)h.nbRows,(long long)((mapSize-dataOffset)/stride));
+	scales=(const float*)(base+sizeof(h));
+	offsets=scales+header.dim;
+}
+
+void DescriptorStore::close(){
+	if(base)
+		munmap(base,mapSize);
+	if(fd>=0)
+		::close(fd);
+	fd=-1;
+	base=0;
+	mapSize=0;
+	nbRows=0;
+	scales=0;
+	offsets=0;
+}
+
+Mat DescriptorStore::getView() const{
+	CV_Assert(base);
+	static const int depths[]={CV_64F,CV_32F,CV_16U,CV_8S};
+	return Mat((int)nbRows,header.dim,depths[header.encoding],base+dataOffset,stride);
+}
+
+template<typename T> void DescriptorStore::decode(const long long& start,const long long& end,Mat& res) const{
+	for(long long i=start;i<end;i++){
+		const uchar* r=base+dataOffset+i*stride;
+		T* out=res.ptr<T>((int)(i-start));
+		switch(header.encoding){
+		case ENCODING_FLOAT64:
+			for(int j=0;j<header.dim;j++)
+				out[j]=(T)((const double*)r)[j];
+			break;
+		case ENCODING_FLOAT32:
+			for(int j=0;j<header.dim;j++)
+				out[j]=(T)((const float*)r)[j];
+			break;
+		case ENCODING_FLOAT16:
+			for(int j=0;j<header.dim;j++)
+				out[j]=(T)(offsets[j]+scales[j]*halfToFloat(((const ushort*)r)[j]));
+			break;
+		case ENCODING_INT8:
+			for(int j=0;j<header.dim;j++)
+				out[j]=(T)(offsets[j]+scales[j]*((const schar*)r)[j]);
+			break;
+		}
+	}
+}
+
+Mat DescriptorStore::getRows(const long long& start,const long long& end,const int& depth) const{
+	CV_Assert(base && 0<=start && start<=end && end<=nbRows);
+	CV_Assert(depth==CV_64F || depth==CV_32F);
+	Mat res((int)(end-start),header.dim,depth);
+	if(depth==CV_64F)
+		decode<double>(start,end,res);
+	else
+		decode<float>(start,end,res);
+	return res;
+}
+
+vector<double> DescriptorStore::getRow(const long long& i) const{
+	vector<double> res(header.dim);
+	Mat r(1,header.dim,CV_64F,&res[0]);
+	CV_Assert(base && 0<=i && i<nbRows);
+	decode<double>(i,i+1,r);
+	return res;
+}
+
+long long DescriptorStore::getId(const long long& i) const{
+	CV_Assert(base && 0<=i && i<nbRows);
+	int64_t id;
+	memcpy(&id,base+dataOffset+i*stride+idOffset(header),sizeof(id));
+	return id;
+}
+
+void DescriptorStore::getQuantization(const int& j,float& scale,float& offset) const{
+	CV_Assert(base && (header.encoding==ENCODING_FLOAT16 || header.encoding==ENCODING_INT8) && 0<=j && j<header.dim);
+	scale=scales[j];
+	offset=offsets[j];
+}
+
+long long DescriptorStore::getNbRows() const{
+	return nbRows;
+}
+
+const DescriptorStoreHeader& DescriptorStore::getHeader() const{
+	return header;
+}
+
+bool DescriptorStore::empty() const{
+	return base==0;
+}
+
+DescriptorStore::~DescriptorStore() {
+	close();
+}
@@ -0,0 +1,319 @@
+/**
+ * \file DescriptorStore.h
+ * \brief Binary memory-mapped storage of descriptors
+ * \version 1.0
+ * \date October 17, 2026
+ *
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the distribution
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DESCRIPTORSTORE_H_
+#define DESCRIPTORSTORE_H_
+
+#include <iostream>
+#include <opencv/cv.h>
+#include <opencv/highgui.h>
+#include <vector>
+#include <string>
+#include <cstdio>
+#include "DescriptorBatch.h"
+#include "StreamingExtractor.h"
+
+using namespace cv;
+
+/*!
+ *  \brief The encodings of the values of a DescriptorStore
+ */
+enum DescriptorEncoding {
+	ENCODING_FLOAT64,		/*!< 8 bytes per value, exact */
+	ENCODING_FLOAT32,		/*!< 4 bytes per value */
+	ENCODING_FLOAT16,		/*!< 2 bytes per value (IEEE half precision), divided by a scale per column */
+	ENCODING_INT8			/*!< 1 byte per value, quantized with a scale and an offset per column */
+};
+
+/*! \struct DescriptorStoreHeader
+   * \brief Metadata of a DescriptorStore
+   */
+struct DescriptorStoreHeader {
+	DescriptorType type;			/*!< The descriptor stored in each row */
+	DescriptorEncoding encoding;	/*!< The encoding of the values */
+	int dim;						/*!< Number of values of a descriptor */
+	Size imageSize;					/*!< The size of the images */
+	int maxR;						/*!< The maximum of radius of the discrete circles */
+	Mat Biv;						/*!< The color vector used to build the bivector B=Biv^e4 (1x3 of double) */
+	DescriptorStoreHeader();
+	/*!
+	 *  \brief Constructor of DescriptorStoreHeader
+	 *
+	 *  \param type : The descriptor stored in each row
+	 *  \param Biv : The color vector used to build the bivector B=Biv^e4
+	 *  \param imageSize : The size of the images, dim and maxR are deduced from it
+	 *  \param encoding : The encoding of the values
+	 */
+	DescriptorStoreHeader(const DescriptorType& type,const Mat& Biv,const Size& imageSize,const DescriptorEncoding& encoding);
+};
+
+/*! \class DescriptorStoreWriter
+   * \brief Write descriptors in a binary file, or append descriptors to an existing file
+   *
+   *  The file starts with a versioned header holding the metadata and, for ENCODING_FLOAT16 and
+   *  ENCODING_INT8, the scale and the offset of each column. The rows follow with a fixed stride (a multiple of 16
+   *  bytes): the encoded values, then the 64 bits identifier of the row. The number of rows in
+   *  the header is updated by flush() and close(), so a reader only sees complete rows and an
+   *  interrupted writer loses only the rows written after the last flush.
+   *
+   *  A writer is also a DescriptorSink: the descriptors computed by a StreamingExtractor_ are
+   *  appended with the index of their image as identifier.
+   */
+class DescriptorStoreWriter : public DescriptorSink {
+private:
+	FILE* file;						/*!< The opened file (or null) */
+	DescriptorStoreHeader header;	/*!< The metadata of the file */
+	int stride;						/*!< Number of bytes of a row */
+	int dataOffset;					/*!< Position of the first row in the file */
+	long long nbRows;				/*!< Number of rows written */
+	bool positioned;				/*!< True if the position of the file is the end of the rows */
+	bool quantized;					/*!< False until the scales and offsets of ENCODING_INT8 are known */
+	vector<float> scales;			/*!< Scale of each column (ENCODING_FLOAT16 and ENCODING_INT8) */
+	vector<float> offsets;			/*!< Offset of each column (ENCODING_FLOAT16 and ENCODING_INT8) */
+	vector<uchar> row;				/*!< An encoded row */
+
+	/*!
+	 *  \brief Write the header and the column table at the beginning of the file
+	 */
+	void writeHeader();
+	/*!
+	 *  \brief Encode and write a row
+	 */
+	template<typename T> void appendRow(const T* values,const long long& id);
+
+	DescriptorStoreWriter(const DescriptorStoreWriter&);
+	DescriptorStoreWriter& operator=(const DescriptorStoreWriter&);
+
+public:
+	DescriptorStoreWriter();
+	/*!
+	 *  \brief Constructor of DescriptorStoreWriter class, see create
+	 *
+	 *  \param path : The file to create
+	 *  \param header : The metadata of the file
+	 *
+	 */
+	DescriptorStoreWriter(const string& path,const DescriptorStoreHeader& header);
+	/*!
+	 *  \brief Constructor of DescriptorStoreWriter class, see open
+	 *
+	 *  \param path : An existing file
+	 *
+	 */
+	DescriptorStoreWriter(const string& path);
+	/*!
+	 *  \brief Create a file (an existing file is overwritten)
+	 *
+	 *  \param path : The file to create
+	 *  \param header : The metadata of the file
+	 */
+	void create(const string& path,const DescriptorStoreHeader& header);
+	/*!
+	 *  \brief Open an existing file to append rows
+	 *
+	 *  \param path : An existing file
+	 */
+	void open(const string& path);
+	/*!
+	 *  \brief Set the quantization of the columns (ENCODING_FLOAT16 and ENCODING_INT8 only)
+	 *
+	 *  Must be called before the first row is written. With ENCODING_INT8 the values of each column
+	 *  of the sample are mapped to [-127,127] and the values out of the range of the sample are
+	 *  saturated; it is mandatory. With ENCODING_FLOAT16 each column is divided by its largest
+	 *  absolute value in the sample; without it, the values above 65504 (e.g. the energy at the
+	 *  null frequency of most images) become infinite.
+	 *
+	 *  \param sample : Descriptors representative of the ones which will be written (one per row)
+	 */
+	void setQuantization(const Mat& sample);
+	/*!
+	 *  \brief Append descriptors
+	 *
+	 *  \param descriptors : A Mat of float or double with header.dim columns, one descriptor per row
+	 *  \param firstId : The identifier of the first row, the next rows get the next identifiers
+	 */
+	void append(const Mat& descriptors,const long long& firstId);
+	/*!
+	 *  \brief Append descriptors, the identifier of a row is its position in the file
+	 *
+	 *  \param descriptors : A Mat of float or double with header.dim columns, one descriptor per row
+	 */
+	void append(const Mat& descriptors);
+	/*!
+	 *  \brief Append a descriptor
+	 *
+	 *  \param descriptor : A descriptor, e.g. a GCFD3
+	 *  \param id : The identifier of the row
+	 */
+	void append(const vector<double>& descriptor,const long long& id);
+	/*!
+	 *  \brief Append the descriptor of an image, see DescriptorSink
+	 *
+	 *  \param index : The index of the image, used as identifier
+	 *  \param name : Not used
+	 *  \param descriptor : A row of float or double
+	 */
+	virtual void write(const int& index,const string& name,const Mat& descriptor);
+	/*!
+	 *  \brief Write the number of rows in the header and flush the file
+	 */
+	void flush();
+	/*!
+	 *  \brief Flush and close the file
+	 */
+	void close();
+	/*!
+	 *  \brief Get the number of rows of the file
+	 *
+	 *  \return Return the number of rows
+	 */
+	long long getNbRows() const;
+	/*!
+	 *  \brief Get the metadata of the file
+	 *
+	 *  \return Return the header
+	 */
+	const DescriptorStoreHeader& getHeader() const;
+
+	virtual ~DescriptorStoreWriter();
+};
+
+/*! \class DescriptorStore
+   * \brief Read a file written by DescriptorStoreWriter through a memory mapping
+   *
+   *  Opening a file only maps it and reads the header: the rows are read by the system when they
+   *  are used. getView() gives the encoded values without any copy, getRows() decodes them.
+   *  The rows appended after open() are not seen.
+   */
+class DescriptorStore {
+private:
+	int fd;							/*!< The file descriptor (or -1) */
+	uchar* base;					/*!< The mapped file (or null) */
+	size_t mapSize;					/*!< Size of the mapping */
+	DescriptorStoreHeader header;	/*!< The metadata of the file */
+	int stride;						/*!< Number of bytes of a row */
+	int dataOffset;					/*!< Position of the first row in the file */
+	long long nbRows;				/*!< Number of rows */
+	const float* scales;			/*!< Scale of each column (ENCODING_FLOAT16 and ENCODING_INT8), in the mapping */
+	const float* offsets;			/*!< Offset of each column (ENCODING_FLOAT16 and ENCODING_INT8), in the mapping */
+
+	/*!
+	 *  \brief Decode rows
+	 */
+	template<typename T> void decode(const long long& start,const long long& end,Mat& res) const;
+
+	DescriptorStore(const DescriptorStore&);
+	DescriptorStore& operator=(const DescriptorStore&);
+
+public:
+	DescriptorStore();
+	/*!
+	 *  \brief Constructor of DescriptorStore class, see open
+	 *
+	 *  \param path : A file written by DescriptorStoreWriter
+	 *
+	 */
+	DescriptorStore(const string& path);
+	/*!
+	 *  \brief Map a file
+	 *
+	 *  \param path : A file written by DescriptorStoreWriter
+	 */
+	void open(const string& path);
+	/*!
+	 *  \brief Unmap the file, the views given by getView become invalid
+	 */
+	void close();
+	/*!
+	 *  \brief Get the encoded values without copy
+	 *
+	 *  The Mat has one row per descriptor and header.dim columns of CV_64F, CV_32F, CV_16U (half
+	 *  floats) or CV_8S (quantized values) according to the encoding, see getQuantization. It points to the read-only
+	 *  mapping: it must not be modified and is valid until close().
+	 *
+	 *  \return Return the view of all the rows
+	 */
+	Mat getView() const;
+	/*!
+	 *  \brief Decode rows
+	 *
+	 *  \param start : The first row
+	 *  \param end : The row after the last one
+	 *  \param depth : CV_64F or CV_32F, the depth of the output
+	 *  \return Return a Mat with end-start rows and header.dim columns
+	 */
+	Mat getRows(const long long& start,const long long& end,const int& depth=CV_64F) const;
+	/*!
+	 *  \brief Decode a row
+	 *
+	 *  \param i : The row
+	 *  \return Return the descriptor
+	 */
+	vector<double> getRow(const long long& i) const;
+	/*!
+	 *  \brief Get the identifier of a row
+	 *
+	 *  \param i : The row
+	 *  \return Return the identifier given when the row has been written
+	 */
+	long long getId(const long long& i) const;
+	/*!
+	 *  \brief Get the quantization of a column (ENCODING_FLOAT16 and ENCODING_INT8 only)
+	 *
+	 *  A value q of the view is decoded as offset+scale*q.
+	 *
+	 *  \param j : The column
+	 *  \param scale : The output, the scale of the column
+	 *  \param offset : The output, the offset of the column
+	 */
+	void getQuantization(const int& j,float& scale,float& offset) const;
+	/*!
+	 *  \brief Get the number of rows
+	 *
+	 *  \return Return the number of descriptors in the file
+	 */
+	long long getNbRows() const;
+	/*!
+	 *  \brief Get the metadata of the file
+	 *
+	 *  \return Return the header
+	 */
+	const DescriptorStoreHeader& getHeader() const;
+	/*!
+	 *  \brief Check if a file is mapped
+	 *
+	 *  \return Return true if no file is mapped
+	 */
+	bool empty() const;
+
+	virtual ~DescriptorStore();
+};
+
+#endif /* DESCRIPTORSTORE_H_ */
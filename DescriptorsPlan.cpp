@@ -0,0 +1,150 @@
+/**
+ * \file DescriptorsPlan.cpp
+ * \brief Constructors of the descriptors computed with a CFT plan
+ * \version 1.0
+ * \date October 17, 2026
+ *
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the distribution
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * The other members of GFD1, GCFD1 and GCFD3 are compiled in libGCFDlib.a,
+ * only the constructors taking a CFTPlan or a DescriptorExtractor are defined here. The
+ * constructors without a table take it from CircleTableCache. The spectra of the plans are
+ * temporaries of the arena of the thread (see MatArena).
+ */
+
+#include "GFD1.h"
+#include "GCFD1.h"
+#include "GCFD3.h"
+#include "CircleTableCache.h"
+#include "MatArena.h"
+#include "Profiler.h"
+
+/*!
+ *  \brief Take the spectra of the CFT of an image from an arena, so that the plan does not allocate them
+ */
+static void createSpectra(MatArenaScope& scope,const Mat& im,Mat& par,Mat& orth){
+	// The parallel part of a RGB image is packed (see CFTPlan_::executePacked)
+	par=scope.create(im.rows,im.cols,im.channels()==3 ? CV_64FC1 : CV_64FC2);
+	orth=scope.create(im.rows,im.cols,CV_64FC2);
+}
+
+GFD1::GFD1(const Mat& im,CFTPlan& plan,const CircleTable& table) : Descriptors(im), Biv(plan.getVec()) {
+	computeFromPlan(plan,table);
+}
+
+GFD1::GFD1(const Mat& im,CFTPlan& plan) : Descriptors(im), Biv(plan.getVec()) {
+	computeFromPlan(plan,*CircleTableCache::get(plan.getSize()));
+}
+
+GFD1::GFD1(const Mat& im,const DescriptorExtractor& extractor) : Descriptors(im), Biv(extractor.getVec()) {
+	CV_Assert(extractor.getType()==GFD1_DESCRIPTOR);
+	this->im=CFTPlan::cropToOddSize(im);
+	resize(extractor.getDescriptorSize());
+	extractor.extract(this->im,&(*this)[0]);
+}
+
+void GFD1::computeFromPlan(CFTPlan& plan,const CircleTable& table){
+	GCFD_PROFILE_SCOPE("GFD1/computeFeatures");
+	this->im=CFTPlan::cropToOddSize(this->im);
+	MatArenaScope scope;
+	Mat par,orth;
+	createSpectra(scope,this->im,par,orth);
+	resize(table.getNbCircles()+1);
+	if(this->im.channels()==3){
+		plan.executePacked(this->im,par);
+		table.integrateCCS(par,&(*this)[0]);
+	}
+	else{
+		plan.execute(this->im,par,orth);
+		table.integrate(par,&(*this)[0]);
+	}
+}
+
+GCFD1::GCFD1(const Mat& im,CFTPlan& plan,const CircleTable& table) : Descriptors(im), Biv(plan.getVec()) {
+	computeFromPlan(plan,table);
+}
+
+GCFD1::GCFD1(const Mat& im,CFTPlan& plan) : Descriptors(im), Biv(plan.getVec()) {
+	computeFromPlan(plan,*CircleTableCache::get(plan.getSize()));
+}
+
+GCFD1::GCFD1(const Mat& im,const DescriptorExtractor& extractor) : Descriptors(im), Biv(extractor.getVec()) {
+	CV_Assert(extractor.getType()==GCFD1_DESCRIPTOR);
+	this->im=CFTPlan::cropToOddSize(im);
+	resize(extractor.getDescriptorSize());
+	extractor.extract(this->im,&(*this)[0]);
+}
+
+void GCFD1::computeFromPlan(CFTPlan& plan,const CircleTable& table){
+	GCFD_PROFILE_SCOPE("GCFD1/computeFeatures");
+	this->im=CFTPlan::cropToOddSize(this->im);
+	MatArenaScope scope;
+	Mat par,orth;
+	createSpectra(scope,this->im,par,orth);
+	const int n=table.getNbCircles()+1;
+	resize(2*n);
+	if(this->im.channels()==3){
+		plan.executePacked(this->im,par,orth);
+		table.integrateCCS(par,&(*this)[0]);
+	}
+	else{
+		plan.execute(this->im,par,orth);
+		table.integrate(par,&(*this)[0]);
+	}
+	table.integrate(orth,&(*this)[n]);
+}
+
+GCFD3::GCFD3(const Mat& im,CFTPlan& plan,const CircleTable& table) : Descriptors(im), Biv(plan.getVec()) {
+	computeFromPlan(plan,table);
+}
+
+GCFD3::GCFD3(const Mat& im,CFTPlan& plan) : Descriptors(im), Biv(plan.getVec()) {
+	computeFromPlan(plan,*CircleTableCache::get(plan.getSize()));
+}
+
+GCFD3::GCFD3(const Mat& im,const DescriptorExtractor& extractor) : Descriptors(im), Biv(extractor.getVec()) {
+	CV_Assert(extractor.getType()==GCFD3_DESCRIPTOR);
+	this->im=CFTPlan::cropToOddSize(im);
+	resize(extractor.getDescriptorSize());
+	extractor.extract(this->im,&(*this)[0]);
+}
+
+void GCFD3::computeFromPlan(CFTPlan& plan,const CircleTable& table){
+	GCFD_PROFILE_SCOPE("GCFD3/computeFeatures");
+	this->im=CFTPlan::cropToOddSize(this->im);
+	MatArenaScope scope;
+	Mat par,orth;
+	createSpectra(scope,this->im,par,orth);
+	resize(table.getNbCircles()+1);
+	if(this->im.channels()==3){
+		plan.executePacked(this->im,par,orth);
+		table.integrateCCS(par,orth,&(*this)[0]);
+	}
+	else{
+		plan.execute(this->im,par,orth);
+		table.integrate(par,orth,&(*this)[0]);
+	}
+}
@@ -0,0 +1,185 @@
+/**
+ * \file FixedSizeKernel.cpp
+ * \brief Integration of the descriptors specialised for fixed sizes of images
+ * \version 1.0
+ * \date October 17, 2026
+ *
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the distribution
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "FixedSizeKernel.h"
+#include "Profiler.h"
+#include <algorithm>
+
+template<typename T> Ptr<FixedSizeKernelBase_<T> > FixedSizeKernelBase_<T>::create(const CircleTable& table){
+	const Size size=table.getSize();
+	if(size.width!=size.height || table.getNbCircles()!=size.width/2)
+		return Ptr<FixedSizeKernelBase_<T> >();
+	switch(size.width){
+	case 63:
+		return Ptr<FixedSizeKernelBase_<T> >(new FixedSizeKernel_<T,63>(table));
+	case 127:
+		return Ptr<FixedSizeKernelBase_<T> >(new FixedSizeKernel_<T,127>(table));
+	case 255:
+		return Ptr<FixedSizeKernelBase_<T> >(new FixedSizeKernel_<T,255>(table));
+	default:
+		return Ptr<FixedSizeKernelBase_<T> >();
+	}
+}
+
+template<typename T> FixedSizeKernelBase_<T>::~FixedSizeKernelBase_() {
+}
+
+template<typename T,int N> FixedSizeKernel_<T,N>::FixedSizeKernel_(const CircleTable& table){
+	CV_Assert(table.getSize()==Size(N,N) && table.getNbCircles()==NB_CIRCLES);
+	const int nbEntries=(int)table.entryCol.size();
+	const int nbHalf=(int)table.halfU.size();
+
+	// Entries of the complex spectra, grouped by circle in the order of CircleTable::accumulate
+	std::fill(fullStart,fullStart+NB_CIRCLES+1,0);
+	for(int e=0;e<nbEntries;e++)
+		fullStart[table.entryCircle[e]+1]++;
+	for(int k=0;k<NB_CIRCLES;k++)
+		fullStart[k+1]+=fullStart[k];
+	fullOffset.resize(nbEntries);
+	fullWeight.resize(nbEntries);
+	vector<int> next(fullStart,fullStart+NB_CIRCLES);
+	for(int u=0;u<N;u++){
+		for(int e=table.rowStart[u];e<table.rowStart[u+1];e++){
+			const int i=next[table.entryCircle[e]]++;
+			fullOffset[i]=2*(u*N+table.entryCol[e]);
+			fullWeight[i]=table.entryWeight[e];
+		}
+	}
+
+	// Entries of the packed spectra (see CircleTable::accumulateCCS), the null frequency apart
+	std::fill(halfStart,halfStart+NB_CIRCLES+1,0);
+	std::fill(nullWeight,nullWeight+NB_CIRCLES,0.);
+	for(int e=0;e<nbHalf;e++){
+		if(table.halfU[e]!=0 || table.halfV[e]!=0)
+			halfStart[table.halfCircle[e]+1]++;
+	}
+	for(int k=0;k<NB_CIRCLES;k++)
+		halfStart[k+1]+=halfStart[k];
+	halfRe.resize(halfStart[NB_CIRCLES]);
+	halfIm.resize(halfStart[NB_CIRCLES]);
+	halfWeight.resize(halfStart[NB_CIRCLES]);
+	next.assign(halfStart,halfStart+NB_CIRCLES);
+	for(int e=0;e<nbHalf;e++){
+		const int fu=table.halfU[e];
+		const int fv=table.halfV[e];
+		const int k=table.halfCircle[e];
+		if(fu==0 && fv==0){
+			nullWeight[k]+=table.halfWeight[e];
+			continue;
+		}
+		const int i=next[k]++;
+		if(fv>0){
+			halfRe[i]=(fu>=0 ? fu : fu+N)*N+2*fv-1;
+			halfIm[i]=halfRe[i]+1;
+		}
+		else{
+			halfRe[i]=(2*fu-1)*N;
+			halfIm[i]=2*fu*N;
+		}
+		halfWeight[i]=table.halfWeight[e];
+	}
+}
+
+template<typename T,int N> double FixedSizeKernel_<T,N>::accumulate(const T* x,double* sums) const{
+	const int* offset=&fullOffset[0];
+	const double* weight=&fullWeight[0];
+	for(int k=0;k<NB_CIRCLES;k++){
+		double s=0;
+		for(int e=fullStart[k];e<fullStart[k+1];e++){
+			const T* p=x+offset[e];
+			const T energy=p[0]*p[0]+p[1]*p[1];
+			s+=weight[e]*energy;
+		}
+		sums[k]+=s;
+	}
+	return (double)x[0]*x[0]+(double)x[1]*x[1];
+}
+
+template<typename T,int N> double FixedSizeKernel_<T,N>::accumulateCCS(const T* x,double* sums) const{
+	const int* re=&halfRe[0];
+	const int* im=&halfIm[0];
+	const double* weight=&halfWeight[0];
+	const double energy0=(double)x[0]*x[0];
+	for(int k=0;k<NB_CIRCLES;k++){
+		double s=nullWeight[k]*energy0;
+		for(int e=halfStart[k];e<halfStart[k+1];e++){
+			const double a=x[re[e]];
+			const double b=x[im[e]];
+			s+=weight[e]*(a*a+b*b);
+		}
+		sums[k]+=s;
+	}
+	return energy0;
+}
+
+template<typename T,int N> void FixedSizeKernel_<T,N>::normalize(const double& energy0,const double* sums,double* res){
+	res[0]=energy0;
+	for(int k=0;k<NB_CIRCLES;k++)
+		res[k+1]=sums[k]/energy0;
+}
+
+template<typename T,int N> void FixedSizeKernel_<T,N>::integrate(const DescriptorType& type,const Mat& par,const Mat& orth,double* res) const{
+	GCFD_PROFILE_SCOPE("MyTools/integrOnCircles");
+	const int complexType=CV_MAKETYPE(DataType<T>::depth,2);
+	CV_Assert(par.rows==N && par.cols==N && par.isContinuous() && (par.type()==complexType || par.type()==DataType<T>::depth));
+	double sums[NB_CIRCLES];
+	std::fill(sums,sums+NB_CIRCLES,0.);
+	double energy0=par.channels()==1 ? accumulateCCS(par.ptr<T>(),sums) : accumulate(par.ptr<T>(),sums);
+	if(type==GFD1_DESCRIPTOR){
+		normalize(energy0,sums,res);
+		return;
+	}
+	CV_Assert(orth.rows==N && orth.cols==N && orth.isContinuous() && orth.type()==complexType);
+	if(type==GCFD1_DESCRIPTOR){
+		normalize(energy0,sums,res);
+		std::fill(sums,sums+NB_CIRCLES,0.);
+		energy0=accumulate(orth.ptr<T>(),sums);
+		normalize(energy0,sums,res+NB_CIRCLES+1);
+		return;
+	}
+	energy0+=accumulate(orth.ptr<T>(),sums);
+	normalize(energy0,sums,res);
+}
+
+template<typename T,int N> Size FixedSizeKernel_<T,N>::getSize() const{
+	return Size(N,N);
+}
+
+template<typename T,int N> FixedSizeKernel_<T,N>::~FixedSizeKernel_() {
+}
+
+template class FixedSizeKernelBase_<float>;
+template class FixedSizeKernelBase_<double>;
+template class FixedSizeKernel_<float,63>;
+template class FixedSizeKernel_<double,63>;
+template class FixedSizeKernel_<float,127>;
+template class FixedSizeKernel_<double,127>;
+template class FixedSizeKernel_<float,255>;
+template class FixedSizeKernel_<double,255>;
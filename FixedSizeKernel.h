@@ -0,0 +1,138 @@
+/**
+ * \file FixedSizeKernel.h
+ * \brief Integration of the descriptors specialised for fixed sizes of images
+ * \version 1.0
+ * \date October 17, 2026
+ *
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the distribution
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FIXEDSIZEKERNEL_H_
+#define FIXEDSIZEKERNEL_H_
+
+#include <iostream>
+#include <opencv/cv.h>
+#include <opencv/highgui.h>
+#include <vector>
+#include "CircleTable.h"
+#include "DescriptorExtractor.h"
+
+using namespace cv;
+
+/*! \class FixedSizeKernelBase_
+   * \brief Interface of the integrations of the descriptors compiled for one size of spectrum
+   *
+   *  DescriptorExtractor_ asks create() for a kernel of its size and falls back to the
+   *  CircleTable when there is none. T is the precision of the spectra (float or double).
+   */
+template<typename T> class FixedSizeKernelBase_ {
+public:
+	/*!
+	 *  \brief Integrate the CFT of an image on the discrete circles
+	 *
+	 *  Gives the same descriptor as DescriptorBatch_::integrate with the table of the size.
+	 *
+	 *  \param type : The descriptor to compute
+	 *  \param par : The parallel part (complex, or packed for a RGB image), continuous
+	 *  \param orth : The orthogonal part (complex), continuous (not read for GFD1_DESCRIPTOR)
+	 *  \param res : The output, it must have DescriptorBatch_::getDescriptorSize() elements
+	 */
+	virtual void integrate(const DescriptorType& type,const Mat& par,const Mat& orth,double* res) const=0;
+	/*!
+	 *  \brief Get the size of the spectra
+	 *
+	 *  \return Return the size of the spectra handled by the kernel
+	 */
+	virtual Size getSize() const=0;
+	/*!
+	 *  \brief Create the kernel of the size of a table
+	 *
+	 *  Kernels are compiled for the square spectra of 63, 127 and 255 pixels, i.e. the images
+	 *  of 64, 127, 128 and 256 pixels once made odd.
+	 *
+	 *  \param table : The discrete circles of the size
+	 *  \return Return the kernel, or an empty pointer if there is none for this size
+	 */
+	static Ptr<FixedSizeKernelBase_<T> > create(const CircleTable& table);
+
+	virtual ~FixedSizeKernelBase_();
+};
+
+/*! \class FixedSizeKernel_
+   * \brief Integration of the descriptors of the spectra of N x N pixels (N odd)
+   *
+   *  The entries of the CircleTable are regrouped by circle, as offsets into the continuous
+   *  spectra: a circle is summed in a register without reading the row pointers, the steps and
+   *  the sizes of the Mat headers, and the loops on the N/2 circles have a constant count. The
+   *  packed spectra of RGB images are read without the branches of CircleTable::integrateCCS.
+   */
+template<typename T,int N> class FixedSizeKernel_ : public FixedSizeKernelBase_<T> {
+private:
+	enum {
+		NB_CIRCLES=N/2		/*!< Number of discrete circles */
+	};
+	int fullStart[NB_CIRCLES+1];	/*!< First entry of each circle in the complex spectra */
+	vector<int> fullOffset;			/*!< Offset of each entry in a complex spectrum (in T) */
+	vector<double> fullWeight;		/*!< Mask value of each entry */
+	int halfStart[NB_CIRCLES+1];	/*!< First entry of each circle in the packed spectra */
+	vector<int> halfRe;				/*!< Offset of the real part of each entry in a packed spectrum */
+	vector<int> halfIm;				/*!< Offset of the imaginary part of each entry in a packed spectrum */
+	vector<double> halfWeight;		/*!< Sum of the mask values of an entry and of its mirror */
+	double nullWeight[NB_CIRCLES];	/*!< Weight of the null frequency on each circle in the packed spectra */
+
+	/*!
+	 *  \brief Add the energy of a complex spectrum on each circle
+	 *
+	 *	\param x : The continuous spectrum (N x N complex values)
+	 *	\param sums : The energies on each circle are added to this array
+	 *	\return Return the energy at the null frequency
+	 */
+	double accumulate(const T* x,double* sums) const;
+	/*!
+	 *  \brief Add the energy of a packed spectrum on each circle
+	 *
+	 *	\param x : The continuous packed spectrum (N x N values, see RealFFT2)
+	 *	\param sums : The energies on each circle are added to this array
+	 *	\return Return the energy at the null frequency
+	 */
+	double accumulateCCS(const T* x,double* sums) const;
+	/*!
+	 *  \brief Write the energy at the null frequency and the energies of the circles divided by it
+	 */
+	static void normalize(const double& energy0,const double* sums,double* res);
+
+public:
+	/*!
+	 *  \brief Constructor of FixedSizeKernel_ class
+	 *
+	 *  \param table : The discrete circles of N x N spectra
+	 *
+	 */
+	FixedSizeKernel_(const CircleTable& table);
+	virtual void integrate(const DescriptorType& type,const Mat& par,const Mat& orth,double* res) const;
+	virtual Size getSize() const;
+	virtual ~FixedSizeKernel_();
+};
+
+#endif /* FIXEDSIZEKERNEL_H_ */
@@ -46,6 +46,9 @@
 #include "CFT.h"
 #include "Descriptors.h"
 #include "MyTools.h"
+#include "CFTPlan.h"
+#include "CircleTable.h"
+#include "DescriptorExtractor.h"
 #define _USE_MATH_DEFINES
 #include <cmath>
 #include <vector>
@@ -66,6 +69,10 @@ private:
 	 *  \return Return the GCFD3
 	 */
 	virtual vector<double> computeFeatures() const;
+	/*!
+	 *  \brief Compute the GCFD3 with a CFT plan and a circle table
+	 */
+	void computeFromPlan(CFTPlan& plan,const CircleTable& table);
 public:
 	/*!
 	     *  \brief Constructor of GCFD3 class
@@ -84,6 +91,38 @@ public:
 	     *
 	     */
 	GCFD3(const Mat& im,const Mat& Biv,const vector<Mat>& Dcircles);
+	/*!
+	     *  \brief Constructor of GCFD3 class using a CFT plan
+	     *
+	     *  The plan and the table are shared between all the images of the same size: nothing
+	     *  is recomputed from the color vector and the circles are not stored in the descriptor.
+	     *
+	     *  \param im : A color image
+	     *  \param plan : A CFT plan built for the image size once made odd and for the color vector
+	     *  \param table : The discrete circles compiled for the image size once made odd
+	     *
+	     */
+	GCFD3(const Mat& im,CFTPlan& plan,const CircleTable& table);
+	/*!
+	     *  \brief Constructor of GCFD3 class using a CFT plan and the shared circle table
+	     *
+	     *  The circle table of the image size is taken from CircleTableCache.
+	     *
+	     *  \param im : A color image
+	     *  \param plan : A CFT plan built for the image size once made odd and for the color vector
+	     *
+	     */
+	GCFD3(const Mat& im,CFTPlan& plan);
+	/*!
+	     *  \brief Constructor of GCFD3 class using an extractor
+	     *
+	     *  Adapter of DescriptorExtractor_::extract: the descriptor is computed in this object.
+	     *
+	     *  \param im : A color image
+	     *  \param extractor : An extractor of GCFD3 built for the image size
+	     *
+	     */
+	GCFD3(const Mat& im,const DescriptorExtractor& extractor);
 
 	virtual ~GCFD3();
 };
@@ -0,0 +1,121 @@
+/**
+ * \file MappedMat.cpp
+ * \brief Mat stored in a memory mapped file
+ * \version 1.0
+ * \date October 17, 2026
+ *
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the distribution
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "MappedMat.h"
+#include <cstdlib>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+MappedMat::MappedMat() : fd(-1), base(0), mapSize(0) {
+}
+
+MappedMat::MappedMat(const string& path,const int& rows,const int& cols,const int& type,const size_t& offset,const bool& writable) : fd(-1), base(0), mapSize(0) {
+	open(path,rows,cols,type,offset,writable);
+}
+
+void MappedMat::open(const string& path,const int& rows,const int& cols,const int& type,const size_t& offset,const bool& writable){
+	close();
+	fd=::open(path.c_str(),writable ? O_RDWR : O_RDONLY);
+	if(fd<0)
+		CV_Error(CV_StsError,"MappedMat: cannot open "+path);
+	map(path,rows,cols,type,offset,writable);
+}
+
+void MappedMat::create(const string& path,const int& rows,const int& cols,const int& type,const size_t& offset){
+	close();
+	fd=::open(path.c_str(),O_RDWR | O_CREAT,0644);
+	if(fd<0)
+		CV_Error(CV_StsError,"MappedMat: cannot create "+path);
+	if(ftruncate(fd,(off_t)(offset+(size_t)rows*cols*CV_ELEM_SIZE(type)))!=0){
+		close();
+		CV_Error(CV_StsError,"MappedMat: cannot resize "+path);
+	}
+	map(path,rows,cols,type,offset,true);
+}
+
+void MappedMat::createTemporary(const string& dir,const int& rows,const int& cols,const int& type){
+	close();
+	string pattern=dir+"/gcfdXXXXXX";
+	vector<char> name(pattern.begin(),pattern.end());
+	name.push_back(0);
+	fd=mkstemp(&name[0]);
+	if(fd<0)
+		CV_Error(CV_StsError,"MappedMat: cannot create a temporary file in "+dir);
+	unlink(&name[0]);
+	if(ftruncate(fd,(off_t)((size_t)rows*cols*CV_ELEM_SIZE(type)))!=0){
+		close();
+		CV_Error(CV_StsError,"MappedMat: no space for a temporary file in "+dir);
+	}
+	map(dir,rows,cols,type,0,true);
+}
+
+void MappedMat::map(const string& path,const int& rows,const int& cols,const int& type,const size_t& offset,const bool& writable){
+	CV_Assert(rows>0 && cols>0);
+	struct stat st;
+	size_t size=offset+(size_t)rows*cols*CV_ELEM_SIZE(type);
+	if(fstat(fd,&st)!=0 || (size_t)st.st_size<size){
+		close();
+		CV_Error(CV_StsError,"MappedMat: "+path+" is too small");
+	}
+	mapSize=size;
+	void* p=mmap(0,mapSize,writable ? PROT_READ | PROT_WRITE : PROT_READ,MAP_SHARED,fd,0);
+	if(p==MAP_FAILED){
+		close();
+		CV_Error(CV_StsError,"MappedMat: cannot map "+path);
+	}
+	base=(uchar*)p;
+	mat=Mat(rows,cols,type,base+offset);
+}
+
+void MappedMat::flush(){
+	if(base)
+		msync(base,mapSize,MS_SYNC);
+}
+
+void MappedMat::close(){
+	mat.release();
+	if(base)
+		munmap(base,mapSize);
+	if(fd>=0)
+		::close(fd);
+	fd=-1;
+	base=0;
+	mapSize=0;
+}
+
+Mat MappedMat::getMat() const{
+	return mat;
+}
+
+MappedMat::~MappedMat() {
+	close();
+}
@@ -0,0 +1,125 @@
+/**
+ * \file MappedMat.h
+ * \brief Mat stored in a memory mapped file
+ * \version 1.0
+ * \date October 17, 2026
+ *
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the distribution
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef MAPPEDMAT_H_
+#define MAPPEDMAT_H_
+
+#include <iostream>
+#include <opencv/cv.h>
+#include <opencv/highgui.h>
+#include <vector>
+#include <string>
+
+using namespace cv;
+
+/*! \class MappedMat
+   * \brief A Mat whose elements are in a memory mapped file
+   *
+   *  The file contains the elements row by row without padding, possibly after a header of
+   *  offset bytes (e.g. a raw image or the spectra of OutOfCoreCFT_). The system reads the pages
+   *  when they are used and writes back the modified ones, so a Mat much larger than the memory
+   *  can be processed by blocks of rows. The Mat given by getMat() is valid until close().
+   */
+class MappedMat {
+private:
+	int fd;				/*!< The file descriptor (or -1) */
+	uchar* base;		/*!< The mapping (or null) */
+	size_t mapSize;		/*!< Size of the mapping */
+	Mat mat;			/*!< Header on the elements */
+
+	/*!
+	 *  \brief Map a file which has been opened
+	 */
+	void map(const string& path,const int& rows,const int& cols,const int& type,const size_t& offset,const bool& writable);
+
+	MappedMat(const MappedMat&);
+	MappedMat& operator=(const MappedMat&);
+
+public:
+	MappedMat();
+	/*!
+	 *  \brief Constructor of MappedMat class, see open
+	 *
+	 */
+	MappedMat(const string& path,const int& rows,const int& cols,const int& type,const size_t& offset=0,const bool& writable=false);
+	/*!
+	 *  \brief Map an existing file
+	 *
+	 *  \param path : The file, it must contain at least offset+rows*cols*CV_ELEM_SIZE(type) bytes
+	 *  \param rows : The number of rows
+	 *  \param cols : The number of columns
+	 *  \param type : The type of the elements (e.g. CV_8UC3)
+	 *  \param offset : The position of the first element in the file
+	 *  \param writable : If true, the modifications of the Mat are written in the file
+	 */
+	void open(const string& path,const int& rows,const int& cols,const int& type,const size_t& offset=0,const bool& writable=false);
+	/*!
+	 *  \brief Create (or resize) a file and map it for writing
+	 *
+	 *  The first offset bytes of an existing file are kept, the elements are not initialized.
+	 *
+	 *  \param path : The file
+	 *  \param rows : The number of rows
+	 *  \param cols : The number of columns
+	 *  \param type : The type of the elements (e.g. CV_64FC2)
+	 *  \param offset : The position of the first element in the file
+	 */
+	void create(const string& path,const int& rows,const int& cols,const int& type,const size_t& offset=0);
+	/*!
+	 *  \brief Create a temporary file and map it for writing
+	 *
+	 *  The file is removed from the directory as soon as it is created, so its space is given
+	 *  back by close() even if the program is stopped.
+	 *
+	 *  \param dir : The directory of the file
+	 *  \param rows : The number of rows
+	 *  \param cols : The number of columns
+	 *  \param type : The type of the elements
+	 */
+	void createTemporary(const string& dir,const int& rows,const int& cols,const int& type);
+	/*!
+	 *  \brief Write the modified pages in the file
+	 */
+	void flush();
+	/*!
+	 *  \brief Unmap the file, the Mat given by getMat becomes invalid
+	 */
+	void close();
+	/*!
+	 *  \brief Get the elements
+	 *
+	 *  \return Return a continuous Mat on the mapping (empty if no file is mapped)
+	 */
+	Mat getMat() const;
+
+	virtual ~MappedMat();
+};
+
+#endif /* MAPPEDMAT_H_ */
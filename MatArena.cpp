@@ -0,0 +1,167 @@
+/**
+ * \file MatArena.cpp
+ * \brief Per-thread arena backing the Mat temporaries of a computation
+ * \version 1.0
+ * \date October 17, 2026
+ *
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the distribution
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "MatArena.h"
+#include <pthread.h>
+
+/*! Alignment of the Mat of the arenas (a cache line) */
+static const size_t arenaAlignment=64;
+
+static pthread_once_t arenaOnce=PTHREAD_ONCE_INIT;
+static pthread_key_t arenaKey;
+
+/*!
+ *  \brief Free the arena of a thread at its end
+ */
+static void destroyArena(void* arena){
+	delete (MatArena*)arena;
+}
+
+static void initArenaKey(){
+	pthread_key_create(&arenaKey,destroyArena);
+}
+
+MatArena::MatArena(const size_t& chunkSize) : chunkSize(chunkSize), current(0), offset(0), used(0) {
+	CV_Assert(chunkSize>0);
+	stats.allocations=0;
+	stats.bytes=0;
+	stats.chunkAllocations=0;
+	stats.peakBytes=0;
+	stats.capacity=0;
+}
+
+uchar* MatArena::allocate(const size_t& bytes){
+	for(;;){
+		if(current<(int)chunks.size()){
+			uchar* p=alignPtr(chunks[current]+offset,(int)arenaAlignment);
+			if(p+bytes<=chunks[current]+chunkSizes[current]){
+				offset=p+bytes-chunks[current];
+				stats.peakBytes=std::max(stats.peakBytes,used+offset);
+				return p;
+			}
+			if(current+1<(int)chunks.size()){
+				used+=chunkSizes[current];
+				current++;
+				offset=0;
+				continue;
+			}
+		}
+		// No chunk has room left: add one, large enough for the block once aligned
+		size_t size=std::max(chunkSize,bytes+arenaAlignment);
+		chunks.push_back((uchar*)fastMalloc(size));
+		chunkSizes.push_back(size);
+		stats.chunkAllocations++;
+		stats.capacity+=size;
+		if(chunks.size()>1){
+			used+=chunkSizes[current];
+			current=(int)chunks.size()-1;
+		}
+		offset=0;
+	}
+}
+
+void MatArena::rewind(const int& chunk,const size_t& offset,const size_t& used){
+	current=chunk;
+	this->offset=offset;
+	this->used=used;
+}
+
+Mat MatArena::create(const int& rows,const int& cols,const int& type){
+	CV_Assert(rows>=0 && cols>=0);
+	const size_t bytes=(size_t)rows*cols*CV_ELEM_SIZE(type);
+	stats.allocations++;
+	stats.bytes+=bytes;
+	return Mat(rows,cols,type,allocate(bytes));
+}
+
+void MatArena::reset(){
+	if(chunks.size()>1){
+		// The last computation did not fit in one chunk: the next one will
+		size_t total=0;
+		for(size_t c=0;c<chunks.size();c++){
+			total+=chunkSizes[c];
+			fastFree(chunks[c]);
+		}
+		chunks.assign(1,(uchar*)fastMalloc(total));
+		chunkSizes.assign(1,total);
+		stats.chunkAllocations++;
+		stats.capacity=total;
+	}
+	rewind(0,0,0);
+}
+
+MatArenaStats MatArena::getStats() const{
+	return stats;
+}
+
+void MatArena::resetStats(){
+	stats.allocations=0;
+	stats.bytes=0;
+	stats.chunkAllocations=0;
+	stats.peakBytes=used+offset;
+}
+
+MatArena& MatArena::getThreadArena(){
+	pthread_once(&arenaOnce,initArenaKey);
+	MatArena* arena=(MatArena*)pthread_getspecific(arenaKey);
+	if(!arena){
+		arena=new MatArena();
+		pthread_setspecific(arenaKey,arena);
+	}
+	return *arena;
+}
+
+MatArena::~MatArena() {
+	for(size_t c=0;c<chunks.size();c++)
+		fastFree(chunks[c]);
+}
+
+MatArenaScope::MatArenaScope() : arena(&MatArena::getThreadArena()) {
+	chunk=arena->current;
+	offset=arena->offset;
+	used=arena->used;
+}
+
+MatArenaScope::MatArenaScope(MatArena& arena) : arena(&arena) {
+	chunk=arena.current;
+	offset=arena.offset;
+	used=arena.used;
+}
+
+Mat MatArenaScope::create(const int& rows,const int& cols,const int& type){
+	return arena->create(rows,cols,type);
+}
+
+MatArenaScope::~MatArenaScope() {
+	if(chunk==0 && offset==0)
+		arena->reset();
+	else
+		arena->rewind(chunk,offset,used);
+}
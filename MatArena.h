@@ -0,0 +1,190 @@
+/**
+ * \file MatArena.h
+ * \brief Per-thread arena backing the Mat temporaries of a computation
+ * \version 1.0
+ * \date October 17, 2026
+ *
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the distribution
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef MATARENA_H_
+#define MATARENA_H_
+
+#include <iostream>
+#include <opencv/cv.h>
+#include <opencv/highgui.h>
+#include <vector>
+
+using namespace cv;
+
+/*!
+ *  \brief Counters of a MatArena
+ */
+struct MatArenaStats {
+	long long allocations;		/*!< Number of Mat created in the arena */
+	long long bytes;			/*!< Number of bytes of these Mat */
+	long long chunkAllocations;	/*!< Number of chunks allocated on the heap (the only calls to cv::fastMalloc) */
+	size_t peakBytes;			/*!< Largest memory used at a time */
+	size_t capacity;			/*!< Memory of the chunks */
+};
+
+class MatArenaScope;
+
+/*! \class MatArena
+   * \brief Bump allocator of the Mat temporaries of a computation
+   *
+   *  The temporaries are carved out of large chunks and wrap them with the user-data constructor
+   *  of Mat, so they are neither reference counted nor freed one by one: the whole arena is
+   *  reset at the end of the computation by moving back its position. Once the arena has
+   *  reached the size of a computation (the chunks are merged by reset), a computation does
+   *  not call the allocator anymore, which removes the contention of cv::fastMalloc between the
+   *  threads. The Mat created in the arena must not be used after the reset and must not be
+   *  reallocated (a create() of another size would leave the arena).
+   *
+   *  An arena is used by one thread: getThreadArena gives the arena of the calling thread,
+   *  which is freed at the end of the thread. See MatArenaScope.
+   *
+   *  In the library, the arena only backs the spectra of the constructors of GFD1, GCFD1 and
+   *  GCFD3 taking a CFTPlan and the rotated images of RotationAugmenter. CFTPlan_,
+   *  ColorPreprocessor_, DescriptorExtractor_ and DescriptorBatch_ do not use it: their buffers
+   *  live as long as the plan, the workspace or the scratch of the thread, so they are already
+   *  allocated once per size and a warm extraction does not call the allocator
+   *  (see bench/benchMatArena.cpp).
+   */
+class MatArena {
+private:
+	vector<uchar*> chunks;			/*!< The memory of the arena */
+	vector<size_t> chunkSizes;		/*!< The size of each chunk */
+	size_t chunkSize;				/*!< The smallest size of a new chunk */
+	int current;					/*!< The chunk in use */
+	size_t offset;					/*!< The first free byte of the current chunk */
+	size_t used;					/*!< The size of the chunks before the current one */
+	MatArenaStats stats;			/*!< The counters */
+
+	friend class MatArenaScope;
+	/*!
+	 *  \brief Take memory from the arena
+	 *
+	 *  \param bytes : The size of the block
+	 *  \return Return a block aligned on 64 bytes
+	 */
+	uchar* allocate(const size_t& bytes);
+	/*!
+	 *  \brief Move the position of the arena back
+	 *
+	 *  \param chunk : The chunk of the position
+	 *  \param offset : The offset of the position in the chunk
+	 *  \param used : The size of the chunks before this one
+	 */
+	void rewind(const int& chunk,const size_t& offset,const size_t& used);
+
+	MatArena(const MatArena&);
+	MatArena& operator=(const MatArena&);
+
+public:
+	/*!
+	 *  \brief Constructor of MatArena class
+	 *
+	 *  \param chunkSize : The smallest size of the chunks (a larger Mat gets a chunk of its size)
+	 *
+	 */
+	MatArena(const size_t& chunkSize=1<<20);
+	/*!
+	 *  \brief Create a Mat in the arena
+	 *
+	 *  \param rows : The number of rows
+	 *  \param cols : The number of columns
+	 *  \param type : The type
+	 *  \return Return a continuous Mat whose data belongs to the arena (not initialized)
+	 */
+	Mat create(const int& rows,const int& cols,const int& type);
+	/*!
+	 *  \brief Give back all the memory of the arena to its next temporaries
+	 *
+	 *  O(1) when the arena has a single chunk. If the last computation needed several chunks,
+	 *  they are replaced by one chunk of their total size.
+	 */
+	void reset();
+	/*!
+	 *  \brief Get the counters of the arena
+	 *
+	 *  \return Return the counters
+	 */
+	MatArenaStats getStats() const;
+	/*!
+	 *  \brief Reset the counters of allocations and the peak (the capacity is kept)
+	 */
+	void resetStats();
+	/*!
+	 *  \brief Get the arena of the calling thread
+	 *
+	 *  \return Return the arena of the thread, created at the first call
+	 */
+	static MatArena& getThreadArena();
+
+	virtual ~MatArena();
+};
+
+/*! \class MatArenaScope
+   * \brief Temporaries of a block of code, given back to the arena at the end of the block
+   *
+   *  The scopes can be nested: the destructor moves the arena back to its position at the
+   *  construction of the scope, and resets it when it was empty.
+   */
+class MatArenaScope {
+private:
+	MatArena* arena;	/*!< The arena */
+	int chunk;			/*!< The chunk of the position at the construction */
+	size_t offset;		/*!< The offset of the position at the construction */
+	size_t used;		/*!< The size of the chunks before this one at the construction */
+
+	MatArenaScope(const MatArenaScope&);
+	MatArenaScope& operator=(const MatArenaScope&);
+
+public:
+	/*!
+	 *  \brief Constructor of MatArenaScope class on the arena of the calling thread
+	 */
+	MatArenaScope();
+	/*!
+	 *  \brief Constructor of MatArenaScope class
+	 *
+	 *  \param arena : The arena
+	 *
+	 */
+	MatArenaScope(MatArena& arena);
+	/*!
+	 *  \brief Create a temporary, valid until the end of the scope
+	 *
+	 *  \param rows : The number of rows
+	 *  \param cols : The number of columns
+	 *  \param type : The type
+	 *  \return Return a continuous Mat whose data belongs to the arena (not initialized)
+	 */
+	Mat create(const int& rows,const int& cols,const int& type);
+
+	virtual ~MatArenaScope();
+};
+
+#endif /* MATARENA_H_ */
@@ -0,0 +1,324 @@
+/**
+ * \file MultiBivectorCFT.cpp
+ * \brief Color Clifford Fourier Transforms of an image for several bivectors from one transform of the color planes
+ * \version 1.0
+ * \date October 17, 2026
+ *
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the distribution
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "MultiBivectorCFT.h"
+#include "SimdTools.h"
+#include "CircleTableCache.h"
+#include "Profiler.h"
+
+/*!
+ *  \brief Unpack the spectrum of a real plane (see RealFFT2::unpack)
+ *
+ *  \param ccs : A packed spectrum of T
+ *  \param spec : The complex spectrum
+ */
+template<typename T> static void unpackCCS(const Mat& ccs,Mat& spec){
+	const int M=ccs.rows;
+	const int N=ccs.cols;
+	GCFD_PROFILE_CREATE(spec,M,N,CV_MAKETYPE(DataType<T>::depth,2));
+
+	// Columns 1 to (N-1)/2 are stored as complex pairs, the other half is given by F(u,v)=conj(F(-u,-v))
+	const int lastPair=(N-1)/2;
+	for(int u=0;u<M;u++){
+		const T* p=ccs.ptr<T>(u);
+		T* z=spec.ptr<T>(u);
+		T* m=spec.ptr<T>((M-u)%M);
+		for(int v=1;v<=lastPair;v++){
+			z[2*v]=p[2*v-1];
+			z[2*v+1]=p[2*v];
+			m[2*(N-v)]=p[2*v-1];
+			m[2*(N-v)+1]=-p[2*v];
+		}
+	}
+
+	// The first column (and the last one if N is even) is the packed spectrum of a real column
+	for(int c=0;c<(N%2==0 ? 2 : 1);c++){
+		const int col=c==0 ? 0 : N-1;
+		const int v=c==0 ? 0 : N/2;
+		spec.ptr<T>(0)[2*v]=ccs.ptr<T>(0)[col];
+		spec.ptr<T>(0)[2*v+1]=0;
+		for(int u=1;2*u<M;u++){
+			const T re=ccs.ptr<T>(2*u-1)[col];
+			const T im=ccs.ptr<T>(2*u)[col];
+			spec.ptr<T>(u)[2*v]=re;
+			spec.ptr<T>(u)[2*v+1]=im;
+			spec.ptr<T>(M-u)[2*v]=re;
+			spec.ptr<T>(M-u)[2*v+1]=-im;
+		}
+		if(M%2==0){
+			spec.ptr<T>(M/2)[2*v]=ccs.ptr<T>(M-1)[col];
+			spec.ptr<T>(M/2)[2*v+1]=0;
+		}
+	}
+}
+
+/*! Offsets of the vectors of a bivector in MultiBivectorCFT_::coef */
+enum { COEF_CN=0, COEF_VN=3, COEF_WN=6, COEF_SIZE=9 };
+
+template<typename T> MultiBivectorCFT_<T>::MultiBivectorCFT_() : rows(0), cols(0), nbChannels(0), unpacked(false) {
+}
+
+template<typename T> MultiBivectorCFT_<T>::MultiBivectorCFT_(const int& rows,const int& cols,const vector<Mat>& Bivs,const ColorPreprocessing& preprocessing)
+	: rows(rows), cols(cols), nbChannels(0), unpacked(false), Bivs(Bivs), coef(COEF_SIZE*Bivs.size()), planes(4), ccs(4), spectra(4), preprocessor(preprocessing) {
+	CV_Assert(rows>0 && cols>0 && !Bivs.empty());
+	for(size_t k=0;k<Bivs.size();k++){
+		double Cn[3],Vn[3],Wn[3];
+		CFTPlan::getBasis(Bivs[k],Cn,Vn,Wn);
+		T* c=&coef[COEF_SIZE*k];
+		for(int i=0;i<3;i++){
+			c[COEF_CN+i]=(T)Cn[i];
+			c[COEF_VN+i]=(T)Vn[i];
+			c[COEF_WN+i]=(T)Wn[i];
+		}
+	}
+	for(int c=0;c<4;c++)
+		GCFD_PROFILE_CREATE(planes[c],rows,cols,DataType<T>::depth);
+}
+
+template<typename T> void MultiBivectorCFT_<T>::split(const Mat& in){
+	GCFD_PROFILE_SCOPE("CFT/projection");
+	for(int i=0;i<rows;i++){
+		T* const x[4]={planes[0].ptr<T>(i),planes[1].ptr<T>(i),planes[2].ptr<T>(i),planes[3].ptr<T>(i)};
+		preprocessor.split(in,i,x);
+	}
+}
+
+template<typename T> void MultiBivectorCFT_<T>::transform(const Mat& in,const bool& orthogonal){
+	CV_Assert(in.rows==rows && in.cols==cols);
+	split(in);
+	GCFD_PROFILE_SCOPE("FFT2/computeFFT2");
+	// A gray image gives three equal color planes
+	nbChannels=ColorPreprocessor_<T>::hasAlpha(in.channels()) ? 4 : 3;
+	for(int c=0;c<nbChannels;c++){
+		GCFD_PROFILE_CREATE(ccs[c],rows,cols,planes[c].type());
+		dft(planes[c],ccs[c],0,0);
+	}
+	// The parallel part of a RGBA image is complex, so it needs the complex spectra too
+	unpacked=orthogonal || nbChannels==4;
+	if(unpacked)
+		for(int c=0;c<nbChannels;c++)
+			unpackCCS<T>(ccs[c],spectra[c]);
+}
+
+template<typename T> void MultiBivectorCFT_<T>::getParallel(const int& k,Mat& par) const{
+	GCFD_PROFILE_SCOPE("MultiBivectorCFT/combine");
+	CV_Assert(nbChannels>0 && k>=0 && k<getNbBivectors());
+	const T* Cn=&coef[COEF_SIZE*k+COEF_CN];
+	if(nbChannels==3){
+		// The real coefficients of Cn commute with the packing: the packed parallel part is a combination of the packed spectra
+		GCFD_PROFILE_CREATE(par,rows,cols,DataType<T>::depth);
+		for(int i=0;i<rows;i++)
+			SimdTools::combineReal(ccs[0].ptr<T>(i),ccs[1].ptr<T>(i),ccs[2].ptr<T>(i),Cn,par.ptr<T>(i),cols);
+		return;
+	}
+	// RGBA image: the parallel part is Cn.x+i alpha
+	GCFD_PROFILE_CREATE(par,rows,cols,CV_MAKETYPE(DataType<T>::depth,2));
+	for(int i=0;i<rows;i++){
+		T* z=par.ptr<T>(i);
+		const T* a=spectra[3].ptr<T>(i);
+		SimdTools::combineReal(spectra[0].ptr<T>(i),spectra[1].ptr<T>(i),spectra[2].ptr<T>(i),Cn,z,2*cols);
+		for(int j=0;j<2*cols;j+=2){
+			z[j]-=a[j+1];
+			z[j+1]+=a[j];
+		}
+	}
+}
+
+template<typename T> void MultiBivectorCFT_<T>::getCFT(const int& k,Mat& par,Mat& orth) const{
+	CV_Assert(unpacked);
+	getParallel(k,par);
+	GCFD_PROFILE_SCOPE("MultiBivectorCFT/combine");
+	// The orthogonal part is (Vn+i Wn).x, i.e. the sum of the spectra of the planes multiplied by the complex numbers Vn+i Wn
+	const T* Vn=&coef[COEF_SIZE*k+COEF_VN];
+	const T* Wn=&coef[COEF_SIZE*k+COEF_WN];
+	GCFD_PROFILE_CREATE(orth,rows,cols,CV_MAKETYPE(DataType<T>::depth,2));
+	for(int i=0;i<rows;i++){
+		const T* z0=spectra[0].ptr<T>(i);
+		const T* z1=spectra[1].ptr<T>(i);
+		const T* z2=spectra[2].ptr<T>(i);
+		T* o=orth.ptr<T>(i);
+		for(int j=0;j<2*cols;j+=2){
+			o[j]=Vn[0]*z0[j]+Vn[1]*z1[j]+Vn[2]*z2[j]-(Wn[0]*z0[j+1]+Wn[1]*z1[j+1]+Wn[2]*z2[j+1]);
+			o[j+1]=Vn[0]*z0[j+1]+Vn[1]*z1[j+1]+Vn[2]*z2[j+1]+Wn[0]*z0[j]+Wn[1]*z1[j]+Wn[2]*z2[j];
+		}
+	}
+}
+
+template<typename T> void MultiBivectorCFT_<T>::execute(const Mat& in,vector<Mat>& par,vector<Mat>& orth){
+	transform(in);
+	par.resize(Bivs.size());
+	orth.resize(Bivs.size());
+	for(int k=0;k<getNbBivectors();k++)
+		getCFT(k,par[k],orth[k]);
+}
+
+template<typename T> int MultiBivectorCFT_<T>::getNbBivectors() const{
+	return (int)Bivs.size();
+}
+
+template<typename T> Size MultiBivectorCFT_<T>::getSize() const{
+	return Size(cols,rows);
+}
+
+template<typename T> MultiBivectorCFT_<T>::~MultiBivectorCFT_() {
+}
+
+template class MultiBivectorCFT_<float>;
+template class MultiBivectorCFT_<double>;
+
+/*!
+ *  \brief Scratch used by one thread: the transform and the table are rebuilt only when the size changes
+ */
+template<typename T> struct MultiBivectorScratch {
+	MultiBivectorCFT_<T> cft;	/*!< The transform of the current size */
+	Ptr<const CircleTable> table;	/*!< The discrete circles of the current size, shared by CircleTableCache */
+	Mat par;					/*!< The parallel part of the CFT */
+	Mat orth;					/*!< The orthogonal part of the CFT */
+};
+
+/*! \class MultiBivectorBody
+   * \brief Body of the parallel loop of MultiBivectorDescriptors
+   */
+template<typename T> class MultiBivectorBody : public ParallelLoopBody {
+private:
+	MultiBivectorDescriptors_<T>* descriptors;	/*!< The object which owns the scratches */
+	const vector<Mat>* images;					/*!< The images */
+	vector<Mat>* res;							/*!< The descriptors, one Mat per bivector */
+public:
+	MultiBivectorBody(MultiBivectorDescriptors_<T>* descriptors,const vector<Mat>* images,vector<Mat>* res)
+		: descriptors(descriptors), images(images), res(res) {
+	}
+	virtual void operator()(const Range& range) const{
+		MultiBivectorScratch<T>* s=descriptors->acquireScratch();
+		const int nbBiv=(int)res->size();
+		const int D=(*res)[0].cols;
+		AutoBuffer<double> buffer(nbBiv*D);
+		AutoBuffer<double*> outputs(nbBiv);
+		for(int b=0;b<nbBiv;b++)
+			outputs[b]=(double*)buffer+b*D;
+		try{
+			for(int i=range.start;i<range.end;i++){
+				descriptors->computeOne((*images)[i],*s,outputs);
+				for(int b=0;b<nbBiv;b++){
+					T* row=(*res)[b].ptr<T>(i);
+					for(int k=0;k<D;k++)
+						row[k]=(T)outputs[b][k];
+				}
+			}
+		}
+		catch(...){
+			descriptors->releaseScratch(s);
+			throw;
+		}
+		descriptors->releaseScratch(s);
+	}
+};
+
+template<typename T> MultiBivectorDescriptors_<T>::MultiBivectorDescriptors_(const DescriptorType& type,const vector<Mat>& Bivs,const ColorPreprocessing& preprocessing) : type(type), preprocessing(preprocessing) {
+	CV_Assert(!Bivs.empty());
+	this->Bivs.resize(Bivs.size());
+	for(size_t k=0;k<Bivs.size();k++)
+		Bivs[k].convertTo(this->Bivs[k],CV_64F);
+}
+
+template<typename T> MultiBivectorScratch<T>* MultiBivectorDescriptors_<T>::acquireScratch(){
+	AutoLock lock(poolMutex);
+	if(pool.empty())
+		return new MultiBivectorScratch<T>();
+	MultiBivectorScratch<T>* s=pool.back();
+	pool.pop_back();
+	return s;
+}
+
+template<typename T> void MultiBivectorDescriptors_<T>::releaseScratch(MultiBivectorScratch<T>* s){
+	AutoLock lock(poolMutex);
+	pool.push_back(s);
+}
+
+template<typename T> void MultiBivectorDescriptors_<T>::computeOne(const Mat& im,MultiBivectorScratch<T>& s,double** res) const{
+	GCFD_PROFILE_SCOPE(descriptorStages[type]);
+	Mat X=CFTPlan::cropToOddSize(im);
+	if(s.cft.getSize()!=X.size()){
+		GCFD_PROFILE_SCOPE("Descriptors/buildPlan");
+		s.cft=MultiBivectorCFT_<T>(X.rows,X.cols,Bivs,preprocessing);
+		s.table=CircleTableCache::get(X.size());
+	}
+	s.cft.transform(X,type!=GFD1_DESCRIPTOR);
+	for(int k=0;k<getNbBivectors();k++){
+		if(type==GFD1_DESCRIPTOR)
+			s.cft.getParallel(k,s.par);
+		else
+			s.cft.getCFT(k,s.par,s.orth);
+		DescriptorBatch_<T>::integrate(type,*s.table,s.par,s.orth,res[k]);
+	}
+}
+
+template<typename T> vector<vector<double> > MultiBivectorDescriptors_<T>::compute(const Mat& im){
+	const int D=DescriptorBatch::getDescriptorSize(type,im.size());
+	vector<vector<double> > res(Bivs.size(),vector<double>(D));
+	AutoBuffer<double*> outputs(Bivs.size());
+	for(size_t k=0;k<Bivs.size();k++)
+		outputs[k]=&res[k][0];
+	MultiBivectorScratch<T>* s=acquireScratch();
+	try{
+		computeOne(im,*s,outputs);
+	}
+	catch(...){
+		releaseScratch(s);
+		throw;
+	}
+	releaseScratch(s);
+	return res;
+}
+
+template<typename T> vector<Mat> MultiBivectorDescriptors_<T>::compute(const vector<Mat>& images){
+	vector<Mat> res(Bivs.size());
+	if(images.empty())
+		return res;
+	int D=DescriptorBatch::getDescriptorSize(type,images[0].size());
+	for(size_t i=1;i<images.size();i++)
+		CV_Assert(DescriptorBatch::getDescriptorSize(type,images[i].size())==D);
+	for(size_t k=0;k<Bivs.size();k++)
+		res[k].create((int)images.size(),D,DataType<T>::depth);
+	parallel_for_(Range(0,(int)images.size()),MultiBivectorBody<T>(this,&images,&res),(double)images.size());
+	return res;
+}
+
+template<typename T> int MultiBivectorDescriptors_<T>::getNbBivectors() const{
+	return (int)Bivs.size();
+}
+
+template<typename T> MultiBivectorDescriptors_<T>::~MultiBivectorDescriptors_() {
+	for(size_t i=0;i<pool.size();i++)
+		delete pool[i];
+}
+
+template class MultiBivectorDescriptors_<float>;
+template class MultiBivectorDescriptors_<double>;
@@ -0,0 +1,221 @@
+/**
+ * \file MultiBivectorCFT.h
+ * \brief Color Clifford Fourier Transforms of an image for several bivectors from one transform of the color planes
+ * \version 1.0
+ * \date October 17, 2026
+ *
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the distribution
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef MULTIBIVECTORCFT_H_
+#define MULTIBIVECTORCFT_H_
+
+#include <iostream>
+#include <opencv/cv.h>
+#include <opencv/highgui.h>
+#include <vector>
+#include "CFTPlan.h"
+#include "CircleTable.h"
+#include "DescriptorBatch.h"
+
+using namespace cv;
+
+/*! \class MultiBivectorCFT_
+   * \brief Compute the CFT of an image for several bivectors at the cost of one transform
+   *
+   *  The parallel and orthogonal parts of the CFT are linear combinations of the color planes
+   *  of the image (see CFTPlan_::getBasis), and the DFT is linear: the spectra of the planes are
+   *  computed once by transform() (one real DFT per plane) and the parts for any bivector are
+   *  then linear combinations of these spectra, computed frequency by frequency by getCFT().
+   *  With n bivectors this replaces n projections and 2n complex DFTs by 3 real DFTs.
+   *
+   *  As for CFTPlan_, the parallel part of a RGB image is given in the packed format of RealFFT2.
+   *  An object is not thread safe: use one object per thread.
+   */
+template<typename T> class MultiBivectorCFT_ {
+private:
+	int rows;				/*!< Number of rows of the images */
+	int cols;				/*!< Number of columns of the images */
+	int nbChannels;			/*!< Number of channels of the last transformed image (0 if none) */
+	bool unpacked;			/*!< True if the complex spectra of the last transformed image have been computed */
+	vector<Mat> Bivs;		/*!< The color vectors used to build the bivectors B=Biv^e4 */
+	vector<T> coef;			/*!< Cn, Vn and Wn of each bivector (9 values per bivector, RGB order) */
+	vector<Mat> planes;		/*!< Work buffers: the color planes of the image divided by the range (RGB or RGBA order) */
+	vector<Mat> ccs;		/*!< The packed spectra of the color planes */
+	vector<Mat> spectra;	/*!< The complex spectra of the color planes */
+	ColorPreprocessor_<T> preprocessor;	/*!< The conversion of the images to the color planes */
+	/*!
+	 *  \brief Split an image in color planes divided by the range
+	 *
+	 *  \param in : A color image of the size of the object
+	 */
+	void split(const Mat& in);
+
+public:
+	MultiBivectorCFT_();
+	/*!
+	 *  \brief Constructor of MultiBivectorCFT_ class
+	 *
+	 *  \param rows : The number of rows of the images
+	 *  \param cols : The number of columns of the images
+	 *  \param Bivs : The color vectors used to build the bivectors B=Biv^e4
+	 *  \param preprocessing : The order of the channels and the scaling of the images (see ColorPreprocessor_)
+	 *
+	 */
+	MultiBivectorCFT_(const int& rows,const int& cols,const vector<Mat>& Bivs,const ColorPreprocessing& preprocessing=ColorPreprocessing());
+	/*!
+	 *  \brief Compute the spectra of the color planes of an image
+	 *
+	 *  \param in : A color image (1, 3 or 4 channels, uchar, float or double) of the size of the object
+	 *  \param orthogonal : If false, only the parallel parts of a RGB image can be given by getCFT
+	 */
+	void transform(const Mat& in,const bool& orthogonal=true);
+	/*!
+	 *  \brief Get the parallel and orthogonal parts of the CFT for a bivector
+	 *
+	 *  Gives the same parts as CFTPlan_::executePacked (RGB image) or CFTPlan_::execute
+	 *  (RGBA image) with the same color vector, up to the rounding errors.
+	 *
+	 *  \param k : The index of the bivector
+	 *  \param par : The parallel part of the CFT (packed for a RGB image, complex otherwise)
+	 *  \param orth : The orthogonal part of the CFT (a complex Mat of T)
+	 */
+	void getCFT(const int& k,Mat& par,Mat& orth) const;
+	/*!
+	 *  \brief Get the parallel part of the CFT for a bivector
+	 *
+	 *  \param k : The index of the bivector
+	 *  \param par : The parallel part of the CFT (packed for a RGB image, complex otherwise)
+	 */
+	void getParallel(const int& k,Mat& par) const;
+	/*!
+	 *  \brief Compute the CFT of an image for all the bivectors
+	 *
+	 *  \param in : A color image (3 or 4 channels, uchar, float or double) of the size of the object
+	 *  \param par : The parallel parts of the CFT, one per bivector
+	 *  \param orth : The orthogonal parts of the CFT, one per bivector
+	 */
+	void execute(const Mat& in,vector<Mat>& par,vector<Mat>& orth);
+	/*!
+	 *  \brief Get the number of bivectors
+	 *
+	 *  \return Return the number of color vectors given to the constructor
+	 */
+	int getNbBivectors() const;
+	/*!
+	 *  \brief Get the size of the images
+	 *
+	 *  \return Return the size of the images handled by the object
+	 */
+	Size getSize() const;
+
+	virtual ~MultiBivectorCFT_();
+};
+
+typedef MultiBivectorCFT_<double> MultiBivectorCFT;
+typedef MultiBivectorCFT_<float> MultiBivectorCFTf;
+
+template<typename T> struct MultiBivectorScratch;
+template<typename T> class MultiBivectorBody;
+
+/*! \class MultiBivectorDescriptors_
+   * \brief Compute the descriptors of images for several bivectors
+   *
+   *  The descriptors of all the bivectors are computed from one MultiBivectorCFT_ per image,
+   *  so computing them for n bivectors costs about as much as for one. The results are the ones
+   *  of DescriptorBatch_ (and of GFD1, GCFD1 and GCFD3) for each color vector.
+   */
+template<typename T> class MultiBivectorDescriptors_ {
+private:
+	DescriptorType type;					/*!< The descriptor computed for each image */
+	vector<Mat> Bivs;						/*!< The color vectors used to build the bivectors B=Biv^e4 */
+	ColorPreprocessing preprocessing;		/*!< The order of the channels and the scaling of the images */
+	vector<MultiBivectorScratch<T>*> pool;	/*!< The scratches which are not used by a thread */
+	Mutex poolMutex;						/*!< Protect the pool */
+
+	friend class MultiBivectorBody<T>;
+	/*!
+	 *  \brief Take a scratch from the pool (or create one)
+	 *
+	 *  \return Return a scratch which is used by only one thread
+	 */
+	MultiBivectorScratch<T>* acquireScratch();
+	/*!
+	 *  \brief Give back a scratch to the pool
+	 *
+	 *  \param s : A scratch given by acquireScratch
+	 */
+	void releaseScratch(MultiBivectorScratch<T>* s);
+	/*!
+	 *  \brief Compute the descriptors of one image
+	 *
+	 *  \param im : A color image
+	 *  \param s : The scratch of the thread
+	 *  \param res : The outputs, one per bivector, each with getDescriptorSize(type,im.size()) elements
+	 */
+	void computeOne(const Mat& im,MultiBivectorScratch<T>& s,double** res) const;
+
+	MultiBivectorDescriptors_(const MultiBivectorDescriptors_&);
+	MultiBivectorDescriptors_& operator=(const MultiBivectorDescriptors_&);
+
+public:
+	/*!
+	 *  \brief Constructor of MultiBivectorDescriptors_ class
+	 *
+	 *  \param type : The descriptor to compute
+	 *  \param Bivs : The color vectors used to build the bivectors B=Biv^e4
+	 *  \param preprocessing : The order of the channels and the scaling of the images (see ColorPreprocessor_)
+	 *
+	 */
+	MultiBivectorDescriptors_(const DescriptorType& type,const vector<Mat>& Bivs,const ColorPreprocessing& preprocessing=ColorPreprocessing());
+	/*!
+	 *  \brief Compute the descriptors of an image
+	 *
+	 *  \param im : A color image
+	 *  \return Return one descriptor per bivector
+	 */
+	vector<vector<double> > compute(const Mat& im);
+	/*!
+	 *  \brief Compute the descriptors of a set of images in parallel
+	 *
+	 *  All the images must give descriptors of the same size (see DescriptorBatch_::compute).
+	 *
+	 *  \param images : Color images
+	 *  \return Return one Mat of T per bivector, with one descriptor per row
+	 */
+	vector<Mat> compute(const vector<Mat>& images);
+	/*!
+	 *  \brief Get the number of bivectors
+	 *
+	 *  \return Return the number of color vectors given to the constructor
+	 */
+	int getNbBivectors() const;
+
+	virtual ~MultiBivectorDescriptors_();
+};
+
+typedef MultiBivectorDescriptors_<double> MultiBivectorDescriptors;
+typedef MultiBivectorDescriptors_<float> MultiBivectorDescriptorsf;
+
+#endif /* MULTIBIVECTORCFT_H_ */
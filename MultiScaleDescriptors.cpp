@@ -0,0 +1,165 @@
+/**
+ * \file MultiScaleDescriptors.cpp
+ * \brief Descriptors of an image at several scales from a single CFT
+ * \version 1.0
+ * \date October 17, 2026
+ *
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the distribution
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "MultiScaleDescriptors.h"
+#include "DescriptorBatch.h"
+#include "CircleTableCache.h"
+#include "Profiler.h"
+#include <cmath>
+
+/*! \class MultiScaleBody
+   * \brief Body of the parallel loop of MultiScaleDescriptors_::compute
+   */
+template<typename T> class MultiScaleBody : public ParallelLoopBody {
+private:
+	const MultiScaleDescriptors_<T>* descriptors;	/*!< The object which owns the workspaces */
+	const vector<Mat>* images;						/*!< The images */
+	Mat* res;										/*!< The descriptors, one per row */
+public:
+	MultiScaleBody(const MultiScaleDescriptors_<T>* descriptors,const vector<Mat>* images,Mat* res)
+		: descriptors(descriptors), images(images), res(res) {
+	}
+	virtual void operator()(const Range& range) const{
+		DescriptorWorkspace_<T>* workspace=descriptors->acquireWorkspace();
+		AutoBuffer<double> buffer(res->cols);
+		double* descriptor=buffer;
+		try{
+			for(int i=range.start;i<range.end;i++){
+				descriptors->extract((*images)[i],descriptor,*workspace);
+				T* row=res->ptr<T>(i);
+				for(int k=0;k<res->cols;k++)
+					row[k]=(T)descriptor[k];
+			}
+		}
+		catch(...){
+			descriptors->releaseWorkspace(workspace);
+			throw;
+		}
+		descriptors->releaseWorkspace(workspace);
+	}
+};
+
+template<typename T> MultiScaleDescriptors_<T>::MultiScaleDescriptors_(const DescriptorType& type,const Mat& Biv,const Size& size,const int& nbScales,const double& scaleFactor,const FFTBackend& backend)
+	: type(type), size(size.width-(size.width%2==0),size.height-(size.height%2==0)), backend(backend) {
+	CV_Assert(nbScales>0 && scaleFactor>0 && scaleFactor<1);
+	Biv.convertTo(this->Biv,CV_64F);
+	offsets.assign(1,0);
+	for(int k=0;k<nbScales;k++){
+		double f=std::pow(scaleFactor,k);
+		Size s(cvRound(size.width*f),cvRound(size.height*f));
+		s=Size(s.width-(s.width%2==0),s.height-(s.height%2==0));
+		if(std::min(s.width,s.height)<3)
+			CV_Error(CV_StsBadArg,"MultiScaleDescriptors: the coarsest scale is smaller than 3x3 pixels");
+		double areaRatio=(double)s.area()/this->size.area();
+		scaleSizes.push_back(s);
+		tables.push_back(CircleTableCache::get(s));
+		energyScales.push_back(areaRatio*areaRatio);
+		offsets.push_back(offsets.back()+DescriptorBatch_<T>::getDescriptorSize(type,s));
+	}
+	id=DescriptorWorkspace_<T>::newOwnerId();
+}
+
+template<typename T> DescriptorWorkspace_<T>* MultiScaleDescriptors_<T>::acquireWorkspace() const{
+	AutoLock lock(poolMutex);
+	if(pool.empty())
+		return new DescriptorWorkspace_<T>();
+	DescriptorWorkspace_<T>* workspace=pool.back();
+	pool.pop_back();
+	return workspace;
+}
+
+template<typename T> void MultiScaleDescriptors_<T>::releaseWorkspace(DescriptorWorkspace_<T>* workspace) const{
+	AutoLock lock(poolMutex);
+	pool.push_back(workspace);
+}
+
+template<typename T> void MultiScaleDescriptors_<T>::extract(const Mat& im,double* res,DescriptorWorkspace_<T>& workspace) const{
+	GCFD_PROFILE_SCOPE("MultiScale/extract");
+	Mat X=CFTPlan::cropToOddSize(im);
+	CV_Assert(X.size()==size);
+	workspace.preparePlan(id,size,Biv,backend);
+	DescriptorBatch_<T>::transform(type,workspace.plan,X,workspace.par,workspace.orth);
+	for(int k=0;k<getNbScales();k++){
+		const CircleTable& table=*tables[k];
+		double* r=res+offsets[k];
+		DescriptorBatch_<T>::integrate(type,table,workspace.par,workspace.orth,r);
+		r[0]*=energyScales[k];
+		if(type==GCFD1_DESCRIPTOR)
+			r[table.getNbCircles()+1]*=energyScales[k];
+	}
+}
+
+template<typename T> void MultiScaleDescriptors_<T>::extract(const Mat& im,double* res) const{
+	DescriptorWorkspace_<T>* workspace=acquireWorkspace();
+	try{
+		extract(im,res,*workspace);
+	}
+	catch(...){
+		releaseWorkspace(workspace);
+		throw;
+	}
+	releaseWorkspace(workspace);
+}
+
+template<typename T> vector<double> MultiScaleDescriptors_<T>::compute(const Mat& im) const{
+	vector<double> res(getDescriptorSize());
+	extract(im,&res[0]);
+	return res;
+}
+
+template<typename T> Mat MultiScaleDescriptors_<T>::compute(const vector<Mat>& images) const{
+	Mat res((int)images.size(),getDescriptorSize(),DataType<T>::depth);
+	parallel_for_(Range(0,res.rows),MultiScaleBody<T>(this,&images,&res),res.rows);
+	return res;
+}
+
+template<typename T> int MultiScaleDescriptors_<T>::getDescriptorSize() const{
+	return offsets.back();
+}
+
+template<typename T> int MultiScaleDescriptors_<T>::getNbScales() const{
+	return (int)scaleSizes.size();
+}
+
+template<typename T> Size MultiScaleDescriptors_<T>::getScaleSize(const int& k) const{
+	return scaleSizes[k];
+}
+
+template<typename T> int MultiScaleDescriptors_<T>::getScaleOffset(const int& k) const{
+	return offsets[k];
+}
+
+template<typename T> MultiScaleDescriptors_<T>::~MultiScaleDescriptors_() {
+	for(size_t i=0;i<pool.size();i++)
+		delete pool[i];
+}
+
+template class MultiScaleDescriptors_<float>;
+template class MultiScaleDescriptors_<double>;
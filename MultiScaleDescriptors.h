@@ -0,0 +1,172 @@
+/**
+ * \file MultiScaleDescriptors.h
+ * \brief Descriptors of an image at several scales from a single CFT
+ * \version 1.0
+ * \date October 17, 2026
+ *
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the distribution
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef MULTISCALEDESCRIPTORS_H_
+#define MULTISCALEDESCRIPTORS_H_
+
+#include <iostream>
+#include <opencv/cv.h>
+#include <opencv/highgui.h>
+#include <vector>
+#include "DescriptorExtractor.h"
+
+using namespace cv;
+
+template<typename T> class MultiScaleBody;
+
+/*! \class MultiScaleDescriptors_
+   * \brief Compute the descriptors of an image pyramid from the CFT of its base level
+   *
+   *  The DFT of an image reduced by a factor f, with an ideal low-pass filter, is the central
+   *  part of the DFT of the image divided by f^2: the frequency (u,v) of the reduced image
+   *  is the frequency (u,v) of the image, both counting cycles per image. So the descriptor of
+   *  scale k is the integration of the CFT of the base level on the circles of the reduced size
+   *  (see CircleTable::integrate on a larger spectrum), and only the CFT of the base level is
+   *  computed. The energy at the null frequency is multiplied by the square of the ratio of the
+   *  areas, as if the reduced image had been computed, and the energies on the circles, divided
+   *  by it, do not depend on the scaling.
+   *
+   *  The descriptors of the scales are concatenated, from the base level to the coarsest one.
+   *  They differ from the ones of an image reduced by cv::resize only by the filter of the
+   *  reduction (see bench/benchMultiScale.cpp).
+   *
+   *  T is the precision of the spectra (float or double), see CFTPlan_.
+   */
+template<typename T> class MultiScaleDescriptors_ {
+private:
+	DescriptorType type;						/*!< The descriptor computed at each scale */
+	Mat Biv;									/*!< A color vector used to build the bivector B=Biv^e4 */
+	Size size;									/*!< The size of the base level once made odd */
+	FFTBackend backend;							/*!< The implementation of the DFTs of the plans */
+	vector<Size> scaleSizes;					/*!< The size of each scale, once made odd */
+	vector<Ptr<const CircleTable> > tables;		/*!< The discrete circles of each scale */
+	vector<int> offsets;						/*!< The first value of each scale in the descriptor (nbScales+1 elements) */
+	vector<double> energyScales;				/*!< The factor of the energy at the null frequency of each scale */
+	int id;										/*!< A number which identifies the object in the workspaces */
+	mutable vector<DescriptorWorkspace_<T>*> pool;	/*!< The workspaces of extract(im,res) which are not used by a thread */
+	mutable Mutex poolMutex;					/*!< Protect the pool */
+
+	/*!
+	 *  \brief Take a workspace from the pool (or create one)
+	 *
+	 *  \return Return a workspace which is used by only one thread
+	 */
+	DescriptorWorkspace_<T>* acquireWorkspace() const;
+	/*!
+	 *  \brief Give back a workspace to the pool
+	 *
+	 *  \param workspace : A workspace given by acquireWorkspace
+	 */
+	void releaseWorkspace(DescriptorWorkspace_<T>* workspace) const;
+
+	friend class MultiScaleBody<T>;
+
+	MultiScaleDescriptors_(const MultiScaleDescriptors_&);
+	MultiScaleDescriptors_& operator=(const MultiScaleDescriptors_&);
+
+public:
+	/*!
+	 *  \brief Constructor of MultiScaleDescriptors_ class
+	 *
+	 *  The scale k has the size of the base level multiplied by scaleFactor^k (rounded), it must
+	 *  be at least 3x3 pixels.
+	 *
+	 *  \param type : The descriptor computed at each scale
+	 *  \param Biv : A color vector used to build the bivector B=Biv^e4
+	 *  \param size : The size of the images (the images of the same size once made odd are also accepted)
+	 *  \param nbScales : The number of scales, including the base level
+	 *  \param scaleFactor : The ratio of the sizes of two successive scales (in ]0,1[)
+	 *  \param backend : The implementation of the DFTs (see BatchFFT_)
+	 *
+	 */
+	MultiScaleDescriptors_(const DescriptorType& type,const Mat& Biv,const Size& size,const int& nbScales,const double& scaleFactor=0.5,const FFTBackend& backend=FFT_BACKEND_AUTO);
+	/*!
+	 *  \brief Compute the pyramid descriptor of an image with the workspace of the caller
+	 *
+	 *  \param im : A color image (3 or 4 channels, uchar, float or double)
+	 *  \param res : The output, it must have getDescriptorSize() elements
+	 *  \param workspace : A workspace used by no other thread during the call
+	 */
+	void extract(const Mat& im,double* res,DescriptorWorkspace_<T>& workspace) const;
+	/*!
+	 *  \brief Compute the pyramid descriptor of an image with a workspace of the object
+	 *
+	 *  \param im : A color image (3 or 4 channels, uchar, float or double)
+	 *  \param res : The output, it must have getDescriptorSize() elements
+	 */
+	void extract(const Mat& im,double* res) const;
+	/*!
+	 *  \brief Compute the pyramid descriptor of an image
+	 *
+	 *  \param im : A color image (3 or 4 channels, uchar, float or double)
+	 *  \return Return the descriptors of all the scales
+	 */
+	vector<double> compute(const Mat& im) const;
+	/*!
+	 *  \brief Compute the pyramid descriptors of a set of images in parallel
+	 *
+	 *  \param images : Color images of the size of the object
+	 *  \return Return a Mat of T with one pyramid descriptor per row
+	 */
+	Mat compute(const vector<Mat>& images) const;
+	/*!
+	 *  \brief Get the number of values of a pyramid descriptor
+	 *
+	 *  \return Return the sum of the sizes of the descriptors of all the scales
+	 */
+	int getDescriptorSize() const;
+	/*!
+	 *  \brief Get the number of scales
+	 *
+	 *  \return Return the number of scales, including the base level
+	 */
+	int getNbScales() const;
+	/*!
+	 *  \brief Get the size of the images of a scale
+	 *
+	 *  \param k : A scale (0 for the base level)
+	 *  \return Return the size of the reduced image, once made odd
+	 */
+	Size getScaleSize(const int& k) const;
+	/*!
+	 *  \brief Get the position of the descriptor of a scale in the pyramid descriptor
+	 *
+	 *  \param k : A scale (0 for the base level)
+	 *  \return Return the index of the first value of the scale
+	 */
+	int getScaleOffset(const int& k) const;
+
+	virtual ~MultiScaleDescriptors_();
+};
+
+typedef MultiScaleDescriptors_<double> MultiScaleDescriptors;
+typedef MultiScaleDescriptors_<float> MultiScaleDescriptorsf;
+
+#endif /* MULTISCALEDESCRIPTORS_H_ */
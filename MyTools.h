@@ -168,6 +168,7 @@ public:
 	*	\param im A gray level image in cartesian coordinates
 	*	\param method If method=="full", all the image is considered and the missing parts are set to 0. If method=="crop", the image is cropped to a circle.
 	*	\return Return a gray level polar image
+	*	\see PolarMapper to convert many images of the same size
 	*/
 	static Mat imCart2Pol(const Mat& im,const string& method);
 	static Mat imCart2Pol(const Mat& im,const string& method, vector<double>& center);
@@ -177,6 +178,7 @@ public:
 	*	\param im : A color image in cartesian coordinates
 	*	\param method : If method=="full", all the image is considered and the missing parts are set to 0. If method=="crop", the image is cropped to a circle.
 	*	\return Return color polar image
+	*	\see PolarMapper to convert many images of the same size
 	*/
 	static Mat colImCart2Pol(const Mat& im,const string& method);
 	static Mat colImCart2Pol(const Mat& im,const string& method, vector<double> center);
@@ -0,0 +1,359 @@
+/**
+ * \file OutOfCoreCFT.cpp
+ * \brief Color Clifford Fourier Transform of images larger than the memory
+ * \version 1.0
+ * \date October 17, 2026
+ *
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the distribution
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "OutOfCoreCFT.h"
+#include "Profiler.h"
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+/*! Number of rows transformed by one call of the DFT in the row passes */
+static const int rowChunk=16;
+/*! Number of columns transformed by one call of the DFT in the column pass */
+static const int colChunk=8;
+
+/*!
+ *  \brief Scratch used by one thread
+ */
+template<typename T> struct OutOfCoreScratch {
+	BatchFFT_<T> rowFFT;		/*!< DFT of rowChunk rows */
+	BatchFFT_<T> colFFT;		/*!< DFT of colChunk columns */
+	Mat buffer;					/*!< The rows of both parts (2*rowChunk rows) */
+	Mat planes;					/*!< Work buffer of the preprocessor (4 rows of planes) */
+	vector<double> parGain;		/*!< The gains of a column of the parallel part */
+	vector<double> orthGain;	/*!< The gains of a column of the orthogonal part */
+};
+
+/*! \class OutOfCoreRowBody
+   * \brief Body of the parallel loops of the row passes
+   */
+template<typename T> class OutOfCoreRowBody : public ParallelLoopBody {
+private:
+	OutOfCoreCFT_<T>* cft;		/*!< The transform which owns the scratches */
+	Mat* image;					/*!< The input image, or the output one for the inverse */
+	Mat* par;					/*!< The parallel part */
+	Mat* orth;					/*!< The orthogonal part */
+	bool inverse;				/*!< Inverse DFT and reconstruction instead of projection and DFT */
+public:
+	OutOfCoreRowBody(OutOfCoreCFT_<T>* cft,Mat* image,Mat* par,Mat* orth,const bool& inverse)
+		: cft(cft), image(image), par(par), orth(orth), inverse(inverse) {
+	}
+	/*!
+	 *  \brief Project rows of the image in the buffer
+	 */
+	void project(const int& start,const int& n,T* p,T* o,T* planes) const{
+		const int cols=image->cols;
+		for(int i=0;i<n;i++,p+=2*cols,o+=2*cols)
+			cft->preprocessor.project(*image,start+i,p,2,o,planes);
+	}
+	/*!
+	 *  \brief Reconstruct rows of the image from the buffer
+	 */
+	void reconstruct(const int& start,const int& n,const T* p,const T* o) const{
+		const int cols=image->cols;
+		for(int i=0;i<n;i++,p+=2*cols,o+=2*cols)
+			cft->preprocessor.reconstruct(p,o,*image,start+i);
+	}
+	virtual void operator()(const Range& range) const{
+		GCFD_PROFILE_SCOPE("OutOfCore/rows");
+		OutOfCoreScratch<T>* s=cft->acquireScratch();
+		const size_t rowSize=2*image->cols*sizeof(T);
+		try{
+			for(int start=range.start;start<range.end;start+=rowChunk){
+				const int n=std::min(rowChunk,range.end-start);
+				Mat p=s->buffer.rowRange(0,n);
+				Mat o=s->buffer.rowRange(rowChunk,rowChunk+n);
+				if(inverse){
+					for(int i=0;i<n;i++){
+						memcpy(p.ptr<T>(i),par->ptr<T>(start+i),rowSize);
+						memcpy(o.ptr<T>(i),orth->ptr<T>(start+i),rowSize);
+					}
+					s->rowFFT.execute(p,p,DFT_INVERSE | DFT_SCALE);
+					s->rowFFT.execute(o,o,DFT_INVERSE | DFT_SCALE);
+					reconstruct(start,n,p.ptr<T>(0),o.ptr<T>(0));
+				}
+				else{
+					project(start,n,p.ptr<T>(0),o.ptr<T>(0),s->planes.template ptr<T>(0));
+					s->rowFFT.execute(p,p);
+					s->rowFFT.execute(o,o);
+					for(int i=0;i<n;i++){
+						memcpy(par->ptr<T>(start+i),p.ptr<T>(i),rowSize);
+						memcpy(orth->ptr<T>(start+i),o.ptr<T>(i),rowSize);
+					}
+				}
+			}
+		}
+		catch(...){
+			cft->releaseScratch(s);
+			throw;
+		}
+		cft->releaseScratch(s);
+	}
+};
+
+/*! \class OutOfCoreStripBody
+   * \brief Body of the parallel loops which transpose a block of columns to the buffer and back
+   */
+template<typename T> class OutOfCoreStripBody : public ParallelLoopBody {
+private:
+	Mat* par;			/*!< The parallel part */
+	Mat* orth;			/*!< The orthogonal part */
+	Mat* buffer;		/*!< The columns, one per row: the parallel part then the orthogonal part from the row blockCols */
+	int start;			/*!< The first column of the block */
+	int n;				/*!< The number of columns of the block */
+	bool toBuffer;		/*!< Copy the parts to the buffer (or the buffer to the parts) */
+public:
+	OutOfCoreStripBody(Mat* par,Mat* orth,Mat* buffer,const int& start,const int& n,const bool& toBuffer)
+		: par(par), orth(orth), buffer(buffer), start(start), n(n), toBuffer(toBuffer) {
+	}
+	virtual void operator()(const Range& range) const{
+		GCFD_PROFILE_SCOPE("OutOfCore/transpose");
+		const int half=buffer->rows/2;
+		for(int u=range.start;u<range.end;u++){
+			T* p=par->ptr<T>(u)+2*start;
+			T* o=orth->ptr<T>(u)+2*start;
+			for(int j=0;j<n;j++){
+				T* bp=buffer->ptr<T>(j)+2*u;
+				T* bo=buffer->ptr<T>(half+j)+2*u;
+				if(toBuffer){
+					bp[0]=p[2*j];
+					bp[1]=p[2*j+1];
+					bo[0]=o[2*j];
+					bo[1]=o[2*j+1];
+				}
+				else{
+					p[2*j]=bp[0];
+					p[2*j+1]=bp[1];
+					o[2*j]=bo[0];
+					o[2*j+1]=bo[1];
+				}
+			}
+		}
+	}
+};
+
+/*! \class OutOfCoreColumnBody
+   * \brief Body of the parallel loop which transforms the columns of the buffer
+   */
+template<typename T> class OutOfCoreColumnBody : public ParallelLoopBody {
+private:
+	OutOfCoreCFT_<T>* cft;			/*!< The transform which owns the scratches */
+	Mat* buffer;					/*!< The columns (see OutOfCoreStripBody) */
+	int start;						/*!< The first column of the block in the spectrum */
+	bool forward;					/*!< Compute the DFT */
+	const FrequencyMask* mask;		/*!< The gains (or null) */
+	bool inverse;					/*!< Compute the inverse DFT */
+public:
+	OutOfCoreColumnBody(OutOfCoreCFT_<T>* cft,Mat* buffer,const int& start,const bool& forward,const FrequencyMask* mask,const bool& inverse)
+		: cft(cft), buffer(buffer), start(start), forward(forward), mask(mask), inverse(inverse) {
+	}
+	virtual void operator()(const Range& range) const{
+		GCFD_PROFILE_SCOPE("OutOfCore/columns");
+		OutOfCoreScratch<T>* s=cft->acquireScratch();
+		const int half=buffer->rows/2;
+		const int rows=buffer->cols;
+		try{
+			for(int j0=range.start;j0<range.end;j0+=colChunk){
+				const int n=std::min(colChunk,range.end-j0);
+				Mat p=buffer->rowRange(j0,j0+n);
+				Mat o=buffer->rowRange(half+j0,half+j0+n);
+				if(forward){
+					s->colFFT.execute(p,p);
+					s->colFFT.execute(o,o);
+				}
+				if(mask){
+					for(int j=0;j<n;j++){
+						mask->getColumn(start+j0+j,Size(cft->cols,cft->rows),&s->parGain[0],&s->orthGain[0]);
+						T* x=p.ptr<T>(j);
+						T* y=o.ptr<T>(j);
+						for(int u=0;u<rows;u++){
+							x[2*u]*=(T)s->parGain[u];
+							x[2*u+1]*=(T)s->parGain[u];
+							y[2*u]*=(T)s->orthGain[u];
+							y[2*u+1]*=(T)s->orthGain[u];
+						}
+					}
+				}
+				if(inverse){
+					s->colFFT.execute(p,p,DFT_INVERSE | DFT_SCALE);
+					s->colFFT.execute(o,o,DFT_INVERSE | DFT_SCALE);
+				}
+			}
+		}
+		catch(...){
+			cft->releaseScratch(s);
+			throw;
+		}
+		cft->releaseScratch(s);
+	}
+};
+
+FrequencyMask::~FrequencyMask() {
+}
+
+RadialBandMask::RadialBandMask(const double& low,const double& high,const int& parts) : low(low), high(high), parts(parts) {
+}
+
+void RadialBandMask::getColumn(const int& v,const Size& size,double* parGain,double* orthGain) const{
+	const double fv=(double)(v<=size.width/2 ? v : v-size.width)/size.width;
+	for(int u=0;u<size.height;u++){
+		const double fu=(double)(u<=size.height/2 ? u : u-size.height)/size.height;
+		const double r=std::sqrt(fu*fu+fv*fv);
+		const double gain=r>=low && r<=high ? 1 : 0;
+		parGain[u]=parts & MASK_PARALLEL ? gain : 1;
+		orthGain[u]=parts & MASK_ORTHOGONAL ? gain : 1;
+	}
+}
+
+RadialBandMask::~RadialBandMask() {
+}
+
+OutOfCoreConfig::OutOfCoreConfig() : memoryBudget(256<<20), backend(FFT_BACKEND_AUTO) {
+}
+
+template<typename T> OutOfCoreCFT_<T>::OutOfCoreCFT_(const int& rows,const int& cols,const Mat& Vec,const OutOfCoreConfig& config,const ColorPreprocessing& preprocessing)
+	: rows(rows), cols(cols), config(config), preprocessor(Vec,preprocessing) {
+	CV_Assert(rows>0 && cols>0);
+	// The buffer of the column pass holds blockCols columns of both complex parts
+	size_t columnSize=4*(size_t)rows*sizeof(T);
+	blockCols=(int)std::max((size_t)1,std::min((size_t)cols,config.memoryBudget/columnSize));
+}
+
+template<typename T> OutOfCoreScratch<T>* OutOfCoreCFT_<T>::acquireScratch(){
+	AutoLock lock(poolMutex);
+	if(!pool.empty()){
+		OutOfCoreScratch<T>* s=pool.back();
+		pool.pop_back();
+		return s;
+	}
+	OutOfCoreScratch<T>* s=new OutOfCoreScratch<T>();
+	s->rowFFT=BatchFFT_<T>(1,cols,rowChunk,config.backend);
+	s->colFFT=BatchFFT_<T>(1,rows,colChunk,config.backend);
+	s->buffer.create(2*rowChunk,cols,CV_MAKETYPE(DataType<T>::depth,2));
+	s->planes.create(4,cols,DataType<T>::depth);
+	s->parGain.resize(rows);
+	s->orthGain.resize(rows);
+	return s;
+}
+
+template<typename T> void OutOfCoreCFT_<T>::releaseScratch(OutOfCoreScratch<T>* s){
+	AutoLock lock(poolMutex);
+	pool.push_back(s);
+}
+
+template<typename T> void OutOfCoreCFT_<T>::forwardRows(const Mat& in,Mat& par,Mat& orth){
+	CV_Assert(in.rows==rows && in.cols==cols && (in.channels()==3 || in.channels()==4));
+	if(in.depth()!=CV_8U && in.depth()!=CV_32F && in.depth()!=CV_64F)
+		CV_Error(CV_StsUnsupportedFormat,"OutOfCoreCFT: the image must be of uchar, float or double");
+	Mat image=in;
+	parallel_for_(Range(0,rows),OutOfCoreRowBody<T>(this,&image,&par,&orth,false));
+}
+
+template<typename T> void OutOfCoreCFT_<T>::inverseRows(const Mat& par,const Mat& orth,Mat& out){
+	if(out.empty())
+		out.create(rows,cols,CV_8UC3);
+	CV_Assert(out.rows==rows && out.cols==cols && (out.channels()==3 || out.channels()==4));
+	if(out.depth()!=CV_8U && out.depth()!=CV_32F && out.depth()!=CV_64F)
+		CV_Error(CV_StsUnsupportedFormat,"OutOfCoreCFT: the image must be of uchar, float or double");
+	Mat p=par,o=orth;
+	parallel_for_(Range(0,rows),OutOfCoreRowBody<T>(this,&out,&p,&o,true));
+}
+
+template<typename T> void OutOfCoreCFT_<T>::transformColumns(const Mat& srcPar,const Mat& srcOrth,Mat& dstPar,Mat& dstOrth,const bool& forward,const FrequencyMask* mask,const bool& inverse){
+	Mat buffer(2*blockCols,rows,CV_MAKETYPE(DataType<T>::depth,2));
+	Mat p=srcPar,o=srcOrth;
+	for(int start=0;start<cols;start+=blockCols){
+		const int n=std::min(blockCols,cols-start);
+		parallel_for_(Range(0,rows),OutOfCoreStripBody<T>(&p,&o,&buffer,start,n,true));
+		parallel_for_(Range(0,n),OutOfCoreColumnBody<T>(this,&buffer,start,forward,mask,inverse));
+		parallel_for_(Range(0,rows),OutOfCoreStripBody<T>(&dstPar,&dstOrth,&buffer,start,n,false));
+	}
+}
+
+template<typename T> void OutOfCoreCFT_<T>::createSpectra(MappedMat& file,Mat& par,Mat& orth) const{
+	string dir=config.tempDir;
+	if(dir.empty()){
+		const char* tmp=getenv("TMPDIR");
+		dir=tmp ? tmp : "/tmp";
+	}
+	file.createTemporary(dir,2*rows,cols,CV_MAKETYPE(DataType<T>::depth,2));
+	par=file.getMat().rowRange(0,rows);
+	orth=file.getMat().rowRange(rows,2*rows);
+}
+
+template<typename T> void OutOfCoreCFT_<T>::forward(const Mat& in,Mat& par,Mat& orth){
+	const int type=CV_MAKETYPE(DataType<T>::depth,2);
+	if(par.empty())
+		par.create(rows,cols,type);
+	if(orth.empty())
+		orth.create(rows,cols,type);
+	CV_Assert(par.rows==rows && par.cols==cols && par.type()==type);
+	CV_Assert(orth.rows==rows && orth.cols==cols && orth.type()==type);
+	forwardRows(in,par,orth);
+	transformColumns(par,orth,par,orth,true,0,false);
+}
+
+template<typename T> void OutOfCoreCFT_<T>::inverse(const Mat& par,const Mat& orth,Mat& out){
+	const int type=CV_MAKETYPE(DataType<T>::depth,2);
+	CV_Assert(par.rows==rows && par.cols==cols && par.type()==type);
+	CV_Assert(orth.rows==rows && orth.cols==cols && orth.type()==type);
+	MappedMat file;
+	Mat p,o;
+	createSpectra(file,p,o);
+	transformColumns(par,orth,p,o,false,0,true);
+	inverseRows(p,o,out);
+}
+
+template<typename T> void OutOfCoreCFT_<T>::filter(const Mat& in,Mat& out,const FrequencyMask& mask){
+	MappedMat file;
+	Mat p,o;
+	createSpectra(file,p,o);
+	forwardRows(in,p,o);
+	transformColumns(p,o,p,o,true,&mask,true);
+	if(out.empty())
+		out.create(rows,cols,in.type());
+	inverseRows(p,o,out);
+}
+
+template<typename T> int OutOfCoreCFT_<T>::getBlockCols() const{
+	return blockCols;
+}
+
+template<typename T> size_t OutOfCoreCFT_<T>::getTemporarySize() const{
+	return 2*(size_t)rows*cols*CV_ELEM_SIZE(CV_MAKETYPE(DataType<T>::depth,2));
+}
+
+template<typename T> OutOfCoreCFT_<T>::~OutOfCoreCFT_() {
+	for(size_t i=0;i<pool.size();i++)
+		delete pool[i];
+}
+
+template class OutOfCoreCFT_<float>;
+template class OutOfCoreCFT_<double>;
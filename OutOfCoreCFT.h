@@ -0,0 +1,253 @@
+/**
+ * \file OutOfCoreCFT.h
+ * \brief Color Clifford Fourier Transform of images larger than the memory
+ * \version 1.0
+ * \date October 17, 2026
+ *
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the distribution
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef OUTOFCORECFT_H_
+#define OUTOFCORECFT_H_
+
+#include <iostream>
+#include <opencv/cv.h>
+#include <opencv/highgui.h>
+#include <vector>
+#include <string>
+#include "BatchFFT.h"
+#include "ColorPreprocessor.h"
+#include "MappedMat.h"
+
+using namespace cv;
+
+/*!
+ *  \brief The parts of the CFT modified by a FrequencyMask
+ */
+enum MaskParts {
+	MASK_PARALLEL=1,		/*!< The parallel part */
+	MASK_ORTHOGONAL=2,		/*!< The orthogonal part */
+	MASK_BOTH=3				/*!< Both parts */
+};
+
+/*! \class FrequencyMask
+   * \brief Gains applied to the CFT of an image by OutOfCoreCFT_::filter
+   *
+   *  The spectrum is never in memory as a whole, so the mask is asked column by column.
+   */
+class FrequencyMask {
+public:
+	/*!
+	 *  \brief Get the gains of a column of the unshifted spectrum
+	 *
+	 *  \param v : The column (frequency v if v<=cols/2, v-cols otherwise)
+	 *  \param size : The size of the spectrum
+	 *  \param parGain : The output, the gains of the parallel part for the rows 0 to size.height-1
+	 *  \param orthGain : The output, the gains of the orthogonal part for the rows 0 to size.height-1
+	 */
+	virtual void getColumn(const int& v,const Size& size,double* parGain,double* orthGain) const=0;
+
+	virtual ~FrequencyMask();
+};
+
+/*! \class RadialBandMask
+   * \brief Keep the frequencies of a band of radii and remove the others
+   *
+   *  The radius of the frequency (fu,fv) is sqrt((fu/rows)^2+(fv/cols)^2), in cycles per pixel
+   *  (0.5 on the axes at the highest frequency).
+   */
+class RadialBandMask : public FrequencyMask {
+private:
+	double low;		/*!< The smallest radius kept */
+	double high;	/*!< The largest radius kept */
+	int parts;		/*!< The parts filtered (MaskParts), the others are kept */
+public:
+	/*!
+	 *  \brief Constructor of RadialBandMask class
+	 *
+	 *  \param low : The smallest radius kept (0 for a low-pass filter)
+	 *  \param high : The largest radius kept (1 for a high-pass filter)
+	 *  \param parts : The parts filtered (MaskParts), the others are kept
+	 *
+	 */
+	RadialBandMask(const double& low,const double& high,const int& parts=MASK_BOTH);
+	virtual void getColumn(const int& v,const Size& size,double* parGain,double* orthGain) const;
+	virtual ~RadialBandMask();
+};
+
+/*!
+ *  \brief Parameters of OutOfCoreCFT_
+ */
+struct OutOfCoreConfig {
+	size_t memoryBudget;	/*!< Memory of the blocks of columns (in bytes), the mapped files are paged by the system */
+	string tempDir;			/*!< Directory of the temporary spectra (TMPDIR or /tmp if empty) */
+	FFTBackend backend;		/*!< The implementation of the DFTs */
+	OutOfCoreConfig();
+};
+
+template<typename T> struct OutOfCoreScratch;
+template<typename T> class OutOfCoreRowBody;
+template<typename T> class OutOfCoreStripBody;
+template<typename T> class OutOfCoreColumnBody;
+
+/*! \class OutOfCoreCFT_
+   * \brief CFT, inverse CFT and frequency filtering of images which do not fit in memory
+   *
+   *  The 2D DFTs are decomposed in DFTs of the rows and DFTs of the columns, so the image and
+   *  the spectra only have to be read by blocks of rows or of columns. With MappedMat the image,
+   *  the spectra and the result are files paged by the system, e.g. a gigapixel image of
+   *  8 bits is filtered with about 32 bytes per pixel of disk (two complex parts in double)
+   *  and a memory bounded by OutOfCoreConfig::memoryBudget:
+   *    - rows: projection of each row on the basis of the bivector (as CFTPlan_) and DFT of
+   *      the rows of both parts, written in the spectra;
+   *    - columns: a block of columns of the spectra is transposed in memory, its DFTs are
+   *      computed (and the mask and the inverse DFTs for a filter) and it is written back;
+   *    - rows: inverse DFT of the rows and reconstruction of the colors.
+   *  The rows and the columns of a block are spread over the threads of cv::parallel_for_.
+   *
+   *  The spectra are the ones of CFT::computeCFT (not scaled, not shifted). The inverse gives
+   *  back the image: the channels are read and written by a ColorPreprocessor_, in the order
+   *  and with the range of the ColorPreprocessing (by default BGR for 3 channels and RGBA for
+   *  4, divided by 255), the alpha channel being the imaginary part of the parallel part, as
+   *  for CFTPlan_.
+   *
+   *  T is the precision of the spectra (float or double).
+   */
+template<typename T> class OutOfCoreCFT_ {
+private:
+	int rows;								/*!< Number of rows of the images */
+	int cols;								/*!< Number of columns of the images */
+	OutOfCoreConfig config;					/*!< The parameters */
+	ColorPreprocessor_<T> preprocessor;		/*!< The projection of the rows on the basis of the bivector and its inverse */
+	int blockCols;							/*!< Number of columns of a block of the column pass */
+	vector<OutOfCoreScratch<T>*> pool;		/*!< The scratches which are not used by a thread */
+	Mutex poolMutex;						/*!< Protect the pool */
+
+	friend class OutOfCoreRowBody<T>;
+	friend class OutOfCoreStripBody<T>;
+	friend class OutOfCoreColumnBody<T>;
+	/*!
+	 *  \brief Take a scratch from the pool (or create one)
+	 */
+	OutOfCoreScratch<T>* acquireScratch();
+	/*!
+	 *  \brief Give back a scratch to the pool
+	 */
+	void releaseScratch(OutOfCoreScratch<T>* s);
+	/*!
+	 *  \brief Project the rows of an image and compute their DFT
+	 *
+	 *  \param in : A color image
+	 *  \param par : The output, the DFT of the rows of the parallel part
+	 *  \param orth : The output, the DFT of the rows of the orthogonal part
+	 */
+	void forwardRows(const Mat& in,Mat& par,Mat& orth);
+	/*!
+	 *  \brief Compute the inverse DFT of the rows and reconstruct the colors
+	 *
+	 *  \param par : The DFT of the rows of the parallel part
+	 *  \param orth : The DFT of the rows of the orthogonal part
+	 *  \param out : The output, the image
+	 */
+	void inverseRows(const Mat& par,const Mat& orth,Mat& out);
+	/*!
+	 *  \brief Transform the columns of both parts, block by block
+	 *
+	 *  \param srcPar : The parallel part
+	 *  \param srcOrth : The orthogonal part
+	 *  \param dstPar : The output, the transformed parallel part (may be srcPar)
+	 *  \param dstOrth : The output, the transformed orthogonal part (may be srcOrth)
+	 *  \param forward : Compute the DFT of the columns
+	 *  \param mask : If not null, the gains applied after the DFT
+	 *  \param inverse : Compute the inverse DFT of the columns (scaled by 1/rows) at the end
+	 */
+	void transformColumns(const Mat& srcPar,const Mat& srcOrth,Mat& dstPar,Mat& dstOrth,const bool& forward,const FrequencyMask* mask,const bool& inverse);
+	/*!
+	 *  \brief Create the temporary spectra
+	 */
+	void createSpectra(MappedMat& file,Mat& par,Mat& orth) const;
+
+	OutOfCoreCFT_(const OutOfCoreCFT_&);
+	OutOfCoreCFT_& operator=(const OutOfCoreCFT_&);
+
+public:
+	/*!
+	 *  \brief Constructor of OutOfCoreCFT_ class
+	 *
+	 *  \param rows : The number of rows of the images
+	 *  \param cols : The number of columns of the images
+	 *  \param Vec : A color vector used to build the bivector B=Vec^e4
+	 *  \param config : The memory budget and the temporary directory
+	 *  \param preprocessing : The order of the channels and the scaling of the images
+	 *
+	 */
+	OutOfCoreCFT_(const int& rows,const int& cols,const Mat& Vec,const OutOfCoreConfig& config=OutOfCoreConfig(),const ColorPreprocessing& preprocessing=ColorPreprocessing());
+	/*!
+	 *  \brief Compute the CFT of an image
+	 *
+	 *  \param in : A color image (3 or 4 channels, uchar, float or double), e.g. a MappedMat
+	 *  \param par : The parallel part, a complex Mat of T of the size of the image (e.g. a writable MappedMat)
+	 *  \param orth : The orthogonal part, a complex Mat of T of the size of the image (e.g. a writable MappedMat)
+	 */
+	void forward(const Mat& in,Mat& par,Mat& orth);
+	/*!
+	 *  \brief Compute the inverse CFT
+	 *
+	 *  The spectra are not modified, the intermediate results are in a temporary file.
+	 *
+	 *  \param par : The parallel part of the CFT
+	 *  \param orth : The orthogonal part of the CFT
+	 *  \param out : The output, the image: if it is empty it is created as CV_8UC3, otherwise
+	 *  its type is kept (3 or 4 channels, uchar, float or double)
+	 */
+	void inverse(const Mat& par,const Mat& orth,Mat& out);
+	/*!
+	 *  \brief Filter an image in the frequency domain: CFT, mask and inverse CFT
+	 *
+	 *  \param in : A color image (3 or 4 channels, uchar, float or double), e.g. a MappedMat
+	 *  \param out : The output, the filtered image: if it is empty it is created with the type
+	 *  of in, otherwise its type is kept (e.g. a writable MappedMat). It may be in.
+	 *  \param mask : The gains of the frequencies
+	 */
+	void filter(const Mat& in,Mat& out,const FrequencyMask& mask);
+	/*!
+	 *  \brief Get the number of columns transformed at a time
+	 *
+	 *  \return Return the number of columns of a block, deduced from the memory budget
+	 */
+	int getBlockCols() const;
+	/*!
+	 *  \brief Get the size of the temporary file used by inverse and filter
+	 *
+	 *  \return Return the size of the two complex parts (in bytes)
+	 */
+	size_t getTemporarySize() const;
+
+	virtual ~OutOfCoreCFT_();
+};
+
+typedef OutOfCoreCFT_<double> OutOfCoreCFT;
+typedef OutOfCoreCFT_<float> OutOfCoreCFTf;
+
+#endif /* OUTOFCORECFT_H_ */
@@ -0,0 +1,129 @@
+/**
+ * \file PolarMapper.cpp
+ * \brief Polar transform of images with precomputed sampling tables
+ * \version 1.0
+ * \date October 17, 2026
+ *
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the distribution
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "PolarMapper.h"
+#include <algorithm>
+
+PolarMapper::PolarMapper() : size(), center(), maxRadius(0), interpolation(INTER_LINEAR) {
+}
+
+PolarMapper::PolarMapper(const Size& size,const PolarMethod& method,const int& interpolation)
+		: size(size), center((float)(size.width/2),(float)(size.height/2)), interpolation(interpolation) {
+	int halfW=size.width/2;
+	int halfH=size.height/2;
+	// As in MyTools::imCart2Pol(im,method), the full radius keeps its fractional part, while the
+	// overload taking a center truncates its radii to int (see tests/testPolarMapper.cpp)
+	if(method==POLAR_FULL)
+		maxRadius=std::sqrt((double)halfW*halfW+(double)halfH*halfH);
+	else
+		maxRadius=std::min(halfH,halfW);
+	build();
+}
+
+PolarMapper::PolarMapper(const Size& size,const vector<double>& center,const PolarMethod& method,const int& interpolation)
+		: size(size), interpolation(interpolation) {
+	CV_Assert(center.size()>=2);
+	// Same radii as MyTools::imCart2Pol: center[0] is compared to the number of rows and
+	// center[1] to the number of columns, but center[0] is the x of the polar transform.
+	// The radii are truncated to int, as in the legacy function
+	const double c0=center[0],c1=center[1];
+	const double rows=size.height,cols=size.width;
+	double d[4];
+	d[0]=std::sqrt(c0*c0+c1*c1);
+	d[1]=std::sqrt(c0*c0+(cols-c1)*(cols-c1));
+	d[2]=std::sqrt((rows-c0)*(rows-c0)+c1*c1);
+	d[3]=std::sqrt((rows-c0)*(rows-c0)+(cols-c1)*(cols-c1));
+	if(method==POLAR_FULL)
+		maxRadius=(int)*std::max_element(d,d+4);
+	else
+		maxRadius=(int)std::min(*std::min_element(d,d+4),std::min(c0,c1));
+	this->center=Point2f((float)c0,(float)c1);
+	build();
+}
+
+PolarMapper::PolarMapper(const Size& size,const Point2f& center,const double& maxRadius,const int& interpolation)
+		: size(size), center(center), maxRadius(maxRadius), interpolation(interpolation) {
+	build();
+}
+
+void PolarMapper::build(){
+	CV_Assert(size.width>0 && size.height>0);
+	// cvLinearPolar samples the row phi and the column rho of its output at the angle
+	// 2*pi*phi/height and the radius maxRadius*rho/width; the legacy functions then transpose it
+	Mat mapX(size.width,size.height,CV_32FC1);
+	Mat mapY(size.width,size.height,CV_32FC1);
+	for(int phi=0;phi<size.height;phi++){
+		double cp=std::cos(phi*2*CV_PI/size.height);
+		double sp=std::sin(phi*2*CV_PI/size.height);
+		for(int rho=0;rho<size.width;rho++){
+			double r=maxRadius*rho/size.width;
+			mapX.at<float>(rho,phi)=(float)(r*cp+center.x);
+			mapY.at<float>(rho,phi)=(float)(r*sp+center.y);
+		}
+	}
+	// The fixed-point maps are the ones cv::remap computes from float maps at each call
+	convertMaps(mapX,mapY,map1,map2,CV_16SC2,interpolation==INTER_NEAREST);
+}
+
+void PolarMapper::apply(const Mat& im,Mat& polar) const{
+	CV_Assert(im.size()==size);
+	CV_Assert(im.data!=polar.data || im.empty());
+	remap(im,polar,map1,map2,interpolation,BORDER_CONSTANT,Scalar::all(0));
+}
+
+Mat PolarMapper::apply(const Mat& im) const{
+	Mat polar;
+	apply(im,polar);
+	return polar;
+}
+
+Size PolarMapper::getSize() const{
+	return size;
+}
+
+Point2f PolarMapper::getCenter() const{
+	return center;
+}
+
+double PolarMapper::getMaxRadius() const{
+	return maxRadius;
+}
+
+PolarMethod PolarMapper::parseMethod(const string& method){
+	if(method=="full")
+		return POLAR_FULL;
+	if(method=="crop")
+		return POLAR_CROP;
+	CV_Error(CV_StsBadArg,"PolarMapper: the method must be \"full\" or \"crop\"");
+	return POLAR_FULL;
+}
+
+PolarMapper::~PolarMapper() {
+}
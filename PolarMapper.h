@@ -0,0 +1,156 @@
+/**
+ * \file PolarMapper.h
+ * \brief Polar transform of images with precomputed sampling tables
+ * \version 1.0
+ * \date October 17, 2026
+ *
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the distribution
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef POLARMAPPER_H_
+#define POLARMAPPER_H_
+
+#include <iostream>
+#include <opencv/cv.h>
+#include <opencv/highgui.h>
+#include <vector>
+#include <string>
+
+using namespace cv;
+
+/*!
+ *  \brief The radius of the polar transform, see MyTools::imCart2Pol
+ */
+enum PolarMethod {
+	POLAR_FULL,				/*!< "full": all the image is considered and the missing parts are set to 0 */
+	POLAR_CROP				/*!< "crop": the image is cropped to a circle */
+};
+
+/*! \class PolarMapper
+   * \brief Convert images of a given size to polar images with precomputed sampling tables
+   *
+   *  MyTools::imCart2Pol builds the sampling coordinates of cvLinearPolar at each call and
+   *  colImCart2Pol does it once per channel. A mapper computes them once for a size, a center,
+   *  a radius and an interpolation, in the fixed-point format of cv::remap, already transposed
+   *  so that the output needs no transposition. apply() is then a single cv::remap (vectorised
+   *  and multi-threaded by OpenCV) for all the channels of the image.
+   *
+   *  With the parameters of the legacy functions (see the constructors taking a PolarMethod) the
+   *  polar image of a gray level image is the one of imCart2Pol, and the one of a color image is
+   *  the one of colImCart2Pol. The output has the type of the input, a row per radius and a
+   *  column per angle.
+   */
+class PolarMapper {
+private:
+	Size size;				/*!< The size of the cartesian images */
+	Point2f center;			/*!< The center of the polar transform */
+	double maxRadius;		/*!< The radius of the last row of the polar images */
+	int interpolation;		/*!< The interpolation of cv::remap */
+	Mat map1;				/*!< Integer coordinates (CV_16SC2) of each pixel of the polar image */
+	Mat map2;				/*!< Interpolation coefficients (CV_16UC1, empty for INTER_NEAREST) */
+
+	/*!
+	 *  \brief Compute the sampling tables
+	 */
+	void build();
+
+public:
+	PolarMapper();
+	/*!
+	 *  \brief Constructor of PolarMapper class with the parameters of MyTools::imCart2Pol(im,method)
+	 *
+	 *  As in the legacy function, the radius of POLAR_FULL is not rounded to an integer.
+	 *
+	 *  \param size : The size of the cartesian images
+	 *  \param method : The radius of the polar transform
+	 *  \param interpolation : The interpolation of cv::remap (INTER_LINEAR in the legacy function)
+	 *
+	 */
+	PolarMapper(const Size& size,const PolarMethod& method,const int& interpolation=INTER_LINEAR);
+	/*!
+	 *  \brief Constructor of PolarMapper class with the parameters of MyTools::imCart2Pol(im,method,center)
+	 *
+	 *  As in the legacy function, the radius is truncated to an integer.
+	 *
+	 *  \param size : The size of the cartesian images
+	 *  \param center : The center given to imCart2Pol, e.g. by MyTools::getImageCenter
+	 *  \param method : The radius of the polar transform
+	 *  \param interpolation : The interpolation of cv::remap (INTER_LINEAR in the legacy function)
+	 *
+	 */
+	PolarMapper(const Size& size,const vector<double>& center,const PolarMethod& method,const int& interpolation=INTER_LINEAR);
+	/*!
+	 *  \brief Constructor of PolarMapper class
+	 *
+	 *  \param size : The size of the cartesian images
+	 *  \param center : The center of the polar transform (x is the column)
+	 *  \param maxRadius : The radius of the last row of the polar images
+	 *  \param interpolation : The interpolation of cv::remap
+	 *
+	 */
+	PolarMapper(const Size& size,const Point2f& center,const double& maxRadius,const int& interpolation=INTER_LINEAR);
+	/*!
+	 *  \brief Convert an image to a polar image
+	 *
+	 *  \param im : An image of the size of the mapper, with any number of channels
+	 *  \param polar : The output, size.width rows (the radius) and size.height columns (the angle)
+	 */
+	void apply(const Mat& im,Mat& polar) const;
+	/*!
+	 *  \brief Convert an image to a polar image
+	 *
+	 *  \param im : An image of the size of the mapper, with any number of channels
+	 *  \return Return the polar image
+	 */
+	Mat apply(const Mat& im) const;
+	/*!
+	 *  \brief Get the size of the cartesian images
+	 *
+	 *  \return Return the size given to the constructor
+	 */
+	Size getSize() const;
+	/*!
+	 *  \brief Get the center of the polar transform
+	 *
+	 *  \return Return the center (x is the column)
+	 */
+	Point2f getCenter() const;
+	/*!
+	 *  \brief Get the radius of the polar transform
+	 *
+	 *  \return Return the radius of the last row of the polar images
+	 */
+	double getMaxRadius() const;
+	/*!
+	 *  \brief Convert the method of the legacy functions
+	 *
+	 *  \param method : "full" or "crop"
+	 *  \return Return the corresponding PolarMethod
+	 */
+	static PolarMethod parseMethod(const string& method);
+
+	virtual ~PolarMapper();
+};
+
+#endif /* POLARMAPPER_H_ */
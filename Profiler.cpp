@@ -0,0 +1,331 @@
+/**
+ * \file Profiler.cpp
+ * \brief Opt-in timers and allocation counters of the stages of the CFT and of the descriptors
+ * \version 1.0
+ * \date October 17, 2026
+ *
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the distribution
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "Profiler.h"
+#include <fstream>
+#include <iomanip>
+#include <cstring>
+#include <pthread.h>
+
+/*!
+ *  \brief A run of a stage, recorded when the tracing is enabled
+ */
+struct ProfileEvent {
+	int stage;		/*!< The index of the stage in the statistics of the thread */
+	int64 start;	/*!< Start of the run (cv::getTickCount) */
+	int64 end;		/*!< End of the run (cv::getTickCount) */
+};
+
+static int profilerEpoch=0;		/*!< Incremented by Profiler::reset, read with CV_XADD */
+
+/*!
+ *  \brief The statistics of a thread, only written by this thread
+ *
+ *  The stages are never removed, so the indices kept by the running ProfileScope stay valid:
+ *  a reset only sets the statistics to 0, and it is applied by the thread itself when it
+ *  starts or ends its next stage. The thread locks its mutex (never contended but by a reader) when
+ *  it writes its statistics or its events, and the readers lock it to copy them.
+ */
+struct ThreadProfile {
+	int id;							/*!< Index of the thread */
+	int epoch;						/*!< The value of profilerEpoch when the statistics have been reset */
+	vector<const char*> names;		/*!< The names of the stages, as given to ProfileScope */
+	vector<ProfileStage> stages;	/*!< The statistics of each stage */
+	vector<int> open;				/*!< The stages which are running, the innermost last (only used by the thread) */
+	vector<ProfileEvent> events;	/*!< The runs of the stages */
+	Mutex mutex;					/*!< Protect names, stages, events and epoch against the readers */
+
+	/*!
+	 *  \brief Find or add a stage
+	 */
+	int find(const char* name){
+		for(size_t s=0;s<names.size();s++)
+			if(names[s]==name)
+				return (int)s;
+		// The same literal can have several addresses in several translation units
+		for(size_t s=0;s<names.size();s++)
+			if(strcmp(names[s],name)==0)
+				return (int)s;
+		AutoLock lock(mutex);
+		names.push_back(name);
+		stages.push_back(ProfileStage());
+		stages.back().name=name;
+		return (int)names.size()-1;
+	}
+	/*!
+	 *  \brief Apply the last call to Profiler::reset, if it has not been applied yet
+	 */
+	void update(){
+		const int current=CV_XADD(&profilerEpoch,0);
+		if(epoch==current)
+			return;
+		AutoLock lock(mutex);
+		for(size_t s=0;s<stages.size();s++){
+			ProfileStage& p=stages[s];
+			p.count=0;
+			p.total=p.min=p.max=0;
+			p.allocations=p.bytes=0;
+		}
+		events.clear();
+		epoch=current;
+	}
+};
+
+static pthread_once_t profilerOnce=PTHREAD_ONCE_INIT;
+static pthread_key_t profilerKey;
+static Mutex* registryMutex=0;
+static vector<ThreadProfile*>* registry=0;
+static int64 origin=0;
+static volatile bool tracingEnabled=false;
+
+static void initProfiler(){
+	pthread_key_create(&profilerKey,0);
+	registryMutex=new Mutex();
+	registry=new vector<ThreadProfile*>();
+	origin=getTickCount();
+}
+
+/*!
+ *  \brief Get the statistics of the calling thread (created at the first call)
+ */
+static ThreadProfile* getThreadProfile(){
+	pthread_once(&profilerOnce,initProfiler);
+	ThreadProfile* t=(ThreadProfile*)pthread_getspecific(profilerKey);
+	if(t)
+		return t;
+	// The statistics are kept after the end of the thread, so they are never deleted
+	t=new ThreadProfile();
+	t->epoch=CV_XADD(&profilerEpoch,0);
+	{
+		AutoLock lock(*registryMutex);
+		t->id=(int)registry->size();
+		registry->push_back(t);
+	}
+	pthread_setspecific(profilerKey,t);
+	return t;
+}
+
+/*!
+ *  \brief Add the statistics of a stage to another one
+ */
+static void merge(ProfileStage& dst,const ProfileStage& src){
+	if(src.count>0){
+		dst.min=dst.count>0 ? std::min(dst.min,src.min) : src.min;
+		dst.max=dst.count>0 ? std::max(dst.max,src.max) : src.max;
+	}
+	dst.count+=src.count;
+	dst.total+=src.total;
+	dst.allocations+=src.allocations;
+	dst.bytes+=src.bytes;
+}
+
+/*!
+ *  \brief Write the statistics of stages as a JSON array
+ */
+static void writeStages(std::ostream& out,const vector<ProfileStage>& stages,const string& indent){
+	out<<"["<<std::endl;
+	for(size_t s=0;s<stages.size();s++){
+		const ProfileStage& p=stages[s];
+		out<<indent<<"  {\"name\": \""<<p.name<<"\", \"count\": "<<p.count
+				<<", \"total_ms\": "<<1e3*p.total<<", \"mean_us\": "<<(p.count>0 ? 1e6*p.total/p.count : 0)
+				<<", \"min_us\": "<<1e6*p.min<<", \"max_us\": "<<1e6*p.max
+				<<", \"allocations\": "<<p.allocations<<", \"bytes\": "<<p.bytes<<"}"
+				<<(s+1<stages.size() ? "," : "")<<std::endl;
+	}
+	out<<indent<<"]";
+}
+
+ProfileStage::ProfileStage() : count(0), total(0), min(0), max(0), allocations(0), bytes(0) {
+}
+
+bool Profiler::isEnabled(){
+#ifdef GCFD_PROFILING
+	return true;
+#else
+	return false;
+#endif
+}
+
+void Profiler::setTracing(const bool& tracing){
+	tracingEnabled=tracing;
+}
+
+void Profiler::reset(){
+	pthread_once(&profilerOnce,initProfiler);
+	AutoLock lock(*registryMutex);
+	// The threads reset their own statistics (see ThreadProfile::update), until then the
+	// readers see them as empty
+	CV_XADD(&profilerEpoch,1);
+	origin=getTickCount();
+}
+
+int Profiler::getNbThreads(){
+	pthread_once(&profilerOnce,initProfiler);
+	AutoLock lock(*registryMutex);
+	return (int)registry->size();
+}
+
+vector<ProfileStage> Profiler::getStages(const int& thread){
+	pthread_once(&profilerOnce,initProfiler);
+	AutoLock lock(*registryMutex);
+	CV_Assert(thread>=0 && thread<(int)registry->size());
+	ThreadProfile* p=(*registry)[thread];
+	AutoLock threadLock(p->mutex);
+	vector<ProfileStage> res;
+	if(p->epoch!=CV_XADD(&profilerEpoch,0))
+		return res;
+	for(size_t s=0;s<p->stages.size();s++)
+		if(p->stages[s].count>0 || p->stages[s].allocations>0)
+			res.push_back(p->stages[s]);
+	return res;
+}
+
+vector<ProfileStage> Profiler::getStages(){
+	vector<ProfileStage> res;
+	const int nbThreads=getNbThreads();
+	for(int t=0;t<nbThreads;t++){
+		vector<ProfileStage> stages=getStages(t);
+		for(size_t s=0;s<stages.size();s++){
+			size_t k=0;
+			while(k<res.size() && res[k].name!=stages[s].name)
+				k++;
+			if(k==res.size()){
+				res.push_back(ProfileStage());
+				res.back().name=stages[s].name;
+			}
+			merge(res[k],stages[s]);
+		}
+	}
+	return res;
+}
+
+void Profiler::writeJSON(const string& path){
+	std::ofstream out(path.c_str());
+	if(!out)
+		CV_Error(CV_StsError,"Profiler: cannot write "+path);
+	out<<"{"<<std::endl;
+	out<<"  \"enabled\": "<<(isEnabled() ? "true" : "false")<<","<<std::endl;
+	out<<"  \"total\": ";
+	writeStages(out,getStages(),"  ");
+	out<<","<<std::endl;
+	out<<"  \"threads\": ["<<std::endl;
+	const int nbThreads=getNbThreads();
+	for(int t=0;t<nbThreads;t++){
+		out<<"    {\"id\": "<<t<<", \"stages\": ";
+		writeStages(out,getStages(t),"    ");
+		out<<"}"<<(t+1<nbThreads ? "," : "")<<std::endl;
+	}
+	out<<"  ]"<<std::endl;
+	out<<"}"<<std::endl;
+}
+
+void Profiler::writeChromeTrace(const string& path){
+	std::ofstream out(path.c_str());
+	if(!out)
+		CV_Error(CV_StsError,"Profiler: cannot write "+path);
+	pthread_once(&profilerOnce,initProfiler);
+	AutoLock lock(*registryMutex);
+	const double toMicroseconds=1e6/getTickFrequency();
+	out<<std::fixed<<std::setprecision(3);
+	out<<"{\"displayTimeUnit\": \"ms\", \"traceEvents\": ["<<std::endl;
+	bool first=true;
+	for(size_t t=0;t<registry->size();t++){
+		ThreadProfile* p=(*registry)[t];
+		AutoLock threadLock(p->mutex);
+		out<<(first ? "" : ",\n")<<"{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": "<<p->id
+				<<", \"args\": {\"name\": \"thread "<<p->id<<"\"}}";
+		first=false;
+		if(p->epoch!=CV_XADD(&profilerEpoch,0))
+			continue;
+		for(size_t e=0;e<p->events.size();e++){
+			const ProfileEvent& ev=p->events[e];
+			out<<",\n{\"name\": \""<<p->names[ev.stage]<<"\", \"cat\": \"gcfd\", \"ph\": \"X\", \"pid\": 1, \"tid\": "<<p->id
+					<<", \"ts\": "<<(ev.start-origin)*toMicroseconds<<", \"dur\": "<<(ev.end-ev.start)*toMicroseconds<<"}";
+		}
+	}
+	out<<std::endl<<"]}"<<std::endl;
+}
+
+void Profiler::print(std::ostream& out){
+	vector<ProfileStage> stages=getStages();
+	out<<std::left<<std::setw(28)<<"stage"<<std::right<<std::setw(10)<<"count"<<std::setw(14)<<"total (ms)"
+			<<std::setw(12)<<"mean (us)"<<std::setw(12)<<"allocs"<<std::setw(14)<<"bytes"<<std::endl;
+	for(size_t s=0;s<stages.size();s++){
+		const ProfileStage& p=stages[s];
+		out<<std::left<<std::setw(28)<<p.name<<std::right<<std::setw(10)<<p.count<<std::setw(14)<<1e3*p.total
+				<<std::setw(12)<<(p.count>0 ? 1e6*p.total/p.count : 0)<<std::setw(12)<<p.allocations<<std::setw(14)<<p.bytes<<std::endl;
+	}
+}
+
+void Profiler::countAllocation(const size_t& bytes){
+	ThreadProfile* t=getThreadProfile();
+	t->update();
+	int stage=t->open.empty() ? t->find("(no stage)") : t->open.back();
+	AutoLock lock(t->mutex);
+	t->stages[stage].allocations++;
+	t->stages[stage].bytes+=(int64)bytes;
+}
+
+void Profiler::create(Mat& m,const int& rows,const int& cols,const int& type){
+	if(m.data && m.rows==rows && m.cols==cols && m.type()==type)
+		return;
+	m.create(rows,cols,type);
+	countAllocation(m.total()*m.elemSize());
+}
+
+ProfileScope::ProfileScope(const char* name) {
+	ThreadProfile* t=getThreadProfile();
+	t->update();
+	thread=t;
+	stage=t->find(name);
+	t->open.push_back(stage);
+	start=getTickCount();
+}
+
+ProfileScope::~ProfileScope() {
+	const int64 end=getTickCount();
+	ThreadProfile* t=(ThreadProfile*)thread;
+	const double d=(end-start)/getTickFrequency();
+	t->open.pop_back();
+	t->update();
+	AutoLock lock(t->mutex);
+	ProfileStage& s=t->stages[stage];
+	s.min=s.count>0 ? std::min(s.min,d) : d;
+	s.max=std::max(s.max,d);
+	s.count++;
+	s.total+=d;
+	if(tracingEnabled){
+		ProfileEvent e;
+		e.stage=stage;
+		e.start=start;
+		e.end=end;
+		t->events.push_back(e);
+	}
+}
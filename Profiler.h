@@ -0,0 +1,214 @@
+/**
+ * \file Profiler.h
+ * \brief Opt-in timers and allocation counters of the stages of the CFT and of the descriptors
+ * \version 1.0
+ * \date October 17, 2026
+ *
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the distribution
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef PROFILER_H_
+#define PROFILER_H_
+
+#include <iostream>
+#include <opencv/cv.h>
+#include <opencv/highgui.h>
+#include <vector>
+#include <string>
+
+using namespace cv;
+
+/*
+ * The instrumentation is compiled only if GCFD_PROFILING is defined (option GCFD_PROFILING of
+ * CMake), otherwise the macros expand to nothing (or to the plain Mat::create) and cost nothing.
+ *
+ * Stages of the library:
+ *   CFT/projection          conversion and projection of the image on the basis of the bivector by ColorPreprocessor
+ *                           (CFTPlan, MultiBivectorCFT)
+ *   FFT2/computeFFT2        DFT of the projected parts or of the color planes (CFTPlan, MultiBivectorCFT, RealFFT2)
+ *   FFT2/fftshift           in-place shift (SpectrumTools, RealFFT2); the shift of the descriptors is folded in CircleTable
+ *   FFT2/cropSpectrum       in-place crop of a spectrum (SpectrumTools)
+ *   MyTools/integrOnCircles integration of a spectrum on the discrete circles (CircleTable); it includes
+ *                           the crop of FFT2::cropSpectrum, which is folded in the indices
+ *   Index/setScaling, Index/prepare
+ *                           column scaling of a sample and of the data or queries (DescriptorIndex)
+ *   GFD1/computeFeatures, GCFD1/computeFeatures, GCFD3/computeFeatures
+ *                           a whole descriptor (constructors taking a plan, DescriptorExtractor, MultiBivectorDescriptors)
+ *   Descriptors/buildPlan   construction of the plan and of the circles for a new size
+ *   MultiBivectorCFT/combine parts of the CFT for one bivector
+ *   Stream/decode, Stream/preprocess, Stream/cft, Stream/descriptor
+ *                           the stages of StreamingExtractor
+ *   Dense/slidingDFT        update of the spectra of the windows by one row (DenseDescriptors)
+ *   MultiScale/extract      a whole pyramid descriptor, one CFT and one integration per scale (MultiScaleDescriptors)
+ *   OutOfCore/rows, OutOfCore/transpose, OutOfCore/columns
+ *                           the passes of OutOfCoreCFT, per block of rows or of columns
+ *   Rotation/remap          rotation of an image with the precomputed maps of a RotationMapper
+ *   Cache/hash              hash of the pixels of an image for the lookup in a DescriptorCache
+ * Any other code can be timed with GCFD_PROFILE_SCOPE, e.g. the calls to the legacy functions.
+ */
+#ifdef GCFD_PROFILING
+#define GCFD_PROFILE_CONCAT_(a,b) a##b
+#define GCFD_PROFILE_CONCAT(a,b) GCFD_PROFILE_CONCAT_(a,b)
+/*! Time the end of the enclosing block as the stage name (a string literal) */
+#define GCFD_PROFILE_SCOPE(name) ProfileScope GCFD_PROFILE_CONCAT(gcfdProfileScope,__LINE__)(name)
+/*! Mat::create which counts an allocation in the current stage if the Mat has to be reallocated */
+#define GCFD_PROFILE_CREATE(m,rows,cols,type) Profiler::create(m,rows,cols,type)
+/*! Count a Mat temporary (e.g. a clone) in the current stage */
+#define GCFD_PROFILE_TEMPORARY(m) Profiler::countAllocation((m).total()*(m).elemSize())
+#else
+#define GCFD_PROFILE_SCOPE(name)
+#define GCFD_PROFILE_CREATE(m,rows,cols,type) (m).create(rows,cols,type)
+#define GCFD_PROFILE_TEMPORARY(m)
+#endif
+
+/*!
+ *  \brief Statistics of a stage
+ */
+struct ProfileStage {
+	string name;		/*!< The name of the stage */
+	int64 count;		/*!< Number of times the stage has been run */
+	double total;		/*!< Total time in seconds */
+	double min;			/*!< Shortest run in seconds */
+	double max;			/*!< Longest run in seconds */
+	int64 allocations;	/*!< Number of Mat allocated in the stage (not in the nested stages) */
+	int64 bytes;		/*!< Number of bytes allocated in the stage (not in the nested stages) */
+
+	ProfileStage();
+};
+
+/*! \class Profiler
+   * \brief Aggregate the timers and the allocation counters of all the threads
+   *
+   *  Each thread records its stages in its own statistics, without any lock, so the report
+   *  gives the time spent by each thread in each stage and their sum. The runs of the stages
+   *  can also be recorded as events and written in the Chrome trace format (chrome://tracing
+   *  or https://ui.perfetto.dev) to see the overlap of the threads.
+   *
+   *  The times include the nested stages: the time of CFT/projection is part of the time of
+   *  GCFD1/computeFeatures. The allocations are counted only in the innermost stage.
+   *
+   *  The statistics can be read at any time, but a snapshot taken while the profiled threads
+   *  are running misses their running stages and mixes stages of different moments: the
+   *  results are only meaningful once the threads are idle (e.g. after parallel_for_ or
+   *  StreamingExtractor_ returns).
+   */
+class Profiler {
+public:
+	/*!
+	 *  \brief Check if the library has been compiled with the instrumentation
+	 *
+	 *  \return Return true if GCFD_PROFILING was defined
+	 */
+	static bool isEnabled();
+	/*!
+	 *  \brief Record each run of a stage as an event for writeChromeTrace
+	 *
+	 *  \param tracing : True to record the events (false by default: only the statistics are kept)
+	 */
+	static void setTracing(const bool& tracing);
+	/*!
+	 *  \brief Clear the statistics and the events of all the threads
+	 *
+	 *  Can be called while stages are running: each thread clears its statistics when it
+	 *  starts or ends its next stage, and a stage running during the reset is counted when it ends.
+	 */
+	static void reset();
+	/*!
+	 *  \brief Get the number of threads which have run a stage
+	 *
+	 *  \return Return the number of threads, the threads which have ended are kept
+	 */
+	static int getNbThreads();
+	/*!
+	 *  \brief Get the statistics of a thread
+	 *
+	 *  \param thread : The index of the thread, in the order of their first stage
+	 *  \return Return the statistics of each stage run since the last reset
+	 */
+	static vector<ProfileStage> getStages(const int& thread);
+	/*!
+	 *  \brief Get the statistics of all the threads
+	 *
+	 *  \return Return the statistics of each stage, summed over the threads
+	 */
+	static vector<ProfileStage> getStages();
+	/*!
+	 *  \brief Write the statistics in a JSON file
+	 *
+	 *  \param path : The path of the file, with the total and the statistics of each thread
+	 */
+	static void writeJSON(const string& path);
+	/*!
+	 *  \brief Write the recorded events in the Chrome trace format
+	 *
+	 *  \param path : The path of the file
+	 */
+	static void writeChromeTrace(const string& path);
+	/*!
+	 *  \brief Print the statistics of all the threads
+	 *
+	 *  \param out : The output stream
+	 */
+	static void print(std::ostream& out);
+	/*!
+	 *  \brief Count an allocation in the current stage of the thread
+	 *
+	 *  \param bytes : The size of the allocation
+	 */
+	static void countAllocation(const size_t& bytes);
+	/*!
+	 *  \brief Call Mat::create and count the allocation if the Mat is reallocated
+	 *
+	 *  \param m : A Mat
+	 *  \param rows : The number of rows
+	 *  \param cols : The number of columns
+	 *  \param type : The type
+	 */
+	static void create(Mat& m,const int& rows,const int& cols,const int& type);
+};
+
+/*! \class ProfileScope
+   * \brief Timer of a stage, from its construction to its destruction (see GCFD_PROFILE_SCOPE)
+   */
+class ProfileScope {
+private:
+	void* thread;		/*!< The statistics of the thread */
+	int stage;			/*!< The index of the stage in the statistics of the thread */
+	int64 start;		/*!< Start of the stage (cv::getTickCount) */
+
+	ProfileScope(const ProfileScope&);
+	ProfileScope& operator=(const ProfileScope&);
+
+public:
+	/*!
+	 *  \brief Start a stage
+	 *
+	 *  \param name : The name of the stage, a string which must live until the end of the program (a literal)
+	 *
+	 */
+	ProfileScope(const char* name);
+	~ProfileScope();
+};
+
+#endif /* PROFILER_H_ */
@@ -0,0 +1,116 @@
+/**
+ * \file RealFFT2.cpp
+ * \brief Tools to use the packed (CCS) spectrum of a real image
+ * \version 1.0
+ * \date October 17, 2026
+ *
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the distribution
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "RealFFT2.h"
+#include "SpectrumTools.h"
+#include "Profiler.h"
+
+void RealFFT2::computeFFT2(const Mat& X,Mat& ccs){
+	GCFD_PROFILE_SCOPE("FFT2/computeFFT2");
+	CV_Assert(X.channels()==1);
+	if(X.depth()==CV_64F)
+		dft(X,ccs,0,0);
+	else{
+		Mat in;
+		X.convertTo(in,CV_64F);
+		dft(in,ccs,0,0);
+	}
+}
+
+void RealFFT2::getCoefficient(const Mat& ccs,int u,int v,double& re,double& im){
+	const int M=ccs.rows;
+	const int N=ccs.cols;
+	double sign=1;
+	if(v>N/2){
+		// F(u,v)=conj(F(-u,-v))
+		u=(M-u)%M;
+		v=N-v;
+		sign=-1;
+	}
+	if(v>0 && !(N%2==0 && v==N/2)){
+		const double* p=ccs.ptr<double>(u)+2*v-1;
+		re=p[0];
+		im=sign*p[1];
+		return;
+	}
+	// The first column (and the last one if N is even) is the spectrum of a real column
+	const int col=v==0 ? 0 : N-1;
+	if(u>M/2){
+		u=M-u;
+		sign=-sign;
+	}
+	if(u==0){
+		re=ccs.at<double>(0,col);
+		im=0;
+	}
+	else if(M%2==0 && u==M/2){
+		re=ccs.at<double>(M-1,col);
+		im=0;
+	}
+	else{
+		re=ccs.at<double>(2*u-1,col);
+		im=sign*ccs.at<double>(2*u,col);
+	}
+}
+
+void RealFFT2::unpack(const Mat& ccs,Mat& fft2){
+	CV_Assert(ccs.type()==CV_64FC1);
+	fft2.create(ccs.rows,ccs.cols,CV_64FC2);
+	for(int u=0;u<ccs.rows;u++){
+		double* p=fft2.ptr<double>(u);
+		for(int v=0;v<ccs.cols;v++)
+			getCoefficient(ccs,u,v,p[2*v],p[2*v+1]);
+	}
+}
+
+void RealFFT2::halfEnergy(const Mat& ccs,Mat& E){
+	CV_Assert(ccs.type()==CV_64FC1);
+	E.create(ccs.rows,ccs.cols/2+1,CV_64FC1);
+	for(int u=0;u<E.rows;u++){
+		double* e=E.ptr<double>(u);
+		for(int v=0;v<E.cols;v++){
+			double re,im;
+			getCoefficient(ccs,u,v,re,im);
+			e[v]=re*re+im*im;
+		}
+	}
+}
+
+Mat RealFFT2::halfMagnitude(const Mat& ccs){
+	Mat E;
+	halfEnergy(ccs,E);
+	sqrt(E,E);
+	return E;
+}
+
+void RealFFT2::fftshift(Mat& half){
+	GCFD_PROFILE_SCOPE("FFT2/fftshift");
+	SpectrumTools::roll(half,half.rows/2+1,0);
+}
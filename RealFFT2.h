@@ -0,0 +1,98 @@
+/**
+ * \file RealFFT2.h
+ * \brief Tools to use the packed (CCS) spectrum of a real image
+ * \version 1.0
+ * \date October 17, 2026
+ *
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the distribution
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef REALFFT2_H_
+#define REALFFT2_H_
+
+#include <iostream>
+#include <opencv/cv.h>
+#include <opencv/highgui.h>
+
+using namespace cv;
+
+/*! \class RealFFT2
+   * \brief Tools to use the packed spectrum of a real image
+   *
+   *  The spectrum of a real image is hermitian, so cv::dft only gives the half plane of the
+   *  non redundant coefficients, packed in a Mat of the size of the image (CCS format).
+   *  Computing it is about twice as fast as the complex spectrum given by FFT2 and it uses
+   *  half the memory. These functions read the packed spectrum without unpacking it.
+   */
+class RealFFT2 {
+public:
+	/*!
+	 *  \brief Compute the packed spectrum of a real image
+	 *
+	 *  \param X : A gray level image
+	 *  \param ccs : The packed spectrum (a Mat of double of the size of X)
+	 */
+	static void computeFFT2(const Mat& X,Mat& ccs);
+	/*!
+	 *  \brief Get a coefficient of the spectrum
+	 *
+	 *  \param ccs : A packed spectrum
+	 *  \param u : The row of the coefficient in the (unshifted) complex spectrum
+	 *  \param v : The column of the coefficient in the (unshifted) complex spectrum
+	 *  \param re : The real part of the coefficient
+	 *  \param im : The imaginary part of the coefficient
+	 */
+	static void getCoefficient(const Mat& ccs,int u,int v,double& re,double& im);
+	/*!
+	 *  \brief Unpack the spectrum
+	 *
+	 *  \param ccs : A packed spectrum
+	 *  \param fft2 : The complex spectrum, as given by FFT2
+	 */
+	static void unpack(const Mat& ccs,Mat& fft2);
+	/*!
+	 *  \brief Compute the energy of the half plane of the spectrum
+	 *
+	 *  \param ccs : A packed spectrum of size rows x cols
+	 *  \param E : The squared magnitude of the columns 0 to cols/2 of the spectrum (a Mat of double)
+	 */
+	static void halfEnergy(const Mat& ccs,Mat& E);
+	/*!
+	 *  \brief Compute the magnitude of the half plane of the spectrum
+	 *
+	 *  \param ccs : A packed spectrum of size rows x cols
+	 *  \return Return the magnitude of the columns 0 to cols/2 of the spectrum
+	 */
+	static Mat halfMagnitude(const Mat& ccs);
+	/*!
+	 *  \brief Perform a fftshift on a half plane
+	 *
+	 *  The rows are shifted in place as in FFT2::fftshift, the columns (the positive frequencies) are unchanged.
+	 *
+	 *  \param half : A half plane given by halfEnergy or halfMagnitude
+	 */
+	static void fftshift(Mat& half);
+};
+
+#endif /* REALFFT2_H_ */
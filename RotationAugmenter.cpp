@@ -0,0 +1,165 @@
+/**
+ * \file RotationAugmenter.cpp
+ * \brief Batched rotation augmentation feeding a descriptor extractor
+ * \version 1.0
+ * \date October 17, 2026
+ *
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the distribution
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "RotationAugmenter.h"
+#include "MatArena.h"
+#include <algorithm>
+#include <cmath>
+
+/*! \class RotationAugmenterBody
+   * \brief Body of the parallel loop of RotationAugmenter_::compute, one (image,angle) pair per iteration
+   */
+template<typename T> class RotationAugmenterBody : public ParallelLoopBody {
+private:
+	const RotationAugmenter_<T>* augmenter;		/*!< The augmenter */
+	const vector<Mat>* images;					/*!< The images */
+	int nbMappers;								/*!< The number of mappers applied to each image */
+	Mat* res;									/*!< The descriptors, one per row */
+public:
+	RotationAugmenterBody(const RotationAugmenter_<T>* augmenter,const vector<Mat>* images,const int& nbMappers,Mat* res)
+		: augmenter(augmenter), images(images), nbMappers(nbMappers), res(res) {
+	}
+	virtual void operator()(const Range& range) const{
+		const Size rotatedSize=augmenter->getRotatedSize();
+		AutoBuffer<double> buffer(res->cols);
+		double* descriptor=buffer;
+		for(int r=range.start;r<range.end;r++){
+			const Mat& im=(*images)[r/nbMappers];
+			MatArenaScope scope;
+			// remap writes into the Mat of the arena, which has the size and the type of its output
+			Mat rotated=scope.create(rotatedSize.height,rotatedSize.width,im.type());
+			augmenter->mappers[r%nbMappers].apply(im,rotated);
+			augmenter->extractor->extract(rotated,descriptor);
+			T* row=res->ptr<T>(r);
+			for(int k=0;k<res->cols;k++)
+				row[k]=(T)descriptor[k];
+		}
+	}
+};
+
+template<typename T> RotationAugmenter_<T>::RotationAugmenter_(const DescriptorType& type,const Mat& Biv,const Size& size,const vector<double>& angles,const RotationFrame& frame,const int& interpolation,const FFTBackend& backend)
+	: size(size), angles(angles), reference(-1) {
+	CV_Assert(!angles.empty());
+	for(size_t a=0;a<angles.size();a++){
+		mappers.push_back(RotationMapper(size,angles[a],frame,interpolation));
+		if(reference<0 && angles[a]==0)
+			reference=(int)a;
+	}
+	if(reference<0){
+		reference=(int)mappers.size();
+		mappers.push_back(RotationMapper(size,0,frame,interpolation));
+	}
+	extractor=new DescriptorExtractor_<T>(type,Biv,RotationMapper::getRotatedSize(size,frame),backend);
+}
+
+template<typename T> void RotationAugmenter_<T>::rotate(const Mat& im,const int& a,Mat& rotated) const{
+	CV_Assert(a>=0 && a<getNbAngles());
+	mappers[a].apply(im,rotated);
+}
+
+template<typename T> Mat RotationAugmenter_<T>::computeMappers(const vector<Mat>& images,const int& nbMappers) const{
+	for(size_t i=0;i<images.size();i++)
+		CV_Assert(images[i].size()==size);
+	Mat res((int)images.size()*nbMappers,getDescriptorSize(),DataType<T>::depth);
+	parallel_for_(Range(0,res.rows),RotationAugmenterBody<T>(this,&images,nbMappers,&res),res.rows);
+	return res;
+}
+
+template<typename T> Mat RotationAugmenter_<T>::compute(const vector<Mat>& images) const{
+	return computeMappers(images,getNbAngles());
+}
+
+template<typename T> vector<RotationDrift> RotationAugmenter_<T>::validate(const vector<Mat>& images,Mat* descriptors) const{
+	// The reference is computed with the angles when 0 is not one of them
+	const int nbMappers=(int)mappers.size();
+	const int nbAngles=getNbAngles();
+	Mat all=computeMappers(images,nbMappers);
+	const int D=all.cols;
+	// The null frequency is the first value of each part of the descriptor (two parts for GCFD1)
+	const int n=extractor->getType()==GCFD1_DESCRIPTOR ? D/2 : D;
+
+	vector<RotationDrift> res(nbAngles);
+	for(int a=0;a<nbAngles;a++){
+		double sum=0,sum2=0,maxDrift=0;
+		for(size_t i=0;i<images.size();i++){
+			const T* d=all.ptr<T>((int)i*nbMappers+a);
+			const T* d0=all.ptr<T>((int)i*nbMappers+reference);
+			double diff=0,norm=0;
+			for(int k=0;k<D;k++){
+				if(k%n==0)
+					continue;
+				diff+=((double)d[k]-d0[k])*((double)d[k]-d0[k]);
+				norm+=(double)d0[k]*d0[k];
+			}
+			double drift=norm>0 ? std::sqrt(diff/norm) : 0;
+			sum+=drift;
+			sum2+=drift*drift;
+			maxDrift=std::max(maxDrift,drift);
+		}
+		const double count=(double)std::max<size_t>(images.size(),1);
+		res[a].angle=angles[a];
+		res[a].mean=sum/count;
+		res[a].stdDev=std::sqrt(std::max(sum2/count-res[a].mean*res[a].mean,0.));
+		res[a].max=maxDrift;
+	}
+
+	if(descriptors){
+		if(nbMappers==nbAngles)
+			*descriptors=all;
+		else{
+			descriptors->create((int)images.size()*nbAngles,D,all.type());
+			for(int i=0;i<(int)images.size();i++)
+				all.rowRange(i*nbMappers,i*nbMappers+nbAngles).copyTo(descriptors->rowRange(i*nbAngles,(i+1)*nbAngles));
+		}
+	}
+	return res;
+}
+
+template<typename T> int RotationAugmenter_<T>::getNbAngles() const{
+	return (int)angles.size();
+}
+
+template<typename T> const vector<double>& RotationAugmenter_<T>::getAngles() const{
+	return angles;
+}
+
+template<typename T> Size RotationAugmenter_<T>::getRotatedSize() const{
+	return mappers[0].getRotatedSize();
+}
+
+template<typename T> int RotationAugmenter_<T>::getDescriptorSize() const{
+	return extractor->getDescriptorSize();
+}
+
+template<typename T> RotationAugmenter_<T>::~RotationAugmenter_() {
+}
+
+template class RotationAugmenter_<float>;
+template class RotationAugmenter_<double>;
@@ -0,0 +1,164 @@
+/**
+ * \file RotationAugmenter.h
+ * \brief Batched rotation augmentation feeding a descriptor extractor
+ * \version 1.0
+ * \date October 17, 2026
+ *
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the distribution
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef ROTATIONAUGMENTER_H_
+#define ROTATIONAUGMENTER_H_
+
+#include <iostream>
+#include <opencv/cv.h>
+#include <opencv/highgui.h>
+#include <vector>
+#include "DescriptorExtractor.h"
+#include "RotationMapper.h"
+
+using namespace cv;
+
+template<typename T> class RotationAugmenterBody;
+
+/*!
+ *  \brief The drift of the descriptors of the images rotated by an angle
+ *
+ *  The drift of an image is the relative L2 distance |d(a)-d(0)|/|d(0)| between the
+ *  descriptor of the rotated image and the one of the image rotated by 0 degree (in the same
+ *  frame), on the energies of the circles only: the energies at the null frequency are not
+ *  normalized and are left out.
+ */
+struct RotationDrift {
+	double angle;		/*!< The angle in degrees */
+	double mean;		/*!< The mean drift of the images */
+	double stdDev;		/*!< The standard deviation of the drift of the images */
+	double max;			/*!< The largest drift of the images */
+};
+
+/*! \class RotationAugmenter_
+   * \brief Compute the descriptors of a set of images rotated by a set of angles
+   *
+   *  The rotations are computed by one RotationMapper per angle, built once by the constructor,
+   *  and the descriptors by a single DescriptorExtractor_ of the size of the rotated images. The
+   *  (image,angle) pairs are distributed on the threads; the rotated images are temporaries of
+   *  the arena of the thread (see MatArena), so nothing is allocated per pair once the threads
+   *  have their workspaces.
+   *
+   *  The GFD and GCFD descriptors being invariant to the rotations up to the sampling, validate()
+   *  measures how far the rotated descriptors are from the descriptor of the unrotated image.
+   *
+   *  T is the precision of the spectra (float or double), see CFTPlan_.
+   */
+template<typename T> class RotationAugmenter_ {
+private:
+	Size size;									/*!< The size of the images */
+	vector<double> angles;						/*!< The angles of the rotations in degrees */
+	vector<RotationMapper> mappers;				/*!< One mapper per angle, followed by the one of 0 degree if 0 is not an angle */
+	int reference;								/*!< The index of the mapper of 0 degree */
+	Ptr<DescriptorExtractor_<T> > extractor;	/*!< The extractor of the rotated size */
+
+	friend class RotationAugmenterBody<T>;
+
+	/*!
+	 *  \brief Compute the descriptors of the images rotated by the mappers [0,nbMappers[
+	 *
+	 *  \param images : Color images of the size of the object
+	 *  \param nbMappers : The number of mappers to apply
+	 *  \return Return a Mat of T with one descriptor per row, the row i*nbMappers+a for the image i and the mapper a
+	 */
+	Mat computeMappers(const vector<Mat>& images,const int& nbMappers) const;
+
+	RotationAugmenter_(const RotationAugmenter_&);
+	RotationAugmenter_& operator=(const RotationAugmenter_&);
+
+public:
+	/*!
+	 *  \brief Constructor of RotationAugmenter_ class
+	 *
+	 *  \param type : The descriptor to compute
+	 *  \param Biv : A color vector used to build the bivector B=Biv^e4
+	 *  \param size : The size of the images
+	 *  \param angles : The angles of the rotations in degrees
+	 *  \param frame : The frame of the rotated images (ROTATION_SQUARE for rotateColIm)
+	 *  \param interpolation : The interpolation of the rotations
+	 *  \param backend : The implementation of the DFTs (see BatchFFT_)
+	 *
+	 */
+	RotationAugmenter_(const DescriptorType& type,const Mat& Biv,const Size& size,const vector<double>& angles,const RotationFrame& frame=ROTATION_SQUARE,const int& interpolation=INTER_LINEAR,const FFTBackend& backend=FFT_BACKEND_AUTO);
+	/*!
+	 *  \brief Rotate an image by one of the angles
+	 *
+	 *  \param im : An image of the size of the object
+	 *  \param a : The index of the angle
+	 *  \param rotated : The output, an image of getRotatedSize()
+	 */
+	void rotate(const Mat& im,const int& a,Mat& rotated) const;
+	/*!
+	 *  \brief Compute the descriptors of the rotated images in parallel
+	 *
+	 *  \param images : Color images of the size of the object (3 or 4 channels, uchar, float or double)
+	 *  \return Return a Mat of T with one descriptor per row, the row i*getNbAngles()+a for the image i rotated by the angle a
+	 */
+	Mat compute(const vector<Mat>& images) const;
+	/*!
+	 *  \brief Compute the drift of the descriptors for each angle
+	 *
+	 *  \param images : Color images of the size of the object
+	 *  \param descriptors : If not null, receives the descriptors of compute(images)
+	 *  \return Return the statistics of the drift of the images, one element per angle
+	 */
+	vector<RotationDrift> validate(const vector<Mat>& images,Mat* descriptors=0) const;
+	/*!
+	 *  \brief Get the number of angles
+	 *
+	 *  \return Return the number of rotations of each image
+	 */
+	int getNbAngles() const;
+	/*!
+	 *  \brief Get the angles
+	 *
+	 *  \return Return the angles given to the constructor
+	 */
+	const vector<double>& getAngles() const;
+	/*!
+	 *  \brief Get the size of the rotated images
+	 *
+	 *  \return Return the size of the images given to the extractor
+	 */
+	Size getRotatedSize() const;
+	/*!
+	 *  \brief Get the number of values of a descriptor
+	 *
+	 *  \return Return the number of columns of compute()
+	 */
+	int getDescriptorSize() const;
+
+	virtual ~RotationAugmenter_();
+};
+
+typedef RotationAugmenter_<double> RotationAugmenter;
+typedef RotationAugmenter_<float> RotationAugmenterf;
+
+#endif /* ROTATIONAUGMENTER_H_ */
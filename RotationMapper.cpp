@@ -0,0 +1,103 @@
+/**
+ * \file RotationMapper.cpp
+ * \brief Rotate images of a given size with precomputed sampling tables
+ * \version 1.0
+ * \date October 17, 2026
+ *
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the distribution
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "RotationMapper.h"
+#include "Profiler.h"
+
+RotationMapper::RotationMapper() : size(), angle(0), frame(ROTATION_SAME_SIZE), interpolation(INTER_LINEAR) {
+}
+
+RotationMapper::RotationMapper(const Size& size,const double& angle,const RotationFrame& frame,const int& interpolation)
+		: size(size), angle(angle), frame(frame), interpolation(interpolation) {
+	build();
+}
+
+void RotationMapper::build(){
+	CV_Assert(size.width>0 && size.height>0);
+	const Size out=getRotatedSize(size,frame);
+	// Same center and matrix as the legacy functions: rotateIm computes the center in float,
+	// rotateColIm in double (then converted to the float of Point2f)
+	Point2f center;
+	if(frame==ROTATION_SAME_SIZE)
+		center=Point2f(size.width/2.0f,size.height/2.0f);
+	else
+		center=Point2f((float)(out.width/2.),(float)(out.height/2.));
+	Mat M=getRotationMatrix2D(center,angle,1.0);
+	// cv::warpAffine samples the source at the inverse transform of each pixel of the output
+	Mat iM;
+	invertAffineTransform(M,iM);
+	const double* m=iM.ptr<double>(0);
+	Mat mapX(out,CV_32FC1);
+	Mat mapY(out,CV_32FC1);
+	for(int y=0;y<out.height;y++){
+		float* mx=mapX.ptr<float>(y);
+		float* my=mapY.ptr<float>(y);
+		for(int x=0;x<out.width;x++){
+			mx[x]=(float)(m[0]*x+m[1]*y+m[2]);
+			my[x]=(float)(m[3]*x+m[4]*y+m[5]);
+		}
+	}
+	convertMaps(mapX,mapY,map1,map2,CV_16SC2,interpolation==INTER_NEAREST);
+}
+
+void RotationMapper::apply(const Mat& im,Mat& rotated) const{
+	GCFD_PROFILE_SCOPE("Rotation/remap");
+	CV_Assert(im.size()==size);
+	CV_Assert(im.data!=rotated.data || im.empty());
+	remap(im,rotated,map1,map2,interpolation,BORDER_CONSTANT,Scalar::all(0));
+}
+
+Mat RotationMapper::apply(const Mat& im) const{
+	Mat rotated;
+	apply(im,rotated);
+	return rotated;
+}
+
+Size RotationMapper::getSize() const{
+	return size;
+}
+
+Size RotationMapper::getRotatedSize() const{
+	return getRotatedSize(size,frame);
+}
+
+double RotationMapper::getAngle() const{
+	return angle;
+}
+
+Size RotationMapper::getRotatedSize(const Size& size,const RotationFrame& frame){
+	if(frame==ROTATION_SAME_SIZE)
+		return size;
+	int len=std::max(size.width,size.height);
+	return Size(len,len);
+}
+
+RotationMapper::~RotationMapper() {
+}
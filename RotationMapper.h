@@ -0,0 +1,130 @@
+/**
+ * \file RotationMapper.h
+ * \brief Rotate images of a given size with precomputed sampling tables
+ * \version 1.0
+ * \date October 17, 2026
+ *
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the distribution
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef ROTATIONMAPPER_H_
+#define ROTATIONMAPPER_H_
+
+#include <iostream>
+#include <opencv/cv.h>
+#include <opencv/highgui.h>
+#include <vector>
+
+using namespace cv;
+
+/*!
+ *  \brief The frame of the rotated images, see the legacy functions of MyTools
+ */
+enum RotationFrame {
+	ROTATION_SAME_SIZE,		/*!< As MyTools::rotateIm: the size of the image, rotated around (cols/2,rows/2) */
+	ROTATION_SQUARE			/*!< As MyTools::rotateColIm: a square of the largest side len, rotated around (len/2,len/2) */
+};
+
+/*! \class RotationMapper
+   * \brief Rotate images of a given size by a given angle with precomputed sampling tables
+   *
+   *  MyTools::rotateIm and rotateColIm build the rotation matrix and let cv::warpAffine compute
+   *  the coordinates of all the pixels at each call. A mapper computes them once for a size, an
+   *  angle and an interpolation, in the fixed-point format of cv::remap, and apply() is a single
+   *  cv::remap (vectorised and multi-threaded by OpenCV) for all the channels of the image.
+   *
+   *  The rotated image is the one of the legacy function of the frame, the missing parts being
+   *  set to 0, up to the rounding of the interpolation coefficients (at most one gray level).
+   */
+class RotationMapper {
+private:
+	Size size;				/*!< The size of the images */
+	double angle;			/*!< The angle of the rotation in degrees (counter-clockwise, as cv::getRotationMatrix2D) */
+	RotationFrame frame;	/*!< The frame of the rotated images */
+	int interpolation;		/*!< The interpolation of cv::remap */
+	Mat map1;				/*!< Integer coordinates (CV_16SC2) of each pixel of the rotated image */
+	Mat map2;				/*!< Interpolation coefficients (CV_16UC1, empty for INTER_NEAREST) */
+
+	/*!
+	 *  \brief Compute the sampling tables
+	 */
+	void build();
+
+public:
+	RotationMapper();
+	/*!
+	 *  \brief Constructor of RotationMapper class
+	 *
+	 *  \param size : The size of the images
+	 *  \param angle : The angle of the rotation in degrees
+	 *  \param frame : The frame of the rotated images (ROTATION_SQUARE for rotateColIm)
+	 *  \param interpolation : The interpolation of cv::remap (INTER_LINEAR in the legacy functions)
+	 *
+	 */
+	RotationMapper(const Size& size,const double& angle,const RotationFrame& frame,const int& interpolation=INTER_LINEAR);
+	/*!
+	 *  \brief Rotate an image
+	 *
+	 *  \param im : An image of the size of the mapper, with any number of channels
+	 *  \param rotated : The output, an image of getRotatedSize() (not reallocated if it has this size and the type of im)
+	 */
+	void apply(const Mat& im,Mat& rotated) const;
+	/*!
+	 *  \brief Rotate an image
+	 *
+	 *  \param im : An image of the size of the mapper, with any number of channels
+	 *  \return Return the rotated image
+	 */
+	Mat apply(const Mat& im) const;
+	/*!
+	 *  \brief Get the size of the images
+	 *
+	 *  \return Return the size given to the constructor
+	 */
+	Size getSize() const;
+	/*!
+	 *  \brief Get the size of the rotated images
+	 *
+	 *  \return Return the size of the images given by apply()
+	 */
+	Size getRotatedSize() const;
+	/*!
+	 *  \brief Get the angle of the rotation
+	 *
+	 *  \return Return the angle in degrees
+	 */
+	double getAngle() const;
+	/*!
+	 *  \brief Get the size of the rotated images of a frame
+	 *
+	 *  \param size : The size of the images
+	 *  \param frame : The frame of the rotated images
+	 *  \return Return the size of the rotated images
+	 */
+	static Size getRotatedSize(const Size& size,const RotationFrame& frame);
+
+	virtual ~RotationMapper();
+};
+
+#endif /* ROTATIONMAPPER_H_ */
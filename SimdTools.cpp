@@ -0,0 +1,203 @@
+/**
+ * \file SimdTools.cpp
+ * \brief Vectorised kernels of the descriptor pipeline
+ * \version 1.0
+ * \date October 17, 2026
+ *
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the distribution
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "SimdTools.h"
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+void SimdTools::combineComplex(const float* x0,const float* x1,const float* x2,const float* x3,const float* cRe,const float* cIm,float* out,const int& n){
+	int j=0;
+#ifdef __SSE2__
+	const __m128 r0=_mm_set1_ps(cRe[0]),r1=_mm_set1_ps(cRe[1]),r2=_mm_set1_ps(cRe[2]);
+	const __m128 i0=_mm_set1_ps(cIm[0]),i1=_mm_set1_ps(cIm[1]),i2=_mm_set1_ps(cIm[2]);
+	for(;j<=n-4;j+=4){
+		__m128 a=_mm_loadu_ps(x0+j),b=_mm_loadu_ps(x1+j),c=_mm_loadu_ps(x2+j);
+		__m128 re=_mm_add_ps(_mm_add_ps(_mm_mul_ps(r0,a),_mm_mul_ps(r1,b)),_mm_mul_ps(r2,c));
+		__m128 im=_mm_add_ps(_mm_add_ps(_mm_mul_ps(i0,a),_mm_mul_ps(i1,b)),_mm_mul_ps(i2,c));
+		if(x3){
+			__m128 d=_mm_loadu_ps(x3+j);
+			re=_mm_add_ps(re,_mm_mul_ps(_mm_set1_ps(cRe[3]),d));
+			im=_mm_add_ps(im,_mm_mul_ps(_mm_set1_ps(cIm[3]),d));
+		}
+		_mm_storeu_ps(out+2*j,_mm_unpacklo_ps(re,im));
+		_mm_storeu_ps(out+2*j+4,_mm_unpackhi_ps(re,im));
+	}
+#endif
+	for(;j<n;j++){
+		float re=cRe[0]*x0[j]+cRe[1]*x1[j]+cRe[2]*x2[j];
+		float im=cIm[0]*x0[j]+cIm[1]*x1[j]+cIm[2]*x2[j];
+		if(x3){
+			re+=cRe[3]*x3[j];
+			im+=cIm[3]*x3[j];
+		}
+		out[2*j]=re;
+		out[2*j+1]=im;
+	}
+}
+
+void SimdTools::combineComplex(const double* x0,const double* x1,const double* x2,const double* x3,const double* cRe,const double* cIm,double* out,const int& n){
+	int j=0;
+#ifdef __SSE2__
+	const __m128d r0=_mm_set1_pd(cRe[0]),r1=_mm_set1_pd(cRe[1]),r2=_mm_set1_pd(cRe[2]);
+	const __m128d i0=_mm_set1_pd(cIm[0]),i1=_mm_set1_pd(cIm[1]),i2=_mm_set1_pd(cIm[2]);
+	for(;j<=n-2;j+=2){
+		__m128d a=_mm_loadu_pd(x0+j),b=_mm_loadu_pd(x1+j),c=_mm_loadu_pd(x2+j);
+		__m128d re=_mm_add_pd(_mm_add_pd(_mm_mul_pd(r0,a),_mm_mul_pd(r1,b)),_mm_mul_pd(r2,c));
+		__m128d im=_mm_add_pd(_mm_add_pd(_mm_mul_pd(i0,a),_mm_mul_pd(i1,b)),_mm_mul_pd(i2,c));
+		if(x3){
+			__m128d d=_mm_loadu_pd(x3+j);
+			re=_mm_add_pd(re,_mm_mul_pd(_mm_set1_pd(cRe[3]),d));
+			im=_mm_add_pd(im,_mm_mul_pd(_mm_set1_pd(cIm[3]),d));
+		}
+		_mm_storeu_pd(out+2*j,_mm_unpacklo_pd(re,im));
+		_mm_storeu_pd(out+2*j+2,_mm_unpackhi_pd(re,im));
+	}
+#endif
+	for(;j<n;j++){
+		double re=cRe[0]*x0[j]+cRe[1]*x1[j]+cRe[2]*x2[j];
+		double im=cIm[0]*x0[j]+cIm[1]*x1[j]+cIm[2]*x2[j];
+		if(x3){
+			re+=cRe[3]*x3[j];
+			im+=cIm[3]*x3[j];
+		}
+		out[2*j]=re;
+		out[2*j+1]=im;
+	}
+}
+
+void SimdTools::combineReal(const float* x0,const float* x1,const float* x2,const float* c,float* out,const int& n){
+	int j=0;
+#ifdef __SSE2__
+	const __m128 c0=_mm_set1_ps(c[0]),c1=_mm_set1_ps(c[1]),c2=_mm_set1_ps(c[2]);
+	for(;j<=n-4;j+=4){
+		__m128 s=_mm_add_ps(_mm_mul_ps(c0,_mm_loadu_ps(x0+j)),_mm_mul_ps(c1,_mm_loadu_ps(x1+j)));
+		_mm_storeu_ps(out+j,_mm_add_ps(s,_mm_mul_ps(c2,_mm_loadu_ps(x2+j))));
+	}
+#endif
+	for(;j<n;j++)
+		out[j]=c[0]*x0[j]+c[1]*x1[j]+c[2]*x2[j];
+}
+
+void SimdTools::combineReal(const double* x0,const double* x1,const double* x2,const double* c,double* out,const int& n){
+	int j=0;
+#ifdef __SSE2__
+	const __m128d c0=_mm_set1_pd(c[0]),c1=_mm_set1_pd(c[1]),c2=_mm_set1_pd(c[2]);
+	for(;j<=n-2;j+=2){
+		__m128d s=_mm_add_pd(_mm_mul_pd(c0,_mm_loadu_pd(x0+j)),_mm_mul_pd(c1,_mm_loadu_pd(x1+j)));
+		_mm_storeu_pd(out+j,_mm_add_pd(s,_mm_mul_pd(c2,_mm_loadu_pd(x2+j))));
+	}
+#endif
+	for(;j<n;j++)
+		out[j]=c[0]*x0[j]+c[1]*x1[j]+c[2]*x2[j];
+}
+
+void SimdTools::energy(const float* z,float* e,const int& n){
+	int j=0;
+#ifdef __SSE2__
+	for(;j<=n-4;j+=4){
+		__m128 a=_mm_loadu_ps(z+2*j),b=_mm_loadu_ps(z+2*j+4);
+		a=_mm_mul_ps(a,a);
+		b=_mm_mul_ps(b,b);
+		__m128 re=_mm_shuffle_ps(a,b,_MM_SHUFFLE(2,0,2,0));
+		__m128 im=_mm_shuffle_ps(a,b,_MM_SHUFFLE(3,1,3,1));
+		_mm_storeu_ps(e+j,_mm_add_ps(re,im));
+	}
+#endif
+	for(;j<n;j++)
+		e[j]=z[2*j]*z[2*j]+z[2*j+1]*z[2*j+1];
+}
+
+void SimdTools::energy(const double* z,double* e,const int& n){
+	int j=0;
+#ifdef __SSE2__
+	for(;j<=n-2;j+=2){
+		__m128d a=_mm_loadu_pd(z+2*j),b=_mm_loadu_pd(z+2*j+2);
+		a=_mm_mul_pd(a,a);
+		b=_mm_mul_pd(b,b);
+		_mm_storeu_pd(e+j,_mm_add_pd(_mm_unpacklo_pd(a,b),_mm_unpackhi_pd(a,b)));
+	}
+#endif
+	for(;j<n;j++)
+		e[j]=z[2*j]*z[2*j]+z[2*j+1]*z[2*j+1];
+}
+
+float SimdTools::squaredDistance(const float* a,const float* b,const int& n){
+	int j=0;
+	// Four partial sums, added as (s0+s2)+(s1+s3) as by the SSE2 horizontal sum
+	float s[4]={0,0,0,0};
+#ifdef __SSE2__
+	__m128 acc=_mm_setzero_ps();
+	for(;j<=n-4;j+=4){
+		__m128 d=_mm_sub_ps(_mm_loadu_ps(a+j),_mm_loadu_ps(b+j));
+		acc=_mm_add_ps(acc,_mm_mul_ps(d,d));
+	}
+	_mm_storeu_ps(s,acc);
+#else
+	for(;j<=n-4;j+=4){
+		for(int l=0;l<4;l++){
+			float d=a[j+l]-b[j+l];
+			s[l]+=d*d;
+		}
+	}
+#endif
+	float res=(s[0]+s[2])+(s[1]+s[3]);
+	for(;j<n;j++){
+		float d=a[j]-b[j];
+		res+=d*d;
+	}
+	return res;
+}
+
+double SimdTools::squaredDistance(const double* a,const double* b,const int& n){
+	int j=0;
+	double s[2]={0,0};
+#ifdef __SSE2__
+	__m128d acc=_mm_setzero_pd();
+	for(;j<=n-2;j+=2){
+		__m128d d=_mm_sub_pd(_mm_loadu_pd(a+j),_mm_loadu_pd(b+j));
+		acc=_mm_add_pd(acc,_mm_mul_pd(d,d));
+	}
+	_mm_storeu_pd(s,acc);
+#else
+	for(;j<=n-2;j+=2){
+		for(int l=0;l<2;l++){
+			double d=a[j+l]-b[j+l];
+			s[l]+=d*d;
+		}
+	}
+#endif
+	double res=s[0]+s[1];
+	for(;j<n;j++){
+		double d=a[j]-b[j];
+		res+=d*d;
+	}
+	return res;
+}
@@ -0,0 +1,98 @@
+/**
+ * \file SimdTools.h
+ * \brief Vectorised kernels of the descriptor pipeline
+ * \version 1.0
+ * \date October 17, 2026
+ *
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the distribution
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SIMDTOOLS_H_
+#define SIMDTOOLS_H_
+
+#include <opencv/cv.h>
+
+using namespace cv;
+
+/*! \class SimdTools
+   * \brief Vectorised kernels of the descriptor pipeline
+   *
+   *  Each kernel exists for float and double. When the compiler targets SSE2 (__SSE2__, always
+   *  the case on x86-64) the kernels use SSE2 intrinsics, four floats or two doubles at a time,
+   *  otherwise a scalar version with the same order of operations is used.
+   */
+class SimdTools {
+public:
+	/*!
+	 *  \brief Compute two linear combinations of planes and interleave them as complex numbers
+	 *
+	 *  out[2j]=cRe[0]*x0[j]+cRe[1]*x1[j]+cRe[2]*x2[j](+cRe[3]*x3[j]) and out[2j+1] is the same with cIm.
+	 *
+	 *  \param x0 : The first plane
+	 *  \param x1 : The second plane
+	 *  \param x2 : The third plane
+	 *  \param x3 : The fourth plane (or null)
+	 *  \param cRe : The coefficients of the real part
+	 *  \param cIm : The coefficients of the imaginary part
+	 *  \param out : The output (2n elements)
+	 *  \param n : The number of elements of the planes
+	 */
+	static void combineComplex(const float* x0,const float* x1,const float* x2,const float* x3,const float* cRe,const float* cIm,float* out,const int& n);
+	static void combineComplex(const double* x0,const double* x1,const double* x2,const double* x3,const double* cRe,const double* cIm,double* out,const int& n);
+	/*!
+	 *  \brief Compute a linear combination of three planes
+	 *
+	 *  out[j]=c[0]*x0[j]+c[1]*x1[j]+c[2]*x2[j]
+	 *
+	 *  \param x0 : The first plane
+	 *  \param x1 : The second plane
+	 *  \param x2 : The third plane
+	 *  \param c : The coefficients
+	 *  \param out : The output (n elements)
+	 *  \param n : The number of elements of the planes
+	 */
+	static void combineReal(const float* x0,const float* x1,const float* x2,const float* c,float* out,const int& n);
+	static void combineReal(const double* x0,const double* x1,const double* x2,const double* c,double* out,const int& n);
+	/*!
+	 *  \brief Compute the squared magnitude of complex numbers
+	 *
+	 *  \param z : The complex numbers (real and imaginary parts interleaved, 2n elements)
+	 *  \param e : The squared magnitudes (n elements)
+	 *  \param n : The number of complex numbers
+	 */
+	static void energy(const float* z,float* e,const int& n);
+	static void energy(const double* z,double* e,const int& n);
+	/*!
+	 *  \brief Compute the squared euclidean distance between two vectors
+	 *
+	 *  \param a : The first vector
+	 *  \param b : The second vector
+	 *  \param n : The number of elements of the vectors
+	 *  \return Return the sum of (a[j]-b[j])^2
+	 */
+	static float squaredDistance(const float* a,const float* b,const int& n);
+	static double squaredDistance(const double* a,const double* b,const int& n);
+};
+
+#endif /* SIMDTOOLS_H_ */
@@ -0,0 +1,190 @@
+/**
+ * \file SpectrumTools.cpp
+ * \brief In-place shift and crop of spectra, and magnitude with the shift folded in the indexing
+ * \version 1.0
+ * \date October 17, 2026
+ *
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the distribution
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "SpectrumTools.h"
+#include "Profiler.h"
+#include <cstring>
+
+/*!
+ *  \brief Copy a row rotated by colShift elements: dst[j]=src[(j+colShift)%n]
+ */
+static void copyRotated(const uchar* src,uchar* dst,const size_t& colShiftBytes,const size_t& rowBytes){
+	memcpy(dst,src+colShiftBytes,rowBytes-colShiftBytes);
+	memcpy(dst+rowBytes-colShiftBytes,src,colShiftBytes);
+}
+
+static int gcd(int a,int b){
+	while(b!=0){
+		int t=a%b;
+		a=b;
+		b=t;
+	}
+	return a;
+}
+
+void SpectrumTools::roll(Mat& X,const int& rowShift,const int& colShift){
+	CV_Assert(X.dims<=2);
+	const int m=X.rows;
+	const int n=X.cols;
+	if(m==0 || n==0)
+		return;
+	const int rs=((rowShift%m)+m)%m;
+	const int cs=((colShift%n)+n)%n;
+	if(rs==0 && cs==0)
+		return;
+	const size_t rowBytes=n*X.elemSize();
+	const size_t csBytes=cs*X.elemSize();
+	AutoBuffer<uchar,16384> buffer(rowBytes);
+	uchar* tmp=buffer;
+
+	if(rs==0){
+		for(int i=0;i<m;i++){
+			memcpy(tmp,X.ptr(i),rowBytes);
+			copyRotated(tmp,X.ptr(i),csBytes,rowBytes);
+		}
+		return;
+	}
+	// The rows are permuted along the gcd(m,rs) cycles of i->i+rs: each row is read once and
+	// written once, rotated, in the previous row of its cycle. Only the first row of a cycle is buffered.
+	const int nbCycles=gcd(m,rs);
+	for(int c=0;c<nbCycles;c++){
+		memcpy(tmp,X.ptr(c),rowBytes);
+		int j=c;
+		for(;;){
+			int k=(j+rs)%m;
+			if(k==c)
+				break;
+			copyRotated(X.ptr(k),X.ptr(j),csBytes,rowBytes);
+			j=k;
+		}
+		copyRotated(tmp,X.ptr(j),csBytes,rowBytes);
+	}
+}
+
+void SpectrumTools::fftshift(Mat& X){
+	GCFD_PROFILE_SCOPE("FFT2/fftshift");
+	roll(X,X.rows/2+1,X.cols/2+1);
+}
+
+void SpectrumTools::ifftshift(Mat& X){
+	GCFD_PROFILE_SCOPE("FFT2/fftshift");
+	roll(X,-(X.rows/2+1),-(X.cols/2+1));
+}
+
+int SpectrumTools::unshiftedIndex(const int& i,const int& n){
+	// Same shift as FFT2::fftshift: the element i of the shifted spectrum is the element i+n/2+1
+	return (i+n/2+1)%n;
+}
+
+int SpectrumTools::uncroppedIndex(const int& i,const int& h,const int& n){
+	// The positive frequencies are at the beginning, the negative ones at the end
+	return i<=h ? i : n-(2*h+1-i);
+}
+
+void SpectrumTools::cropSpectrum(Mat& X){
+	GCFD_PROFILE_SCOPE("FFT2/cropSpectrum");
+	CV_Assert(X.dims<=2);
+	const int h=std::min(X.rows,X.cols)/2;
+	const int N=2*h+1;
+	if(X.rows==N && X.cols==N)
+		return;
+	const size_t es=X.elemSize();
+	if(N>X.rows || N>X.cols){
+		// Even size: the result has one more row or column than X, as FFT2::cropSpectrum
+		Mat res(N,N,X.type());
+		GCFD_PROFILE_TEMPORARY(res);
+		for(int i=0;i<N;i++){
+			const uchar* src=X.ptr(uncroppedIndex(i,h,X.rows));
+			uchar* dst=res.ptr(i);
+			for(int j=0;j<N;j++)
+				memcpy(dst+j*es,src+uncroppedIndex(j,h,X.cols)*es,es);
+		}
+		X=res;
+		return;
+	}
+	// The source of the element (i,j) is at (i+di,j+dj) with di,dj>=0 for the negative frequencies,
+	// so moving the rows in increasing order never overwrites a source which has not been read
+	const size_t lowBytes=(h+1)*es;
+	const size_t highBytes=h*es;
+	for(int i=0;i<N;i++){
+		const int si=uncroppedIndex(i,h,X.rows);
+		const uchar* src=X.ptr(si);
+		uchar* dst=X.ptr(i);
+		if(si!=i)
+			memmove(dst,src,lowBytes);
+		memmove(dst+lowBytes,src+(X.cols-h)*es,highBytes);
+	}
+	X=X(Rect(0,0,N,N));
+}
+
+void SpectrumTools::magnitude(const Mat& X,Mat& mag,const int& flags){
+	CV_Assert(X.dims<=2 && (X.depth()==CV_32F || X.depth()==CV_64F) && X.channels()<=2);
+	const int h=std::min(X.rows,X.cols)/2;
+	const int rows=(flags & SPECTRUM_CROP) ? 2*h+1 : X.rows;
+	const int cols=(flags & SPECTRUM_CROP) ? 2*h+1 : X.cols;
+	CV_Assert(mag.data!=X.data || X.empty());
+
+	// Index of the source of each row and of each column of the output
+	AutoBuffer<int> buffer(rows+cols);
+	int* rowMap=buffer;
+	int* colMap=rowMap+rows;
+	for(int i=0;i<rows;i++){
+		int k=(flags & SPECTRUM_SHIFT) ? unshiftedIndex(i,rows) : i;
+		rowMap[i]=(flags & SPECTRUM_CROP) ? uncroppedIndex(k,h,X.rows) : k;
+	}
+	for(int j=0;j<cols;j++){
+		int k=(flags & SPECTRUM_SHIFT) ? unshiftedIndex(j,cols) : j;
+		colMap[j]=(flags & SPECTRUM_CROP) ? uncroppedIndex(k,h,X.cols) : k;
+	}
+
+	const int cn=X.channels();
+	const bool squared=(flags & SPECTRUM_SQUARED)!=0;
+	GCFD_PROFILE_CREATE(mag,rows,cols,X.depth());
+	for(int i=0;i<rows;i++){
+		if(X.depth()==CV_32F){
+			const float* x=X.ptr<float>(rowMap[i]);
+			float* out=mag.ptr<float>(i);
+			for(int j=0;j<cols;j++){
+				const float* z=x+colMap[j]*cn;
+				float e=cn==2 ? z[0]*z[0]+z[1]*z[1] : z[0]*z[0];
+				out[j]=squared ? e : std::sqrt(e);
+			}
+		}
+		else{
+			const double* x=X.ptr<double>(rowMap[i]);
+			double* out=mag.ptr<double>(i);
+			for(int j=0;j<cols;j++){
+				const double* z=x+colMap[j]*cn;
+				double e=cn==2 ? z[0]*z[0]+z[1]*z[1] : z[0]*z[0];
+				out[j]=squared ? e : std::sqrt(e);
+			}
+		}
+	}
+}
@@ -0,0 +1,128 @@
+/**
+ * \file SpectrumTools.h
+ * \brief In-place shift and crop of spectra, and magnitude with the shift folded in the indexing
+ * \version 1.0
+ * \date October 17, 2026
+ *
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the distribution
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SPECTRUMTOOLS_H_
+#define SPECTRUMTOOLS_H_
+
+#include <iostream>
+#include <opencv/cv.h>
+#include <opencv/highgui.h>
+
+using namespace cv;
+
+/*!
+ *  \brief Options of SpectrumTools::magnitude
+ */
+enum SpectrumFlags {
+	SPECTRUM_SHIFT=1,		/*!< Give the magnitude shifted as by FFT2::fftshift */
+	SPECTRUM_CROP=2,		/*!< Give the magnitude of the spectrum cropped as by FFT2::cropSpectrum */
+	SPECTRUM_SQUARED=4		/*!< Give the squared magnitude (the energy) */
+};
+
+/*! \class SpectrumTools
+   * \brief Shift and crop spectra without temporaries
+   *
+   *  FFT2::fftshift and FFT2::cropSpectrum build their results from sub-Mat copies, transposes
+   *  and push_back, i.e. several temporaries and full passes over the spectrum. The functions
+   *  of this class give the same results in place: each row of the spectrum is moved once with
+   *  two contiguous copies, and the crop only moves the kept columns and returns a header on
+   *  the same data. magnitude() goes further: the shift and the crop are folded in the indices
+   *  of the elements it reads, so the spectrum is not moved at all. CircleTable does the same
+   *  for the integration on the discrete circles.
+   */
+class SpectrumTools {
+public:
+	/*!
+	 *  \brief Perform a circular shift of a Mat in place
+	 *
+	 *  The element (i,j) of the result is the element ((i+rowShift)%rows,(j+colShift)%cols) of X.
+	 *  A buffer of one row is used, on the stack for rows of up to 16 kB.
+	 *
+	 *  \param X : A 2D Mat of any type
+	 *  \param rowShift : The shift of the rows (can be negative)
+	 *  \param colShift : The shift of the columns (can be negative)
+	 */
+	static void roll(Mat& X,const int& rowShift,const int& colShift);
+	/*!
+	 *  \brief Perform a fftshift in place
+	 *
+	 *  Same result as FFT2::fftshift for all the sizes, odd or even.
+	 *
+	 *  \param X : A spectrum (a 2D Mat of any type)
+	 */
+	static void fftshift(Mat& X);
+	/*!
+	 *  \brief Undo fftshift in place
+	 *
+	 *  \param X : A spectrum shifted by fftshift or FFT2::fftshift
+	 */
+	static void ifftshift(Mat& X);
+	/*!
+	 *  \brief Crop a spectrum in place
+	 *
+	 *  Same result as FFT2::cropSpectrum: the (2h+1)x(2h+1) lowest frequencies of the unshifted
+	 *  spectrum, with h=min(rows,cols)/2. If min(rows,cols) is odd, the kept elements are moved
+	 *  in the buffer of X and X becomes a (non continuous) header on it. Otherwise the result is
+	 *  larger than the spectrum in one dimension and is allocated.
+	 *
+	 *  \param X : An unshifted spectrum (a 2D Mat of any type)
+	 */
+	static void cropSpectrum(Mat& X);
+	/*!
+	 *  \brief Compute the magnitude of a spectrum, shifted and cropped without moving the spectrum
+	 *
+	 *  With SPECTRUM_CROP|SPECTRUM_SHIFT, gives the same result as FFT2::cropSpectrum, then
+	 *  MyTools::magnitude, then FFT2::fftshift, in one pass over the kept elements.
+	 *
+	 *  \param X : An unshifted spectrum (a Mat of float or double, real or complex)
+	 *  \param mag : The output, a Mat of the depth of X with one channel
+	 *  \param flags : A combination of SpectrumFlags
+	 */
+	static void magnitude(const Mat& X,Mat& mag,const int& flags=SPECTRUM_SHIFT);
+	/*!
+	 *  \brief Get the index in an unshifted spectrum of an element of the shifted spectrum
+	 *
+	 *  \param i : The index in the shifted spectrum (in [0,n[)
+	 *  \param n : The size of the spectrum along this dimension
+	 *  \return Return the index of the same frequency in the unshifted spectrum
+	 */
+	static int unshiftedIndex(const int& i,const int& n);
+	/*!
+	 *  \brief Get the index in a spectrum of an element of the cropped spectrum
+	 *
+	 *  \param i : The index in the cropped spectrum (in [0,2h+1[)
+	 *  \param h : The half size of the cropped spectrum
+	 *  \param n : The size of the spectrum along this dimension
+	 *  \return Return the index of the same frequency in the spectrum
+	 */
+	static int uncroppedIndex(const int& i,const int& h,const int& n);
+};
+
+#endif /* SPECTRUMTOOLS_H_ */
@@ -0,0 +1,441 @@
+/**
+ * \file StreamingExtractor.cpp
+ * \brief Pipelined computation of the descriptors of a directory or of a video
+ * \version 1.0
+ * \date October 17, 2026
+ *
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the distribution
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "StreamingExtractor.h"
+#include "BoundedQueue.h"
+#include "MyTools.h"
+#include "CircleTableCache.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <cctype>
+#include <dirent.h>
+#include <sys/stat.h>
+
+StreamingConfig::StreamingConfig() : decodeThreads(2), preprocessThreads(1), cftThreads(std::max(1,getNumberOfCPUs())),
+		descriptorThreads(1), queueCapacity(16), size(), recursive(true) {
+	const char* ext[]={"bmp","dib","jpeg","jpg","jpe","jp2","png","pbm","pgm","ppm","sr","ras","tiff","tif"};
+	extensions.assign(ext,ext+sizeof(ext)/sizeof(ext[0]));
+}
+
+void DescriptorSink::fail(const int&,const string&){
+}
+
+DescriptorSink::~DescriptorSink() {
+}
+
+/*!
+ *  \brief An image going through the pipeline
+ */
+template<typename T> struct StreamItem {
+	int index;			/*!< The index of the image in the input */
+	string name;		/*!< The path of the image (empty for a frame) */
+	Mat image;			/*!< The image, released by the CFT stage */
+	Size size;			/*!< The size of the image once cropped */
+	Mat par;			/*!< The parallel part of the CFT, released by the descriptor stage */
+	Mat orth;			/*!< The orthogonal part of the CFT, released by the descriptor stage */
+	Mat descriptor;		/*!< The descriptor */
+	DescriptorCacheKey key;	/*!< The key of the image in the cache of the descriptors */
+	bool failed;		/*!< True if the image cannot be read or computed */
+	bool cached;		/*!< True if the descriptor has been found in the cache */
+	StreamItem() : index(0), failed(false), cached(false) {
+	}
+};
+
+/*!
+ *  \brief The stages of the pipeline run by threads
+ */
+enum StreamStage {
+	DECODE_STAGE,
+	PREPROCESS_STAGE,
+	CFT_STAGE,
+	DESCRIPTOR_STAGE,
+	NB_STREAM_STAGES
+};
+
+/*!
+ *  \brief The queues and the threads of one call to StreamingExtractor_::run
+ *
+ *  queues[s] is the input of the stage s and queues[s+1] its output. The last thread of a stage
+ *  to finish closes the output queue, so the end of the input goes down the pipeline.
+ */
+template<typename T> struct StreamPipeline {
+	const StreamingExtractor_<T>* extractor;	/*!< The extractor which runs the pipeline */
+	const vector<string>* paths;				/*!< The paths of the images (or null) */
+	VideoCapture* capture;						/*!< The video (or null) */
+	BoundedQueue<StreamItem<T> >* queues[NB_STREAM_STAGES+1];	/*!< The queues between the stages */
+	int running[NB_STREAM_STAGES];				/*!< Number of threads of each stage still running */
+	string error;								/*!< The first error which has stopped a thread (empty if none) */
+	Mutex runningMutex;							/*!< Protect running and error */
+
+	/*!
+	 *  \brief Argument of a thread of a stage
+	 */
+	struct Worker {
+		StreamPipeline* pipeline;
+		int stage;
+	};
+
+	StreamPipeline(const StreamingExtractor_<T>* extractor,const vector<string>* paths,VideoCapture* capture)
+		: extractor(extractor), paths(paths), capture(capture) {
+		for(int s=0;s<=NB_STREAM_STAGES;s++)
+			queues[s]=new BoundedQueue<StreamItem<T> >(extractor->config.queueCapacity);
+		for(int s=0;s<NB_STREAM_STAGES;s++)
+			running[s]=0;
+	}
+	~StreamPipeline(){
+		for(int s=0;s<=NB_STREAM_STAGES;s++)
+			delete queues[s];
+	}
+	/*!
+	 *  \brief Close all the queues, the threads stop as soon as they have emptied their input
+	 */
+	void abort(){
+		for(int s=0;s<=NB_STREAM_STAGES;s++)
+			queues[s]->close();
+	}
+	/*!
+	 *  \brief Stop the pipeline after an error which is not the one of an image (e.g. std::bad_alloc)
+	 *
+	 *  The error is kept to be thrown by run() once all the threads have stopped: an exception
+	 *  must not leave the start routine of a thread.
+	 */
+	void fail(const string& what){
+		{
+			AutoLock lock(runningMutex);
+			if(error.empty())
+				error=what.empty() ? "unknown error" : what;
+		}
+		abort();
+	}
+	/*!
+	 *  \brief Give the images (or the decoded frames) to the pipeline
+	 */
+	void produce(){
+		if(paths){
+			for(int i=0;i<(int)paths->size();i++){
+				StreamItem<T> item;
+				item.index=i;
+				item.name=(*paths)[i];
+				if(!queues[DECODE_STAGE]->push(item))
+					break;
+			}
+			queues[DECODE_STAGE]->close();
+		}
+		else{
+			// A video is read in order: the frames are decoded here and skip the decode stage
+			for(int i=0;;i++){
+				StreamItem<T> item;
+				item.index=i;
+				if(!capture->read(item.image) || item.image.empty())
+					break;
+				// The capture may reuse the buffer of the frame
+				item.image=item.image.clone();
+				if(!queues[PREPROCESS_STAGE]->push(item))
+					break;
+			}
+			queues[PREPROCESS_STAGE]->close();
+		}
+	}
+	/*!
+	 *  \brief Process the images of a stage until its input is closed and empty
+	 */
+	void work(const int& stage){
+		const StreamingExtractor_<T>& e=*extractor;
+		CFTPlan_<T> plan;
+		Ptr<const CircleTable> table;
+		StreamItem<T> item;
+		try{
+			while(queues[stage]->pop(item)){
+				if(!item.failed){
+					try{
+						process(stage,e,plan,table,item);
+					}
+					catch(const cv::Exception&){
+						item.failed=true;
+					}
+					if(item.failed){
+						item.image.release();
+						item.par.release();
+						item.orth.release();
+					}
+				}
+				queues[stage+1]->push(item);
+				item=StreamItem<T>();
+			}
+		}
+		catch(const std::exception& ex){
+			fail(ex.what());
+		}
+		catch(...){
+			fail("");
+		}
+		AutoLock lock(runningMutex);
+		if(--running[stage]==0)
+			queues[stage+1]->close();
+	}
+	/*!
+	 *  \brief Process one image in a stage
+	 */
+	static void process(const int& stage,const StreamingExtractor_<T>& e,CFTPlan_<T>& plan,Ptr<const CircleTable>& table,StreamItem<T>& item){
+		switch(stage){
+		case DECODE_STAGE:{
+			GCFD_PROFILE_SCOPE("Stream/decode");
+			item.image=imread(item.name,1);
+			item.failed=item.image.empty();
+			break;
+		}
+		case PREPROCESS_STAGE:{
+			GCFD_PROFILE_SCOPE("Stream/preprocess");
+			if(e.config.size.width>0 && e.config.size.height>0 && item.image.size()!=e.config.size){
+				Mat resized;
+				resize(item.image,resized,e.config.size,0,0,INTER_AREA);
+				item.image=resized;
+			}
+			item.image=CFTPlan_<T>::cropToOddSize(item.image);
+			item.size=item.image.size();
+			item.failed=std::min(item.size.width,item.size.height)<3;
+			Ptr<DescriptorCache> cache=e.config.cache;
+			if(item.failed || cache.empty())
+				break;
+			item.key=DescriptorCache::makeKey(item.image,e.type,e.Biv,DataType<T>::depth,e.config.preprocessing);
+			int D=DescriptorBatch_<T>::getDescriptorSize(e.type,item.size);
+			AutoBuffer<double> buffer(D);
+			double* res=buffer;
+			if(cache->lookup(item.key,res,D)){
+				item.image.release();
+				item.descriptor.create(1,D,DataType<T>::depth);
+				T* row=item.descriptor.template ptr<T>(0);
+				for(int k=0;k<D;k++)
+					row[k]=(T)res[k];
+				item.cached=true;
+			}
+			break;
+		}
+		case CFT_STAGE:{
+			if(item.cached)
+				break;
+			GCFD_PROFILE_SCOPE("Stream/cft");
+			if(plan.getSize()!=item.size){
+				GCFD_PROFILE_SCOPE("Descriptors/buildPlan");
+				plan=CFTPlan_<T>(item.size.height,item.size.width,e.Biv,FFT_BACKEND_AUTO,e.config.preprocessing);
+			}
+			DescriptorBatch_<T>::transform(e.type,plan,item.image,item.par,item.orth);
+			item.image.release();
+			break;
+		}
+		case DESCRIPTOR_STAGE:{
+			if(item.cached)
+				break;
+			GCFD_PROFILE_SCOPE("Stream/descriptor");
+			int maxR=std::min(item.size.width,item.size.height)/2;
+			if(table.empty() || table->getSize()!=Size(2*maxR+1,2*maxR+1))
+				table=CircleTableCache::get(maxR);
+			int D=DescriptorBatch_<T>::getDescriptorSize(e.type,item.size);
+			AutoBuffer<double> buffer(D);
+			double* res=buffer;
+			DescriptorBatch_<T>::integrate(e.type,*table,item.par,item.orth,res);
+			item.par.release();
+			item.orth.release();
+			item.descriptor.create(1,D,DataType<T>::depth);
+			T* row=item.descriptor.template ptr<T>(0);
+			for(int k=0;k<D;k++)
+				row[k]=(T)res[k];
+			Ptr<DescriptorCache> cache=e.config.cache;
+			if(!cache.empty())
+				cache->insert(item.key,res,D);
+			break;
+		}
+		}
+	}
+	static void* runProducer(void* arg){
+		StreamPipeline* pipeline=(StreamPipeline*)arg;
+		try{
+			pipeline->produce();
+		}
+		catch(const std::exception& ex){
+			pipeline->fail(ex.what());
+		}
+		catch(...){
+			pipeline->fail("");
+		}
+		return 0;
+	}
+	static void* runWorker(void* arg){
+		Worker* w=(Worker*)arg;
+		w->pipeline->work(w->stage);
+		return 0;
+	}
+};
+
+template<typename T> StreamingExtractor_<T>::StreamingExtractor_(const DescriptorType& type,const Mat& Biv,const StreamingConfig& config)
+		: type(type), config(config), nbFailed(0) {
+	CV_Assert(config.decodeThreads>0 && config.preprocessThreads>0 && config.cftThreads>0 && config.descriptorThreads>0);
+	CV_Assert(config.queueCapacity>0);
+	Biv.convertTo(this->Biv,CV_64F);
+}
+
+template<typename T> int StreamingExtractor_<T>::run(const vector<string>* paths,VideoCapture* capture,DescriptorSink& sink){
+	StreamPipeline<T> pipeline(this,paths,capture);
+	const int nbThreads[NB_STREAM_STAGES]={paths ? config.decodeThreads : 0,config.preprocessThreads,config.cftThreads,config.descriptorThreads};
+	vector<typename StreamPipeline<T>::Worker> workers;
+	for(int s=0;s<NB_STREAM_STAGES;s++){
+		pipeline.running[s]=nbThreads[s];
+		for(int t=0;t<nbThreads[s];t++){
+			typename StreamPipeline<T>::Worker w;
+			w.pipeline=&pipeline;
+			w.stage=s;
+			workers.push_back(w);
+		}
+	}
+
+	// The threads are created before consuming the output: workers must not be resized after this point
+	vector<pthread_t> threads(workers.size()+1);
+	int nbStarted=0;
+	bool ok=pthread_create(&threads[0],0,StreamPipeline<T>::runProducer,&pipeline)==0;
+	if(ok)
+		nbStarted++;
+	for(size_t i=0;i<workers.size() && ok;i++){
+		ok=pthread_create(&threads[i+1],0,StreamPipeline<T>::runWorker,&workers[i])==0;
+		if(ok)
+			nbStarted++;
+	}
+	if(!ok){
+		pipeline.abort();
+		for(int i=0;i<nbStarted;i++)
+			pthread_join(threads[i],0);
+		CV_Error(CV_StsError,"StreamingExtractor: cannot create the threads of the pipeline");
+	}
+
+	// The calling thread gives the results to the sink
+	int nbWritten=0;
+	nbFailed=0;
+	try{
+		StreamItem<T> item;
+		while(pipeline.queues[NB_STREAM_STAGES]->pop(item)){
+			if(item.failed){
+				nbFailed++;
+				sink.fail(item.index,item.name);
+			}
+			else{
+				sink.write(item.index,item.name,item.descriptor);
+				nbWritten++;
+			}
+		}
+	}
+	catch(...){
+		pipeline.abort();
+		for(int i=0;i<nbStarted;i++)
+			pthread_join(threads[i],0);
+		throw;
+	}
+	for(int i=0;i<nbStarted;i++)
+		pthread_join(threads[i],0);
+	if(!pipeline.error.empty())
+		CV_Error(CV_StsError,"StreamingExtractor: the pipeline has been stopped by "+pipeline.error);
+	return nbWritten;
+}
+
+template<typename T> int StreamingExtractor_<T>::processDirectory(const string& dir,DescriptorSink& sink){
+	vector<string> paths=listImages(dir,config.recursive,config.extensions);
+	return processFiles(paths,sink);
+}
+
+template<typename T> int StreamingExtractor_<T>::processFiles(const vector<string>& paths,DescriptorSink& sink){
+	return run(&paths,0,sink);
+}
+
+template<typename T> int StreamingExtractor_<T>::processVideo(const string& source,DescriptorSink& sink){
+	VideoCapture capture(source);
+	if(!capture.isOpened())
+		CV_Error(CV_StsError,"StreamingExtractor: cannot open "+source);
+	return processVideo(capture,sink);
+}
+
+template<typename T> int StreamingExtractor_<T>::processVideo(const int& device,DescriptorSink& sink){
+	VideoCapture capture(device);
+	if(!capture.isOpened())
+		CV_Error(CV_StsError,"StreamingExtractor: cannot open the camera "+MyTools::Int2Str(device));
+	return processVideo(capture,sink);
+}
+
+template<typename T> int StreamingExtractor_<T>::processVideo(VideoCapture& capture,DescriptorSink& sink){
+	return run(0,&capture,sink);
+}
+
+template<typename T> int StreamingExtractor_<T>::getNbFailed() const{
+	return nbFailed;
+}
+
+template<typename T> vector<string> StreamingExtractor_<T>::listImages(const string& dir,const bool& recursive,const vector<string>& extensions){
+	vector<string> res;
+	vector<string> dirs(1,dir);
+	while(!dirs.empty()){
+		string current=dirs.back();
+		dirs.pop_back();
+		DIR* d=opendir(current.c_str());
+		if(!d)
+			continue;
+		string prefix=current;
+		if(!prefix.empty() && prefix[prefix.size()-1]!='/')
+			prefix+='/';
+		struct dirent* entry;
+		while((entry=readdir(d))!=0){
+			string name=entry->d_name;
+			if(name.empty() || name[0]=='.')
+				continue;
+			string path=prefix+name;
+			struct stat st;
+			if(stat(path.c_str(),&st)!=0)
+				continue;
+			if(S_ISDIR(st.st_mode)){
+				if(recursive)
+					dirs.push_back(path);
+				continue;
+			}
+			size_t dot=name.rfind('.');
+			if(dot==string::npos)
+				continue;
+			string ext=name.substr(dot+1);
+			for(size_t k=0;k<ext.size();k++)
+				ext[k]=(char)std::tolower((unsigned char)ext[k]);
+			if(std::find(extensions.begin(),extensions.end(),ext)!=extensions.end())
+				res.push_back(path);
+		}
+		closedir(d);
+	}
+	std::sort(res.begin(),res.end());
+	return res;
+}
+
+template<typename T> StreamingExtractor_<T>::~StreamingExtractor_() {
+}
+
+template class StreamingExtractor_<float>;
+template class StreamingExtractor_<double>;
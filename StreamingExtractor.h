@@ -0,0 +1,214 @@
+/**
+ * \file StreamingExtractor.h
+ * \brief Pipelined computation of the descriptors of a directory or of a video
+ * \version 1.0
+ * \date October 17, 2026
+ *
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the distribution
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef STREAMINGEXTRACTOR_H_
+#define STREAMINGEXTRACTOR_H_
+
+#include <iostream>
+#include <opencv/cv.h>
+#include <opencv/highgui.h>
+#include <vector>
+#include <string>
+#include "DescriptorBatch.h"
+
+using namespace cv;
+
+/*! \struct StreamingConfig
+   * \brief Parameters of a StreamingExtractor
+   */
+struct StreamingConfig {
+	int decodeThreads;			/*!< Number of threads reading the image files */
+	int preprocessThreads;		/*!< Number of threads resizing and cropping the images */
+	int cftThreads;				/*!< Number of threads computing the CFT */
+	int descriptorThreads;		/*!< Number of threads integrating the spectra on the discrete circles */
+	int queueCapacity;			/*!< Maximum number of images waiting between two stages */
+	Size size;					/*!< If not empty, the images are resized to this size */
+	bool recursive;				/*!< If true, the sub-directories are walked too */
+	vector<string> extensions;	/*!< The extensions (lower case, without the dot) of the files read in a directory */
+	Ptr<DescriptorCache> cache;	/*!< If not null, the descriptors are looked up by the preprocess stage, the images found skip the CFT */
+	ColorPreprocessing preprocessing;	/*!< The order of the channels and the scaling of the images (part of the keys of the cache) */
+	/*!
+	 *  \brief Constructor of StreamingConfig
+	 *
+	 *  Two decode threads, one CFT thread per CPU, one thread for the other stages, queues of
+	 *  16 images, no resize, recursive walk, the extensions read by cv::imread, no cache and the
+	 *  preprocessing of the legacy descriptors.
+	 */
+	StreamingConfig();
+};
+
+/*! \class DescriptorSink
+   * \brief Receive the descriptors computed by a StreamingExtractor
+   *
+   *  The methods are called by the thread which called StreamingExtractor_::processDirectory
+   *  (or processFiles, processVideo), so a sink does not need to be thread safe. The images
+   *  are given in the order they leave the pipeline, which is not always the order of the input.
+   */
+class DescriptorSink {
+public:
+	/*!
+	 *  \brief Receive a descriptor
+	 *
+	 *  \param index : The index of the image in the input (file or frame number)
+	 *  \param name : The path of the image (empty for a frame)
+	 *  \param descriptor : A row of float or double, only valid during the call
+	 */
+	virtual void write(const int& index,const string& name,const Mat& descriptor)=0;
+	/*!
+	 *  \brief Called for an image which cannot be read or computed
+	 *
+	 *  \param index : The index of the image in the input
+	 *  \param name : The path of the image (empty for a frame)
+	 */
+	virtual void fail(const int& index,const string& name);
+
+	virtual ~DescriptorSink();
+};
+
+template<typename T> struct StreamPipeline;
+
+/*! \class StreamingExtractor_
+   * \brief Compute the descriptors of a directory tree or of a video with overlapped stages
+   *
+   *  The images go through four stages: decode (cv::imread), preprocess (resize and crop to an
+   *  odd size), CFT (one CFTPlan_ per thread) and descriptor (CircleTableCache). Each
+   *  stage has its own threads and the stages are linked by bounded queues: when a stage is too
+   *  slow the queue before it fills up and the previous stages wait, so at most about
+   *  4*queueCapacity plus one image per thread are in memory whatever the size of the input.
+   *  The BGR to RGB reordering of MyTools::reorderColorChannel is done by the projection of
+   *  the plans. The results are the same as the ones of DescriptorBatch_. With a cache (see
+   *  StreamingConfig), the descriptor of an image already computed is taken by the preprocess
+   *  stage and the image goes through the other stages untouched.
+   *
+   *  T is the precision of the spectra and of the descriptors (float or double).
+   */
+template<typename T> class StreamingExtractor_ {
+private:
+	DescriptorType type;			/*!< The descriptor computed for each image */
+	Mat Biv;						/*!< A color vector used to build the bivector B=Biv^e4 */
+	StreamingConfig config;			/*!< The parameters of the pipeline */
+	int nbFailed;					/*!< Number of images which have not been computed by the last call */
+
+	friend struct StreamPipeline<T>;
+	/*!
+	 *  \brief Run the pipeline on files or on the frames of a video
+	 *
+	 *  An image which cannot be read or computed is given to DescriptorSink::fail. Any other
+	 *  error of a thread (e.g. std::bad_alloc) stops the pipeline and is thrown as a
+	 *  cv::Exception once all the threads have stopped.
+	 *
+	 *  \param paths : The paths of the images (or null)
+	 *  \param capture : The video (or null)
+	 *  \param sink : Receive the descriptors
+	 *  \return Return the number of descriptors given to the sink
+	 */
+	int run(const vector<string>* paths,VideoCapture* capture,DescriptorSink& sink);
+
+	StreamingExtractor_(const StreamingExtractor_&);
+	StreamingExtractor_& operator=(const StreamingExtractor_&);
+
+public:
+	/*!
+	 *  \brief Constructor of StreamingExtractor_ class
+	 *
+	 *  \param type : The descriptor to compute
+	 *  \param Biv : A color vector used to build the bivector B=Biv^e4
+	 *  \param config : The parameters of the pipeline
+	 *
+	 */
+	StreamingExtractor_(const DescriptorType& type,const Mat& Biv,const StreamingConfig& config=StreamingConfig());
+	/*!
+	 *  \brief Compute the descriptors of the images of a directory
+	 *
+	 *  \param dir : A directory, walked recursively if config.recursive is true
+	 *  \param sink : Receive the descriptors
+	 *  \return Return the number of descriptors given to the sink
+	 */
+	int processDirectory(const string& dir,DescriptorSink& sink);
+	/*!
+	 *  \brief Compute the descriptors of a list of image files
+	 *
+	 *  \param paths : The paths of color images, index is the position in this vector
+	 *  \param sink : Receive the descriptors
+	 *  \return Return the number of descriptors given to the sink
+	 */
+	int processFiles(const vector<string>& paths,DescriptorSink& sink);
+	/*!
+	 *  \brief Compute the descriptors of the frames of a video file or of a sequence of images
+	 *
+	 *  The frames are decoded by the calling thread (a video can only be read in order), the
+	 *  decode threads are not used.
+	 *
+	 *  \param source : A name accepted by cv::VideoCapture, i.e. a video file or a pattern such as img_%04d.png
+	 *  \param sink : Receive the descriptors
+	 *  \return Return the number of descriptors given to the sink
+	 */
+	int processVideo(const string& source,DescriptorSink& sink);
+	/*!
+	 *  \brief Compute the descriptors of the frames of a camera until it stops
+	 *
+	 *  \param device : The index of the camera
+	 *  \param sink : Receive the descriptors
+	 *  \return Return the number of descriptors given to the sink
+	 */
+	int processVideo(const int& device,DescriptorSink& sink);
+	/*!
+	 *  \brief Compute the descriptors of the frames of an opened capture until it stops
+	 *
+	 *  \param capture : An opened video or camera
+	 *  \param sink : Receive the descriptors
+	 *  \return Return the number of descriptors given to the sink
+	 */
+	int processVideo(VideoCapture& capture,DescriptorSink& sink);
+	/*!
+	 *  \brief Get the number of images which have not been computed
+	 *
+	 *  \return Return the number of calls to DescriptorSink::fail during the last processing
+	 */
+	int getNbFailed() const;
+	/*!
+	 *  \brief List the images of a directory
+	 *
+	 *  The hidden files and directories are skipped.
+	 *
+	 *  \param dir : A directory
+	 *  \param recursive : If true, the sub-directories are walked too
+	 *  \param extensions : The extensions of the files to keep (lower case, without the dot)
+	 *  \return Return the sorted paths of the images
+	 */
+	static vector<string> listImages(const string& dir,const bool& recursive,const vector<string>& extensions);
+
+	virtual ~StreamingExtractor_();
+};
+
+typedef StreamingExtractor_<double> StreamingExtractor;
+typedef StreamingExtractor_<float> StreamingExtractorf;
+
+#endif /* STREAMINGEXTRACTOR_H_ */
@@ -0,0 +1,153 @@
+/**
+ * \file BenchCheck.h
+ * \brief Tolerance checks of the benchmark programs
+ * \version 1.0
+ * \date October 17, 2026
+ *
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the distribution
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef BENCHCHECK_H_
+#define BENCHCHECK_H_
+
+#include <iostream>
+#include <string>
+#include <cmath>
+#include <opencv/cv.h>
+
+/*! \class BenchCheck
+   * \brief Compare the differences printed by a benchmark to their tolerances
+   *
+   *  The benchmark programs compare the results of the new code with the ones of the legacy
+   *  code (or of a reference path) and return getExitCode() from main, so that a program run
+   *  by CTest fails as soon as a difference is above its tolerance:
+   *  \code
+   *  BenchCheck check;
+   *  check.expect("GCFD3 fixed vs generic",diff,1e-12);
+   *  return check.getExitCode();
+   *  \endcode
+   */
+class BenchCheck {
+private:
+	int nbChecks;		/*!< Number of differences checked */
+	int nbFailed;		/*!< Number of differences above their tolerance */
+
+public:
+	BenchCheck() : nbChecks(0), nbFailed(0) {
+	}
+	/*!
+	 *  \brief Check a difference, a message is printed on std::cerr if it is above the tolerance
+	 *
+	 *  \param what : The compared results
+	 *  \param diff : The largest difference (a NaN fails)
+	 *  \param tolerance : The largest accepted difference
+	 *  \return Return true if diff<=tolerance
+	 */
+	bool expect(const std::string& what,const double& diff,const double& tolerance){
+		nbChecks++;
+		if(diff<=tolerance)
+			return true;
+		nbFailed++;
+		std::cerr<<"FAILED: "<<what<<": difference "<<diff<<" above the tolerance "<<tolerance<<std::endl;
+		return false;
+	}
+	/*!
+	 *  \brief Check a condition
+	 *
+	 *  \param what : The checked property
+	 *  \param ok : The result of the check
+	 *  \return Return ok
+	 */
+	bool expect(const std::string& what,const bool& ok){
+		nbChecks++;
+		if(ok)
+			return true;
+		nbFailed++;
+		std::cerr<<"FAILED: "<<what<<std::endl;
+		return false;
+	}
+	/*!
+	 *  \brief Get the largest difference of values relative to the expected values
+	 *
+	 *  Used for energies and descriptors: their values are positive but differ by orders of
+	 *  magnitude (the energy at the null frequency and the ratios on the circles), so a
+	 *  difference relative to the largest value would hide the errors of the small ones.
+	 *
+	 *  \param res : The values to check
+	 *  \param ref : The expected values, as many as res (the shapes can differ)
+	 *  \return Return the largest |res-ref|/|ref|, HUGE_VAL if the numbers of values differ or if
+	 *  a value is a NaN in only one of them
+	 */
+	static double relativeDiff(const cv::Mat& res,const cv::Mat& ref){
+		if(res.total()*res.channels()!=ref.total()*ref.channels())
+			return HUGE_VAL;
+		cv::Mat a,b;
+		res.convertTo(a,CV_64F);
+		ref.convertTo(b,CV_64F);
+		a=a.reshape(1,1);
+		b=b.reshape(1,1);
+		double diff=0;
+		for(int k=0;k<b.cols;k++){
+			if(cvIsNaN(a.at<double>(0,k))!=cvIsNaN(b.at<double>(0,k)))
+				return HUGE_VAL;
+			double d=std::fabs(a.at<double>(0,k)-b.at<double>(0,k));
+			if(d>0)
+				diff=std::max(diff,d/std::fabs(b.at<double>(0,k)));
+		}
+		return diff;
+	}
+	/*!
+	 *  \brief Check if a value is a NaN in only one of two results
+	 *
+	 *  cv::norm and std::max skip the NaN, so the differences computed with them must be
+	 *  replaced by HUGE_VAL when this is true.
+	 *
+	 *  \param res : The values to check
+	 *  \param ref : The expected values, as many as res
+	 *  \return Return true if a value of res or ref is a NaN and the same value of the other is not
+	 */
+	static bool hasNaNMismatch(const cv::Mat& res,const cv::Mat& ref){
+		cv::Mat a,b;
+		res.convertTo(a,CV_64F);
+		ref.convertTo(b,CV_64F);
+		a=a.reshape(1,1);
+		b=b.reshape(1,1);
+		for(int k=0;k<b.cols;k++)
+			if(cvIsNaN(a.at<double>(0,k))!=cvIsNaN(b.at<double>(0,k)))
+				return true;
+		return false;
+	}
+	/*!
+	 *  \brief Get the exit code of the program
+	 *
+	 *  \return Return 0 if all the checks have passed, 1 otherwise
+	 */
+	int getExitCode() const{
+		if(nbFailed>0)
+			std::cerr<<nbFailed<<" of "<<nbChecks<<" check(s) failed"<<std::endl;
+		return nbFailed>0 ? 1 : 0;
+	}
+};
+
+#endif /* BENCHCHECK_H_ */
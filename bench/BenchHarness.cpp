@@ -0,0 +1,424 @@
+/**
+ * \file BenchHarness.cpp
+ * \brief Minimal benchmark harness with JSON results and checks of the outputs against a baseline
+ * \version 1.0
+ * \date October 17, 2026
+ *
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the distribution
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "BenchHarness.h"
+#include "BenchCheck.h"
+#include "../Profiler.h"
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <ctime>
+#include <map>
+
+BenchChecksum::BenchChecksum() : count(0), sum(0), l1(0), l2(0) {
+}
+
+BenchChecksum::BenchChecksum(const vector<Mat>& M) : count(0), sum(0), l1(0), l2(0) {
+	double sq=0;
+	for(size_t k=0;k<M.size();k++){
+		if(M[k].empty())
+			continue;
+		Mat X;
+		M[k].convertTo(X,CV_64F);
+		X=X.reshape(1,1);
+		count+=(double)X.total();
+		for(int i=0;i<X.rows;i++){
+			const double* x=X.ptr<double>(i);
+			for(int j=0;j<X.cols;j++){
+				sum+=x[j];
+				l1+=std::fabs(x[j]);
+				sq+=x[j]*x[j];
+			}
+		}
+	}
+	l2=std::sqrt(sq);
+}
+
+bool BenchChecksum::matches(const BenchChecksum& ref,const double& tolerance) const{
+	if(count!=ref.count)
+		return false;
+	// The sum can be close to 0, so its error is relative to the l1 norm
+	return std::fabs(sum-ref.sum)<=tolerance*ref.l1
+		&& std::fabs(l1-ref.l1)<=tolerance*ref.l1
+		&& std::fabs(l2-ref.l2)<=tolerance*ref.l2;
+}
+
+BenchState::BenchState(const Size& size,const SyntheticKind& kind,const int64& iterations)
+	: size(size), kind(kind), iterations(iterations), done(0), startTick(0), startCpu(0), realTime(0), cpuTime(0) {
+}
+
+bool BenchState::keepRunning(){
+	if(done==0){
+		startCpu=(double)std::clock();
+		startTick=getTickCount();
+	}
+	if(done<iterations){
+		done++;
+		return true;
+	}
+	realTime=(getTickCount()-startTick)/getTickFrequency();
+	cpuTime=((double)std::clock()-startCpu)/CLOCKS_PER_SEC;
+	return false;
+}
+
+void BenchState::setResult(const Mat& res){
+	result.assign(1,res);
+}
+
+void BenchState::setResult(const vector<double>& res){
+	result.assign(1,Mat(res,true));
+}
+
+void BenchState::setResult(const vector<Mat>& res){
+	result=res;
+}
+
+void BenchState::skip(const string& reason){
+	skipReason=reason;
+}
+
+Size BenchState::getSize() const{
+	return size;
+}
+
+SyntheticKind BenchState::getKind() const{
+	return kind;
+}
+
+BenchHarness::BenchHarness(const vector<Size>& sizes) : sizes(sizes) {
+}
+
+void BenchHarness::add(const string& name,BenchFunction function){
+	Entry e;
+	e.name=name;
+	e.function=function;
+	entries.push_back(e);
+}
+
+void BenchHarness::addEquivalence(const string& name,const string& reference,const double& tolerance,const bool& elementwise){
+	CV_Assert(find(name)!=0 && find(reference)!=0 && tolerance>=0);
+	Equivalence e;
+	e.name=name;
+	e.reference=reference;
+	e.tolerance=tolerance;
+	e.elementwise=elementwise;
+	equivalences.push_back(e);
+}
+
+const BenchHarness::Entry* BenchHarness::find(const string& name) const{
+	for(size_t e=0;e<entries.size();e++)
+		if(entries[e].name==name)
+			return &entries[e];
+	return 0;
+}
+
+string BenchHarness::runOne(const Entry& entry,const Size& size,const SyntheticKind& kind,const double& minTime,Result& res){
+	// Warm up: caches, lazy allocations and the output used for the checksum
+	BenchState first(size,kind,1);
+	entry.function(first);
+	if(!first.skipReason.empty())
+		return first.skipReason;
+	res.checksum=BenchChecksum(first.result);
+
+	int64 n=1;
+	double t=first.realTime;
+	for(;;){
+		if(t<minTime){
+			// Aim at 1.4 times the minimal time, growing by 2 to 10 times at each step
+			double ratio=t>0 ? 1.4*minTime/t : 10;
+			n=(int64)(n*std::min(10.,std::max(2.,ratio)));
+		}
+		BenchState state(size,kind,n);
+		entry.function(state);
+		t=state.realTime;
+		if(t>=minTime || n>=(int64)1000000000){
+			res.iterations=n;
+			res.realTime=1e9*state.realTime/n;
+			res.cpuTime=1e9*state.cpuTime/n;
+			return string();
+		}
+	}
+}
+
+string BenchHarness::compareOne(const Entry& entry,const Entry& reference,const Size& size,const SyntheticKind& kind,const bool& elementwise,double& diff){
+	BenchState res(size,kind,1),ref(size,kind,1);
+	entry.function(res);
+	if(!res.skipReason.empty())
+		return res.skipReason;
+	reference.function(ref);
+	if(!ref.skipReason.empty())
+		return ref.skipReason;
+	diff=HUGE_VAL;
+	if(res.result.size()!=ref.result.size())
+		return string();
+	double maxDiff=0,scale=0;
+	for(size_t k=0;k<ref.result.size();k++){
+		const Mat& a=res.result[k];
+		const Mat& b=ref.result[k];
+		if(a.size()!=b.size() || a.type()!=b.type())
+			return string();
+		if(b.empty())
+			continue;
+		if(elementwise){
+			maxDiff=std::max(maxDiff,BenchCheck::relativeDiff(a,b));
+			continue;
+		}
+		// diff stays HUGE_VAL: cv::norm would give a NaN, which std::max skips
+		if(BenchCheck::hasNaNMismatch(a,b))
+			return string();
+		maxDiff=std::max(maxDiff,norm(a,b,NORM_INF));
+		scale=std::max(scale,norm(b,NORM_INF));
+	}
+	diff=scale>0 ? maxDiff/scale : maxDiff;
+	return string();
+}
+
+void BenchHarness::writeJSON(const string& path,const vector<Result>& results,const string& kind,const double& minTime){
+	std::ofstream out(path.c_str());
+	if(!out)
+		CV_Error(CV_StsError,"BenchHarness: cannot write "+path);
+	char date[64];
+	time_t now=time(0);
+	strftime(date,sizeof(date),"%Y-%m-%dT%H:%M:%S",localtime(&now));
+	out<<"{"<<std::endl;
+	out<<"  \"context\": {"<<std::endl;
+	out<<"    \"date\": \""<<date<<"\","<<std::endl;
+	out<<"    \"num_cpus\": "<<getNumberOfCPUs()<<","<<std::endl;
+	out<<"    \"num_threads\": "<<getNumThreads()<<","<<std::endl;
+	out<<"    \"opencv_version\": \""<<CV_VERSION<<"\","<<std::endl;
+	out<<"    \"image\": \""<<kind<<"\","<<std::endl;
+	out<<"    \"min_time\": "<<minTime<<std::endl;
+	out<<"  },"<<std::endl;
+	out<<"  \"benchmarks\": ["<<std::endl;
+	out<<std::setprecision(17);
+	for(size_t i=0;i<results.size();i++){
+		const Result& r=results[i];
+		// One benchmark per line: readJSON relies on it
+		out<<"    {\"name\": \""<<r.name<<"\", \"iterations\": "<<r.iterations
+				<<", \"real_time\": "<<r.realTime<<", \"cpu_time\": "<<r.cpuTime<<", \"time_unit\": \"ns\""
+				<<", \"checksum_count\": "<<r.checksum.count<<", \"checksum_sum\": "<<r.checksum.sum
+				<<", \"checksum_l1\": "<<r.checksum.l1<<", \"checksum_l2\": "<<r.checksum.l2<<"}"
+				<<(i+1<results.size() ? "," : "")<<std::endl;
+	}
+	out<<"  ]"<<std::endl;
+	out<<"}"<<std::endl;
+}
+
+/*!
+ *  \brief Read the number following "key": in a line of a JSON file
+ */
+static bool readNumber(const string& line,const string& key,double& value){
+	size_t p=line.find("\""+key+"\":");
+	if(p==string::npos)
+		return false;
+	value=strtod(line.c_str()+p+key.size()+3,0);
+	return true;
+}
+
+vector<BenchHarness::Result> BenchHarness::readJSON(const string& path){
+	std::ifstream in(path.c_str());
+	if(!in)
+		CV_Error(CV_StsError,"BenchHarness: cannot read "+path);
+	vector<Result> results;
+	string line;
+	while(std::getline(in,line)){
+		size_t p=line.find("{\"name\": \"");
+		if(p==string::npos)
+			continue;
+		p+=10;
+		size_t q=line.find('"',p);
+		Result r;
+		r.name=line.substr(p,q-p);
+		double iterations=0;
+		bool ok=readNumber(line,"iterations",iterations)
+				&& readNumber(line,"real_time",r.realTime)
+				&& readNumber(line,"cpu_time",r.cpuTime)
+				&& readNumber(line,"checksum_count",r.checksum.count)
+				&& readNumber(line,"checksum_sum",r.checksum.sum)
+				&& readNumber(line,"checksum_l1",r.checksum.l1)
+				&& readNumber(line,"checksum_l2",r.checksum.l2);
+		if(!ok)
+			CV_Error(CV_StsError,"BenchHarness: wrong line in "+path+": "+line);
+		r.iterations=(int64)iterations;
+		results.push_back(r);
+	}
+	return results;
+}
+
+vector<Size> BenchHarness::parseSizes(const string& text){
+	vector<Size> res;
+	std::istringstream in(text);
+	string item;
+	while(std::getline(in,item,',')){
+		int w=0,h=0;
+		if(sscanf(item.c_str(),"%dx%d",&w,&h)!=2 || w<=0 || h<=0)
+			CV_Error(CV_StsBadArg,"BenchHarness: wrong size "+item+" (expected WxH)");
+		res.push_back(Size(w,h));
+	}
+	return res;
+}
+
+int BenchHarness::run(int argc,char** argv){
+	string filter,jsonPath,baselinePath,profilePath,tracePath,kindName="smooth";
+	double minTime=0.5,tolerance=1e-6;
+	vector<Size> runSizes=sizes;
+	bool list=false;
+	for(int i=1;i<argc;i++){
+		string arg=argv[i];
+		size_t eq=arg.find('=');
+		string key=arg.substr(0,eq);
+		string value=eq==string::npos ? string() : arg.substr(eq+1);
+		if(key=="--filter")
+			filter=value;
+		else if(key=="--sizes")
+			runSizes=parseSizes(value);
+		else if(key=="--image")
+			kindName=value;
+		else if(key=="--min-time")
+			minTime=atof(value.c_str());
+		else if(key=="--json")
+			jsonPath=value;
+		else if(key=="--baseline")
+			baselinePath=value;
+		else if(key=="--tolerance")
+			tolerance=atof(value.c_str());
+		else if(key=="--list")
+			list=true;
+		else if(key=="--profile")
+			profilePath=value;
+		else if(key=="--trace")
+			tracePath=value;
+		else{
+			std::cerr<<"Unknown option "<<arg<<std::endl;
+			std::cerr<<"Options: --filter=text --sizes=WxH,... --image=noise|smooth|shapes --min-time=s --json=file --baseline=file --tolerance=t --list --profile=file --trace=file"<<std::endl;
+			return 1;
+		}
+	}
+	const SyntheticKind kind=SyntheticImages::parseKind(kindName);
+
+	if(list){
+		for(size_t e=0;e<entries.size();e++)
+			std::cout<<entries[e].name<<std::endl;
+		return 0;
+	}
+
+	if((!profilePath.empty() || !tracePath.empty()) && !Profiler::isEnabled())
+		std::cerr<<"The library has been compiled without GCFD_PROFILING: the profile will be empty"<<std::endl;
+	Profiler::setTracing(!tracePath.empty());
+
+	std::map<string,Result> baseline;
+	if(!baselinePath.empty()){
+		vector<Result> b=readJSON(baselinePath);
+		for(size_t i=0;i<b.size();i++)
+			baseline[b[i].name]=b[i];
+	}
+
+	int nbMismatches=0;
+	vector<Result> results;
+	std::cout<<std::left<<std::setw(44)<<"benchmark"<<std::right<<std::setw(14)<<"time (us)"<<std::setw(14)<<"iterations"
+			<<std::setw(12)<<"speedup"<<"  checksum"<<std::endl;
+	for(size_t e=0;e<entries.size();e++){
+		if(!filter.empty() && entries[e].name.find(filter)==string::npos)
+			continue;
+		for(size_t s=0;s<runSizes.size();s++){
+			std::ostringstream name;
+			name<<entries[e].name<<"/"<<runSizes[s].width<<"x"<<runSizes[s].height;
+			Result r;
+			r.name=name.str();
+			std::cout<<std::left<<std::setw(44)<<r.name<<std::right<<std::flush;
+			string skipped=runOne(entries[e],runSizes[s],kind,minTime,r);
+			if(!skipped.empty()){
+				std::cout<<"  skipped: "<<skipped<<std::endl;
+				continue;
+			}
+			results.push_back(r);
+			std::cout<<std::setw(14)<<std::setprecision(4)<<r.realTime/1000<<std::setw(14)<<r.iterations;
+			std::map<string,Result>::const_iterator b=baseline.find(r.name);
+			if(b==baseline.end())
+				std::cout<<std::setw(12)<<"-"<<"  "<<(baseline.empty() ? "" : "new")<<std::endl;
+			else{
+				bool ok=r.checksum.matches(b->second.checksum,tolerance);
+				nbMismatches+=!ok;
+				std::cout<<std::setw(11)<<std::setprecision(3)<<b->second.realTime/r.realTime<<"x  "<<(ok ? "ok" : "MISMATCH")<<std::endl;
+			}
+		}
+	}
+
+	if(!jsonPath.empty())
+		writeJSON(jsonPath,results,kindName,minTime);
+	if(!profilePath.empty())
+		Profiler::writeJSON(profilePath);
+	if(!tracePath.empty())
+		Profiler::writeChromeTrace(tracePath);
+
+	// The equivalences are run after the outputs of the profiler, which only cover the measures
+	int nbDifferences=0;
+	bool first=true;
+	for(size_t q=0;q<equivalences.size();q++){
+		const Equivalence& eq=equivalences[q];
+		if(!filter.empty() && eq.name.find(filter)==string::npos && eq.reference.find(filter)==string::npos)
+			continue;
+		if(first){
+			std::cout<<std::endl<<std::left<<std::setw(64)<<"equivalence"<<std::right<<std::setw(14)<<"max diff"
+					<<std::setw(14)<<"tolerance"<<std::endl;
+			first=false;
+		}
+		for(size_t s=0;s<runSizes.size();s++){
+			std::ostringstream name;
+			name<<eq.name<<"/"<<runSizes[s].width<<"x"<<runSizes[s].height<<" = "<<eq.reference;
+			std::cout<<std::left<<std::setw(64)<<name.str()<<std::right<<std::flush;
+			double diff;
+			string skipped=compareOne(*find(eq.name),*find(eq.reference),runSizes[s],kind,eq.elementwise,diff);
+			if(!skipped.empty()){
+				std::cout<<"  skipped: "<<skipped<<std::endl;
+				continue;
+			}
+			bool ok=diff<=eq.tolerance;
+			nbDifferences+=!ok;
+			if(diff==HUGE_VAL)
+				std::cout<<"  different numbers, sizes or types of outputs"<<std::endl;
+			else
+				std::cout<<std::setw(14)<<std::setprecision(3)<<diff<<std::setw(14)<<eq.tolerance<<"  "<<(ok ? "ok" : "DIFFERENT")<<std::endl;
+		}
+	}
+
+	if(nbMismatches>0)
+		std::cout<<nbMismatches<<" benchmark(s) do not match the baseline"<<std::endl;
+	if(nbDifferences>0)
+		std::cout<<nbDifferences<<" equivalence(s) above their tolerance"<<std::endl;
+	return nbMismatches>0 || nbDifferences>0 ? 1 : 0;
+}
+
+BenchHarness::~BenchHarness() {
+}
@@ -0,0 +1,307 @@
+/**
+ * \file BenchHarness.h
+ * \brief Minimal benchmark harness with JSON results and checks of the outputs against a baseline
+ * \version 1.0
+ * \date October 17, 2026
+ *
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the distribution
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef BENCHHARNESS_H_
+#define BENCHHARNESS_H_
+
+#include <iostream>
+#include <opencv/cv.h>
+#include <opencv/highgui.h>
+#include <vector>
+#include <string>
+#include "SyntheticImages.h"
+
+using namespace cv;
+
+/*!
+ *  \brief Checksum of the output of a benchmark, used to check that an optimisation does not change the results
+ */
+struct BenchChecksum {
+	double count;	/*!< Number of values */
+	double sum;		/*!< Sum of the values */
+	double l1;		/*!< Sum of the absolute values */
+	double l2;		/*!< Euclidean norm of the values */
+
+	BenchChecksum();
+	/*!
+	 *  \brief Compute the checksum of Mats, as if their values were concatenated
+	 *
+	 *  \param M : Mats of any depth and any number of channels
+	 */
+	BenchChecksum(const vector<Mat>& M);
+	/*!
+	 *  \brief Check if two checksums are equal up to a relative tolerance
+	 *
+	 *  \param ref : The reference checksum
+	 *  \param tolerance : The tolerance relative to the l1 and l2 norms of the reference
+	 *  \return Return true if the checksums match
+	 */
+	bool matches(const BenchChecksum& ref,const double& tolerance) const;
+};
+
+/*! \class BenchState
+   * \brief State given to a benchmark function
+   *
+   *  A benchmark prepares its inputs, repeats the measured code while keepRunning() is true,
+   *  then gives its last output to setResult():
+   *  \code
+   *  static void benchFFT2(BenchState& state){
+   *      Mat X=SyntheticImages::generate(state.getSize(),state.getKind(),1);
+   *      Mat F;
+   *      while(state.keepRunning())
+   *          dft(X,F);
+   *      state.setResult(F);
+   *  }
+   *  \endcode
+   *  Only the iterations of the loop are timed.
+   */
+class BenchState {
+private:
+	Size size;				/*!< The size of the images */
+	SyntheticKind kind;		/*!< The content of the images */
+	int64 iterations;		/*!< The number of iterations to run */
+	int64 done;				/*!< The number of iterations already run */
+	int64 startTick;		/*!< Start of the loop (cv::getTickCount) */
+	double startCpu;		/*!< Start of the loop (std::clock) */
+	double realTime;		/*!< Duration of the loop in seconds */
+	double cpuTime;			/*!< CPU time of the loop in seconds (all the threads of the process) */
+	vector<Mat> result;		/*!< The last outputs */
+	string skipReason;		/*!< Not empty if the benchmark cannot be run for this size */
+
+	friend class BenchHarness;
+
+public:
+	/*!
+	 *  \brief Constructor of BenchState class
+	 *
+	 *  \param size : The size of the images
+	 *  \param kind : The content of the images
+	 *  \param iterations : The number of iterations to run
+	 *
+	 */
+	BenchState(const Size& size,const SyntheticKind& kind,const int64& iterations);
+	/*!
+	 *  \brief Start, continue or stop the measured loop
+	 *
+	 *  \return Return true while iterations have to be run
+	 */
+	bool keepRunning();
+	/*!
+	 *  \brief Give the output of the benchmark, used for the checksum
+	 *
+	 *  \param res : The output (not copied)
+	 */
+	void setResult(const Mat& res);
+	/*!
+	 *  \brief Give the output of the benchmark, used for the checksum
+	 *
+	 *  \param res : The output (copied)
+	 */
+	void setResult(const vector<double>& res);
+	/*!
+	 *  \brief Give the outputs of the benchmark, used for the checksum
+	 *
+	 *  \param res : The outputs (not copied)
+	 */
+	void setResult(const vector<Mat>& res);
+	/*!
+	 *  \brief Do not run the benchmark for this size
+	 *
+	 *  \param reason : The reason, printed instead of the results
+	 */
+	void skip(const string& reason);
+	/*!
+	 *  \brief Get the size of the images
+	 *
+	 *  \return Return the size of the images of the benchmark
+	 */
+	Size getSize() const;
+	/*!
+	 *  \brief Get the content of the images
+	 *
+	 *  \return Return the kind of the synthetic images of the benchmark
+	 */
+	SyntheticKind getKind() const;
+};
+
+typedef void (*BenchFunction)(BenchState& state);
+
+/*! \class BenchHarness
+   * \brief Run benchmarks for several image sizes and compare them to a baseline
+   *
+   *  Each benchmark is run once to warm up and to compute the checksum of its output, then
+   *  with an increasing number of iterations until the loop lasts at least the minimal time.
+   *  The results are printed and can be written in a JSON file with the layout of Google
+   *  Benchmark (one benchmark per line, with the checksums as extra fields). Given such a file
+   *  as baseline, the speedup of each benchmark is printed and the checksums are compared.
+   *
+   *  The pairs of benchmarks registered by addEquivalence (a legacy function and the one which
+   *  replaces it) are then run once more for each size and their outputs are compared, so a
+   *  run fails when a new function does not give the results of the legacy one, with or
+   *  without a baseline.
+   *
+   *  Options of run():
+   *   - --filter=text : only run the benchmarks whose name contains text
+   *   - --sizes=WxH,WxH... : the sizes of the images
+   *   - --image=noise|smooth|shapes : the content of the images (smooth by default)
+   *   - --min-time=seconds : the minimal duration of the measured loop (0.5 by default)
+   *   - --json=file : write the results in a JSON file
+   *   - --baseline=file : compare to the results written by --json
+   *   - --tolerance=t : the relative tolerance of the checksums (1e-6 by default)
+   *   - --list : print the names of the benchmarks
+   *   - --profile=file : write the statistics of the stages in a JSON file (see Profiler)
+   *   - --trace=file : write the runs of the stages in the Chrome trace format (see Profiler)
+   */
+class BenchHarness {
+private:
+	/*!
+	 *  \brief A registered benchmark
+	 */
+	struct Entry {
+		string name;			/*!< The name of the benchmark */
+		BenchFunction function;	/*!< The function to measure */
+	};
+	/*!
+	 *  \brief Two benchmarks which must give the same output
+	 */
+	struct Equivalence {
+		string name;			/*!< The name of the benchmark to check */
+		string reference;		/*!< The name of the benchmark giving the expected output */
+		double tolerance;		/*!< The largest relative difference */
+		bool elementwise;		/*!< The differences are relative to each expected value instead of the largest one */
+	};
+	/*!
+	 *  \brief The result of a benchmark, as written in the JSON file
+	 */
+	struct Result {
+		string name;			/*!< The name of the benchmark and the size */
+		int64 iterations;		/*!< The number of iterations of the last loop */
+		double realTime;		/*!< Time per iteration in ns */
+		double cpuTime;			/*!< CPU time per iteration in ns */
+		BenchChecksum checksum;	/*!< Checksum of the output */
+	};
+	vector<Entry> entries;		/*!< The registered benchmarks */
+	vector<Equivalence> equivalences;	/*!< The registered pairs of benchmarks */
+	vector<Size> sizes;			/*!< The default sizes of the images */
+
+	/*!
+	 *  \brief Run a benchmark until the loop lasts minTime
+	 *
+	 *  \param entry : The benchmark
+	 *  \param size : The size of the images
+	 *  \param kind : The content of the images
+	 *  \param minTime : The minimal duration of the loop in seconds
+	 *  \param res : The output
+	 *  \return Return an empty string or the reason why the benchmark has been skipped
+	 */
+	static string runOne(const Entry& entry,const Size& size,const SyntheticKind& kind,const double& minTime,Result& res);
+	/*!
+	 *  \brief Find a registered benchmark
+	 *
+	 *  \param name : The name given to add()
+	 *  \return Return the benchmark, or 0 if there is none of this name
+	 */
+	const Entry* find(const string& name) const;
+	/*!
+	 *  \brief Run both benchmarks of an equivalence once and compare their outputs
+	 *
+	 *  \param entry : The benchmark to check
+	 *  \param reference : The benchmark giving the expected output
+	 *  \param size : The size of the images
+	 *  \param kind : The content of the images
+	 *  \param elementwise : The differences are relative to each expected value instead of the largest one
+	 *  \param diff : The output, the largest relative difference (HUGE_VAL if the outputs have
+	 *  different numbers, sizes or types of Mat)
+	 *  \return Return an empty string or the reason why one of the benchmarks has been skipped
+	 */
+	static string compareOne(const Entry& entry,const Entry& reference,const Size& size,const SyntheticKind& kind,const bool& elementwise,double& diff);
+	/*!
+	 *  \brief Write results in a JSON file
+	 *
+	 *  \param path : The path of the file
+	 *  \param results : The results
+	 *  \param kind : The content of the images
+	 *  \param minTime : The minimal duration of the loops
+	 */
+	static void writeJSON(const string& path,const vector<Result>& results,const string& kind,const double& minTime);
+	/*!
+	 *  \brief Read the results of a JSON file written by writeJSON
+	 *
+	 *  \param path : The path of the file
+	 *  \return Return the results
+	 */
+	static vector<Result> readJSON(const string& path);
+	/*!
+	 *  \brief Parse a list of sizes
+	 *
+	 *  \param text : Sizes separated by commas, e.g. "64x64,640x480" (width x height)
+	 *  \return Return the sizes
+	 */
+	static vector<Size> parseSizes(const string& text);
+
+public:
+	/*!
+	 *  \brief Constructor of BenchHarness class
+	 *
+	 *  \param sizes : The default sizes of the images
+	 *
+	 */
+	BenchHarness(const vector<Size>& sizes);
+	/*!
+	 *  \brief Register a benchmark
+	 *
+	 *  \param name : The name of the benchmark, the size of the images is appended to it
+	 *  \param function : The function to measure
+	 */
+	void add(const string& name,BenchFunction function);
+	/*!
+	 *  \brief Register two benchmarks which must give the same output
+	 *
+	 *  \param name : The name of the benchmark to check, given to add()
+	 *  \param reference : The name of the benchmark giving the expected output, given to add()
+	 *  \param tolerance : The largest relative difference
+	 *  \param elementwise : The differences are relative to each expected value (for energies and
+	 *  descriptors, see BenchCheck::relativeDiff) instead of the largest magnitude of the output
+	 */
+	void addEquivalence(const string& name,const string& reference,const double& tolerance,const bool& elementwise=false);
+	/*!
+	 *  \brief Run the benchmarks
+	 *
+	 *  \param argc : The number of arguments of the program
+	 *  \param argv : The arguments of the program (see the options above)
+	 *  \return Return 0, or 1 if a checksum does not match the baseline, if the outputs of an
+	 *  equivalence differ or if an option is wrong
+	 */
+	int run(int argc,char** argv);
+
+	virtual ~BenchHarness();
+};
+
+#endif /* BENCHHARNESS_H_ */
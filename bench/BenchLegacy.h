@@ -0,0 +1,64 @@
+/**
+ * \file BenchLegacy.h
+ * \brief Legacy descriptors used as references by the benchmark programs
+ * \version 1.0
+ * \date October 17, 2026
+ *
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the distribution
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef BENCHLEGACY_H_
+#define BENCHLEGACY_H_
+
+#include <iostream>
+#include <opencv/cv.h>
+#include <vector>
+#include "../DescriptorExtractor.h"
+#include "../GFD1.h"
+#include "../GCFD1.h"
+#include "../GCFD3.h"
+
+using namespace cv;
+
+/*!
+ *  \brief Compute a descriptor with the legacy constructor of its class
+ *
+ *  \param type : The descriptor
+ *  \param im : The image
+ *  \param Biv : A color vector used to build the bivector B=Biv^e4
+ *  \param Dcircles : The discrete circles of the image (see MyTools::computeDiscreteCircles)
+ *  \return Return the descriptor
+ */
+inline vector<double> legacyDescriptor(const DescriptorType& type,const Mat& im,const Mat& Biv,const vector<Mat>& Dcircles){
+	switch(type){
+	case GFD1_DESCRIPTOR:
+		return GFD1(im,Biv,Dcircles);
+	case GCFD1_DESCRIPTOR:
+		return GCFD1(im,Biv,Dcircles);
+	default:
+		return GCFD3(im,Biv,Dcircles);
+	}
+}
+
+#endif /* BENCHLEGACY_H_ */
@@ -0,0 +1,116 @@
+/**
+ * \file SyntheticImages.cpp
+ * \brief Deterministic synthetic images for the benchmarks
+ * \version 1.0
+ * \date October 17, 2026
+ *
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the distribution
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "SyntheticImages.h"
+#include <cmath>
+
+Mat SyntheticImages::generate(const Size& size,const SyntheticKind& kind,const int& channels,const uint64& seed){
+	CV_Assert(size.width>0 && size.height>0 && (channels==1 || channels==3 || channels==4));
+	RNG rng(seed+1);
+	Mat im(size,CV_8UC(channels));
+	switch(kind){
+	case SYNTHETIC_NOISE:
+		rng.fill(im,RNG::UNIFORM,0,256);
+		break;
+	case SYNTHETIC_SMOOTH:{
+		// Each channel is a sum of 4 waves of at most 8 periods along the image
+		const int nbWaves=4;
+		vector<double> fx(channels*nbWaves),fy(channels*nbWaves),phase(channels*nbWaves);
+		for(int k=0;k<channels*nbWaves;k++){
+			fx[k]=2*CV_PI*rng.uniform(-8.,8.)/size.width;
+			fy[k]=2*CV_PI*rng.uniform(-8.,8.)/size.height;
+			phase[k]=rng.uniform(0.,2*CV_PI);
+		}
+		for(int i=0;i<size.height;i++){
+			uchar* p=im.ptr<uchar>(i);
+			for(int j=0;j<size.width;j++){
+				for(int c=0;c<channels;c++){
+					double v=0;
+					for(int k=c*nbWaves;k<(c+1)*nbWaves;k++)
+						v+=std::cos(fx[k]*j+fy[k]*i+phase[k]);
+					p[j*channels+c]=saturate_cast<uchar>(128+127*v/nbWaves);
+				}
+			}
+		}
+		break;
+	}
+	case SYNTHETIC_SHAPES:{
+		// Background gradient
+		for(int i=0;i<size.height;i++){
+			uchar* p=im.ptr<uchar>(i);
+			for(int j=0;j<size.width;j++)
+				for(int c=0;c<channels;c++)
+					p[j*channels+c]=saturate_cast<uchar>(255.*(c%2==0 ? j : i)/std::max(size.width,size.height));
+		}
+		// Discs (even shapes) and rectangles (odd shapes) of random colors
+		const int nbShapes=12;
+		const int maxSize=std::max(2,std::min(size.width,size.height)/4);
+		for(int s=0;s<nbShapes;s++){
+			int cx=rng.uniform(0,size.width);
+			int cy=rng.uniform(0,size.height);
+			int r=rng.uniform(1,maxSize);
+			uchar color[4];
+			for(int c=0;c<4;c++)
+				color[c]=(uchar)rng.uniform(0,256);
+			for(int i=std::max(0,cy-r);i<std::min(size.height,cy+r+1);i++){
+				uchar* p=im.ptr<uchar>(i);
+				for(int j=std::max(0,cx-r);j<std::min(size.width,cx+r+1);j++){
+					if(s%2==0 && (i-cy)*(i-cy)+(j-cx)*(j-cx)>r*r)
+						continue;
+					for(int c=0;c<channels;c++)
+						p[j*channels+c]=color[c];
+				}
+			}
+		}
+		break;
+	}
+	default:
+		CV_Error(CV_StsBadArg,"SyntheticImages: unknown kind");
+	}
+	return im;
+}
+
+vector<Mat> SyntheticImages::generateSet(const int& n,const Size& size,const SyntheticKind& kind,const int& channels,const uint64& seed){
+	vector<Mat> images(n);
+	for(int i=0;i<n;i++)
+		images[i]=generate(size,kind,channels,seed+i);
+	return images;
+}
+
+SyntheticKind SyntheticImages::parseKind(const string& kind){
+	if(kind=="noise")
+		return SYNTHETIC_NOISE;
+	if(kind=="smooth")
+		return SYNTHETIC_SMOOTH;
+	if(kind=="shapes")
+		return SYNTHETIC_SHAPES;
+	CV_Error(CV_StsBadArg,"SyntheticImages: the kind must be \"noise\", \"smooth\" or \"shapes\"");
+	return SYNTHETIC_NOISE;
+}
@@ -0,0 +1,89 @@
+/**
+ * \file SyntheticImages.h
+ * \brief Deterministic synthetic images for the benchmarks
+ * \version 1.0
+ * \date October 17, 2026
+ *
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the distribution
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SYNTHETICIMAGES_H_
+#define SYNTHETICIMAGES_H_
+
+#include <iostream>
+#include <opencv/cv.h>
+#include <opencv/highgui.h>
+#include <vector>
+#include <string>
+
+using namespace cv;
+
+/*!
+ *  \brief The content of a synthetic image
+ */
+enum SyntheticKind {
+	SYNTHETIC_NOISE,		/*!< Uniform noise: a flat spectrum */
+	SYNTHETIC_SMOOTH,		/*!< Sum of random low frequency waves: a spectrum concentrated near the null frequency */
+	SYNTHETIC_SHAPES		/*!< Colored discs and rectangles on a gradient: edges as in natural images */
+};
+
+/*! \class SyntheticImages
+   * \brief Generators of images which are the same on every machine
+   *
+   *  The images only depend on their size, kind and seed (cv::RNG), so the outputs of the
+   *  benchmarks can be compared between two builds.
+   */
+class SyntheticImages {
+public:
+	/*!
+	 *  \brief Generate an image
+	 *
+	 *  \param size : The size of the image
+	 *  \param kind : The content of the image
+	 *  \param channels : The number of channels (1, 3 or 4)
+	 *  \param seed : The seed of the random generator
+	 *  \return Return an image of uchar
+	 */
+	static Mat generate(const Size& size,const SyntheticKind& kind,const int& channels=3,const uint64& seed=0);
+	/*!
+	 *  \brief Generate a set of images
+	 *
+	 *  \param n : The number of images
+	 *  \param size : The size of the images
+	 *  \param kind : The content of the images
+	 *  \param channels : The number of channels (1, 3 or 4)
+	 *  \param seed : The seed of the first image, the seed of the image i is seed+i
+	 *  \return Return n images of uchar
+	 */
+	static vector<Mat> generateSet(const int& n,const Size& size,const SyntheticKind& kind,const int& channels=3,const uint64& seed=0);
+	/*!
+	 *  \brief Convert the name of a kind
+	 *
+	 *  \param kind : "noise", "smooth" or "shapes"
+	 *  \return Return the corresponding SyntheticKind
+	 */
+	static SyntheticKind parseKind(const string& kind);
+};
+
+#endif /* SYNTHETICIMAGES_H_ */
@@ -0,0 +1,126 @@
+/**
+ * \file benchAllocations.cpp
+ * \brief Number of heap allocations done to compute the CFT of an image
+ * \version 1.0
+ * \date October 17, 2026
+ *
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the distribution
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Usage: benchAllocations [size [nbImages]]
+ *
+ * Counts the heap allocations (malloc, calloc, realloc and aligned allocations, which also
+ * catch operator new and cv::fastMalloc) done per image by CFT and by CFTPlan, and prints
+ * the time per image of both. The counting relies on the interposition of the glibc
+ * allocation functions, so it is only available with glibc, where the program fails if CFTPlan
+ * does not make fewer allocations per image than CFT (the ones left are made inside cv::dft).
+ */
+
+#include <iostream>
+#include <cstdlib>
+#include <opencv/cv.h>
+#include "../CFT.h"
+#include "../CFTPlan.h"
+#include "BenchCheck.h"
+
+using namespace cv;
+
+static long nbAllocations=0;	/*!< Number of allocations since the start of the program */
+
+#ifdef __GLIBC__
+extern "C" {
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t n,size_t size);
+void* __libc_realloc(void* p,size_t size);
+void* __libc_memalign(size_t alignment,size_t size);
+
+void* malloc(size_t size){
+	CV_XADD(&nbAllocations,1);
+	return __libc_malloc(size);
+}
+
+void* calloc(size_t n,size_t size){
+	CV_XADD(&nbAllocations,1);
+	return __libc_calloc(n,size);
+}
+
+void* realloc(void* p,size_t size){
+	CV_XADD(&nbAllocations,1);
+	return __libc_realloc(p,size);
+}
+
+void* memalign(size_t alignment,size_t size){
+	CV_XADD(&nbAllocations,1);
+	return __libc_memalign(alignment,size);
+}
+
+int posix_memalign(void** p,size_t alignment,size_t size){
+	CV_XADD(&nbAllocations,1);
+	*p=__libc_memalign(alignment,size);
+	return *p ? 0 : 12;
+}
+}
+#endif
+
+int main(int argc,char** argv){
+	int size=argc>1 ? atoi(argv[1]) : 511;
+	int nbImages=argc>2 ? atoi(argv[2]) : 20;
+#ifndef __GLIBC__
+	std::cout<<"The allocations can only be counted with glibc"<<std::endl;
+#endif
+
+	RNG rng(0);
+	Mat X(size,size,CV_8UC3);
+	rng.fill(X,RNG::UNIFORM,0,256);
+	Mat Biv=(Mat_<double>(1,3) << 1,0,0);
+
+	// CFT: every image goes through new temporaries
+	long allocations=nbAllocations;
+	int64 start=getTickCount();
+	for(int i=0;i<nbImages;i++)
+		CFT cft(X,Biv);
+	double tCFT=(getTickCount()-start)/getTickFrequency()/nbImages;
+	double aCFT=(double)(nbAllocations-allocations)/nbImages;
+
+	// CFTPlan: the buffers are allocated by the first image only
+	CFTPlan plan(size,size,Biv);
+	Mat par,orth;
+	plan.execute(X,par,orth);
+	allocations=nbAllocations;
+	start=getTickCount();
+	for(int i=0;i<nbImages;i++)
+		plan.execute(X,par,orth);
+	double tPlan=(getTickCount()-start)/getTickFrequency()/nbImages;
+	double aPlan=(double)(nbAllocations-allocations)/nbImages;
+
+	std::cout<<"size "<<size<<"x"<<size<<std::endl;
+	std::cout<<"CFT\t"<<aCFT<<" allocations/image\t"<<tCFT*1000<<" ms/image"<<std::endl;
+	std::cout<<"CFTPlan\t"<<aPlan<<" allocations/image\t"<<tPlan*1000<<" ms/image"<<std::endl;
+	BenchCheck check;
+#ifdef __GLIBC__
+	check.expect("fewer allocations with CFTPlan than with CFT",aPlan<aCFT);
+#endif
+	return check.getExitCode();
+}
@@ -0,0 +1,104 @@
+/**
+ * \file benchBatchFFT.cpp
+ * \brief Benchmark of the backends of BatchFFT
+ * \version 1.0
+ * \date October 17, 2026
+ *
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the distribution
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Usage: benchBatchFFT [nbPlanes [size ...]]
+ *
+ * Computes the DFT of nbPlanes random complex planes (double and float) with one call of
+ * cv::dft per plane and with each available backend of BatchFFT, and prints the time per
+ * plane of each and the largest difference with cv::dft. The auto line is the backend chosen
+ * by BatchFFT::chooseBackend for the size, given in parentheses. The default sizes are the odd
+ * sizes of the descriptors of 64 and 128 pixel images, and the sizes themselves.
+ * The program fails if a difference, relative to the largest value of the DFT, is above
+ * 1e-12 in double or 1e-5 in float.
+ */
+
+#include <iostream>
+#include <cstdlib>
+#include <opencv/cv.h>
+#include "../BatchFFT.h"
+#include "BenchCheck.h"
+
+using namespace cv;
+
+template<typename T> static void benchSize(const int& size,const int& nbPlanes,BenchCheck& check){
+	const int type=CV_MAKETYPE(DataType<T>::depth,2);
+	const char* depthName=sizeof(T)==sizeof(double) ? "double" : "float";
+	RNG rng(0);
+	Mat stack(nbPlanes*size,size,type);
+	rng.fill(stack,RNG::UNIFORM,-1,1);
+
+	Mat ref(stack.size(),type);
+	int64 start=getTickCount();
+	for(int k=0;k<nbPlanes;k++){
+		Mat out=ref.rowRange(k*size,(k+1)*size);
+		dft(stack.rowRange(k*size,(k+1)*size),out,0,0);
+	}
+	double tRef=(getTickCount()-start)/getTickFrequency();
+	std::cout<<size<<"\t"<<depthName<<"\tdft\t"<<1000*tRef/nbPlanes<<"\t0"<<std::endl;
+
+	const FFTBackend backends[4]={FFT_BACKEND_OPENCV,FFT_BACKEND_BUILTIN,FFT_BACKEND_FFTW,FFT_BACKEND_AUTO};
+	for(int b=0;b<4;b++){
+		if(!BatchFFT_<T>::isAvailable(backends[b]))
+			continue;
+		BatchFFT_<T> fft(size,size,nbPlanes,backends[b]);
+		string name=BatchFFT_<T>::getBackendName(backends[b]);
+		if(backends[b]==FFT_BACKEND_AUTO)
+			name+=" ("+BatchFFT_<T>::getBackendName(fft.getBackend())+")";
+		Mat res;
+		fft.execute(stack,res);
+		start=getTickCount();
+		fft.execute(stack,res);
+		double t=(getTickCount()-start)/getTickFrequency();
+		double diff=norm(ref,res,NORM_INF);
+		std::cout<<size<<"\t"<<depthName<<"\t"<<name<<"\t"<<1000*t/nbPlanes<<"\t"<<diff<<std::endl;
+		check.expect(name+" "+depthName+" vs cv::dft",
+				diff/norm(ref,NORM_INF),sizeof(T)==sizeof(double) ? 1e-12 : 1e-5);
+	}
+}
+
+int main(int argc,char** argv){
+	int nbPlanes=argc>1 ? atoi(argv[1]) : 256;
+	vector<int> sizes;
+	for(int i=2;i<argc;i++)
+		sizes.push_back(atoi(argv[i]));
+	if(sizes.empty()){
+		const int defaults[]={63,64,127,128};
+		sizes.assign(defaults,defaults+4);
+	}
+
+	BenchCheck check;
+	std::cout<<"size\tdepth\tbackend\tms/plane\tmax diff"<<std::endl;
+	for(size_t i=0;i<sizes.size();i++){
+		benchSize<double>(sizes[i],nbPlanes,check);
+		benchSize<float>(sizes[i],nbPlanes,check);
+	}
+	return check.getExitCode();
+}
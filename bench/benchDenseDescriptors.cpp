@@ -0,0 +1,105 @@
+/**
+ * \file benchDenseDescriptors.cpp
+ * \brief Benchmark of the dense extraction of descriptors
+ * \version 1.0
+ * \date October 17, 2026
+ *
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the distribution
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Usage: benchDenseDescriptors [width height [window [gfd1|gcfd1|gcfd3]]]
+ *
+ * Computes the descriptors of all the windows of a random image for strides of 1 to 16
+ * pixels, with the sliding DFT and with one CFT per window, and prints their time per window
+ * and the one of the legacy descriptor (GCFD3(window,Biv,Dcircles)) computed window by window.
+ * The legacy descriptor is only computed on the first 200 windows of the map, which are also
+ * used to give the largest relative difference between both strategies and the legacy one.
+ * The program fails if it is above 1e-9.
+ */
+
+#include <iostream>
+#include <cstdlib>
+#include <cstring>
+#include <opencv/cv.h>
+#include "../DenseDescriptors.h"
+#include "BenchCheck.h"
+#include "BenchLegacy.h"
+
+using namespace cv;
+
+int main(int argc,char** argv){
+	int width=argc>2 ? atoi(argv[1]) : 640;
+	int height=argc>2 ? atoi(argv[2]) : 480;
+	int size=argc>3 ? atoi(argv[3]) : 31;
+	DescriptorType type=GCFD3_DESCRIPTOR;
+	if(argc>4 && strcmp(argv[4],"gfd1")==0)
+		type=GFD1_DESCRIPTOR;
+	if(argc>4 && strcmp(argv[4],"gcfd1")==0)
+		type=GCFD1_DESCRIPTOR;
+
+	RNG rng(0);
+	Mat im(height,width,CV_8UC3);
+	rng.fill(im,RNG::UNIFORM,0,256);
+	Mat Biv=(Mat_<double>(1,3) << 1,0,0);
+	Size window(size,size);
+	vector<Mat> Dcircles=MyTools::computeDiscreteCircles((size-(size%2==0))/2);
+
+	BenchCheck check;
+	std::cout<<"stride\twindows\tauto\tlegacy ms/win\tsliding ms/win\tfft ms/win\tsliding diff\tfft diff"<<std::endl;
+	for(int s=1;s<=16;s*=2){
+		Size stride(s,s);
+		DenseDescriptors sliding(type,Biv,window,stride,DENSE_SLIDING);
+		DenseDescriptors fft(type,Biv,window,stride,DENSE_FFT);
+		Size mapSize=sliding.getMapSize(im.size());
+		int nbWindows=mapSize.area();
+		const int D=sliding.getDescriptorSize();
+
+		int64 start=getTickCount();
+		Mat S=sliding.compute(im);
+		double tSliding=(getTickCount()-start)/getTickFrequency();
+		start=getTickCount();
+		Mat F=fft.compute(im);
+		double tFFT=(getTickCount()-start)/getTickFrequency();
+
+		int nbLegacy=std::min(nbWindows,200);
+		double diffSliding=0,diffFFT=0,tLegacy=0;
+		for(int i=0;i<nbLegacy;i++){
+			int x=i%mapSize.width;
+			int y=i/mapSize.width;
+			start=getTickCount();
+			vector<double> ref=legacyDescriptor(type,im(sliding.getWindow(x,y)),Biv,Dcircles);
+			tLegacy+=(getTickCount()-start)/getTickFrequency();
+			diffSliding=std::max(diffSliding,BenchCheck::relativeDiff(S.row(y).colRange(x*D,(x+1)*D),Mat(ref)));
+			diffFFT=std::max(diffFFT,BenchCheck::relativeDiff(F.row(y).colRange(x*D,(x+1)*D),Mat(ref)));
+		}
+
+		std::cout<<s<<"\t"<<nbWindows<<"\t"<<(DenseDescriptors::chooseStrategy(window,stride)==DENSE_SLIDING ? "sliding" : "fft")<<"\t"
+				<<1000*tLegacy/nbLegacy<<"\t"<<1000*tSliding/nbWindows<<"\t"<<1000*tFFT/nbWindows<<"\t"
+				<<diffSliding<<"\t"<<diffFFT<<std::endl;
+		check.expect("sliding vs legacy",diffSliding,1e-9);
+		check.expect("fft vs legacy",diffFFT,1e-9);
+	}
+	return check.getExitCode();
+}
@@ -0,0 +1,99 @@
+/**
+ * \file benchDescriptorBatch.cpp
+ * \brief Scaling benchmark of DescriptorBatch with the number of threads
+ * \version 1.0
+ * \date October 17, 2026
+ *
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the distribution
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Usage: benchDescriptorBatch [nbImages [size [gfd1|gcfd1|gcfd3]]]
+ *
+ * Computes the descriptors of random images with 1, 2, 4... threads up to the number
+ * of CPUs and prints the throughput and the speedup relative to one thread. The descriptors
+ * of the first 20 images are compared to the legacy ones (GFD1, GCFD1 or GCFD3 with the
+ * circles computed beforehand): the program fails if a relative difference is above 1e-9, or
+ * if a number of threads changes a result.
+ */
+
+#include <iostream>
+#include <cstdlib>
+#include <cstring>
+#include <opencv/cv.h>
+#include "../DescriptorBatch.h"
+#include "BenchCheck.h"
+#include "BenchLegacy.h"
+
+using namespace cv;
+
+int main(int argc,char** argv){
+	int nbImages=argc>1 ? atoi(argv[1]) : 2000;
+	int size=argc>2 ? atoi(argv[2]) : 63;
+	DescriptorType type=GCFD1_DESCRIPTOR;
+	if(argc>3 && strcmp(argv[3],"gfd1")==0)
+		type=GFD1_DESCRIPTOR;
+	if(argc>3 && strcmp(argv[3],"gcfd3")==0)
+		type=GCFD3_DESCRIPTOR;
+
+	RNG rng(0);
+	vector<Mat> images(nbImages);
+	for(int i=0;i<nbImages;i++){
+		images[i].create(size,size,CV_8UC3);
+		rng.fill(images[i],RNG::UNIFORM,0,256);
+	}
+	Mat Biv=(Mat_<double>(1,3) << 1,0,0);
+
+	BenchCheck check;
+	int nbCPUs=getNumberOfCPUs();
+	double reference=0;
+	Mat first;
+	std::cout<<"threads\timages/s\tspeedup"<<std::endl;
+	for(int nbThreads=1;;nbThreads=std::min(2*nbThreads,nbCPUs)){
+		setNumThreads(nbThreads);
+		DescriptorBatch batch(type,Biv);
+		batch.compute(vector<Mat>(images.begin(),images.begin()+std::min(nbImages,4*nbThreads)));	// warm up the scratches
+		int64 start=getTickCount();
+		Mat res=batch.compute(images);
+		double seconds=(getTickCount()-start)/getTickFrequency();
+		double throughput=nbImages/seconds;
+		if(nbThreads==1){
+			reference=throughput;
+			first=res;
+		}
+		else
+			check.expect("descriptors with "+MyTools::Int2Str(nbThreads)+" threads vs 1 thread",norm(res,first,NORM_INF),0.);
+		std::cout<<nbThreads<<"\t"<<throughput<<"\t"<<throughput/reference<<std::endl;
+		if(nbThreads==nbCPUs)
+			break;
+	}
+
+	vector<Mat> Dcircles=MyTools::computeDiscreteCircles((size-(size%2==0))/2);
+	double diff=0;
+	for(int i=0;i<std::min(nbImages,20);i++)
+		diff=std::max(diff,BenchCheck::relativeDiff(first.row(i),Mat(legacyDescriptor(type,images[i],Biv,Dcircles))));
+	std::cout<<"max relative diff with the legacy descriptors "<<diff<<std::endl;
+	check.expect("batch vs legacy",diff,1e-9);
+	return check.getExitCode();
+}
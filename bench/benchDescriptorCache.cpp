@@ -0,0 +1,134 @@
+/**
+ * \file benchDescriptorCache.cpp
+ * \brief Benchmark of the cache of the descriptors
+ * \version 1.0
+ * \date October 17, 2026
+ *
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the distribution
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Usage: benchDescriptorCache [width height [nbImages [duplicateRatio [cacheFile]]]]
+ *
+ * Computes the descriptors (GCFD3) of nbImages random smooth images of which a ratio
+ * duplicateRatio are copies of the others (as re-uploaded or regenerated images) and prints
+ * their time per image:
+ *   - batch: DescriptorBatch without cache;
+ *   - cold: DescriptorBatch with an empty DescriptorCache, only the duplicates are found;
+ *   - warm: the same images again, all the descriptors are found in memory;
+ *   - disk: a new cache on the same file (default /tmp/benchDescriptorCache.bin), all the
+ *     descriptors are found on disk.
+ * The hit rate and the bytes of pixels saved of each pass, and the largest difference with the
+ * descriptors of the batch, are printed too. The program fails if a pass does not give
+ * exactly the descriptors of the batch, or if the warm and disk passes miss an image.
+ */
+
+#include <iostream>
+#include <cstdlib>
+#include <cstdio>
+#include <cmath>
+#include <opencv/cv.h>
+#include "../DescriptorBatch.h"
+#include "BenchCheck.h"
+
+using namespace cv;
+
+static double maxDiff(const Mat& a,const Mat& b){
+	double diff=0;
+	for(int r=0;r<a.rows;r++)
+		for(int k=0;k<a.cols;k++)
+			diff=std::max(diff,std::abs(a.at<double>(r,k)-b.at<double>(r,k)));
+	return diff;
+}
+
+static void printPass(const string& name,const double& t,const int& nbImages,const DescriptorCacheStats& stats,const double& diff,BenchCheck& check){
+	std::cout<<name<<"\t"<<1000*t/nbImages<<"\t"<<stats.hitRate<<"\t"<<stats.bytesSaved/(1<<20)<<"\t"<<diff<<std::endl;
+	check.expect(name+" pass vs batch",diff,0.);
+}
+
+int main(int argc,char** argv){
+	int width=argc>2 ? atoi(argv[1]) : 128;
+	int height=argc>2 ? atoi(argv[2]) : 128;
+	int nbImages=argc>3 ? atoi(argv[3]) : 200;
+	double duplicateRatio=argc>4 ? atof(argv[4]) : 0.5;
+	string path=argc>5 ? argv[5] : "/tmp/benchDescriptorCache.bin";
+
+	RNG rng(0);
+	const int nbUnique=std::max(1,(int)(nbImages*(1-duplicateRatio)));
+	vector<Mat> images(nbImages);
+	for(int i=0;i<nbImages;i++){
+		if(i<nbUnique){
+			images[i].create(height,width,CV_8UC3);
+			rng.fill(images[i],RNG::UNIFORM,0,256);
+			GaussianBlur(images[i],images[i],Size(0,0),2);
+		}
+		else
+			images[i]=images[rng.uniform(0,nbUnique)].clone();
+	}
+	Mat Biv=(Mat_<double>(1,3) << 1,0,0);
+	remove(path.c_str());
+
+	DescriptorBatch batch(GCFD3_DESCRIPTOR,Biv);
+	int64 start=getTickCount();
+	Mat ref=batch.compute(images);
+	double tBatch=(getTickCount()-start)/getTickFrequency();
+
+	DescriptorCacheConfig config;
+	config.diskPath=path;
+	config.diskValues=std::max(config.diskValues,ref.cols);
+	Ptr<DescriptorCache> cache=new DescriptorCache(config);
+	DescriptorBatch cached(GCFD3_DESCRIPTOR,Biv);
+	cached.setCache(cache);
+
+	std::cout<<nbImages<<" images "<<width<<"x"<<height<<", "<<nbImages-nbUnique<<" duplicates, "<<ref.cols<<" values"<<std::endl;
+	std::cout<<"pass\tms/image\thit rate\tMB saved\tmax diff"<<std::endl;
+	std::cout<<"batch\t"<<1000*tBatch/nbImages<<"\t0\t0\t0"<<std::endl;
+
+	start=getTickCount();
+	Mat cold=cached.compute(images);
+	double t=(getTickCount()-start)/getTickFrequency();
+	BenchCheck check;
+	printPass("cold",t,nbImages,cache->getStats(),maxDiff(ref,cold),check);
+
+	cache->resetStats();
+	start=getTickCount();
+	Mat warm=cached.compute(images);
+	t=(getTickCount()-start)/getTickFrequency();
+	printPass("warm",t,nbImages,cache->getStats(),maxDiff(ref,warm),check);
+	check.expect("all the images found in memory",cache->getStats().misses==0);
+
+	// A new cache on the same file: the memory tier is empty, the descriptors come from the disk
+	cache=new DescriptorCache(config);
+	cached.setCache(cache);
+	start=getTickCount();
+	Mat disk=cached.compute(images);
+	t=(getTickCount()-start)/getTickFrequency();
+	DescriptorCacheStats stats=cache->getStats();
+	printPass("disk",t,nbImages,stats,maxDiff(ref,disk),check);
+	std::cout<<"disk hits "<<stats.diskHits<<", misses "<<stats.misses<<" (slots shared by several images)"<<std::endl;
+
+	cache.release();
+	remove(path.c_str());
+	return check.getExitCode();
+}
@@ -0,0 +1,136 @@
+/**
+ * \file benchDescriptorIndex.cpp
+ * \brief Recall and throughput of the exact and IVF searches of DescriptorIndex
+ * \version 1.0
+ * \date October 17, 2026
+ *
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the distribution
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Usage: benchDescriptorIndex [nbDescriptors [store.cfd]]
+ *
+ * Runs the exact search and the IVF search with several nprobe on two sets and prints the
+ * queries per second and the recall@10 (the fraction of the 10 exact nearest neighbours
+ * which are found):
+ *  - synthetic: gaussian clusters of dimension 32;
+ *  - descriptors: the GCFD3 of random smooth images computed by DescriptorBatchf, or the rows
+ *    of a DescriptorStore given as argument. They are scaled as MyTools::scaleDesc.
+ * The last 1000 descriptors of each set are the queries, the others are indexed. The program
+ * fails if the IVF search which probes all the lists does not find the exact neighbours.
+ */
+
+#include <iostream>
+#include <cstdlib>
+#include <cmath>
+#include <opencv/cv.h>
+#include "../DescriptorIndex.h"
+#include "../DescriptorBatch.h"
+#include "BenchCheck.h"
+
+using namespace cv;
+
+static double recall(const vector<vector<DMatch> >& found,const vector<vector<DMatch> >& exact){
+	int hits=0,total=0;
+	for(size_t i=0;i<exact.size();i++){
+		for(size_t a=0;a<exact[i].size();a++){
+			for(size_t b=0;b<found[i].size();b++)
+				hits+=found[i][b].trainIdx==exact[i][a].trainIdx;
+			total++;
+		}
+	}
+	return total>0 ? (double)hits/total : 1;
+}
+
+static void run(const string& name,const Mat& X,const bool& scale,BenchCheck& check){
+	const int nbQueries=std::min(1000,X.rows/10);
+	const int k=10;
+	Mat base=X.rowRange(0,X.rows-nbQueries);
+	Mat queries=X.rowRange(X.rows-nbQueries,X.rows);
+	DescriptorIndex index;
+	if(scale)
+		index.setScaling(base);
+	index.add(base);
+
+	vector<vector<DMatch> > exact,found;
+	int64 start=getTickCount();
+	index.knnSearch(queries,exact,k);
+	double t=(getTickCount()-start)/getTickFrequency();
+	std::cout<<name<<"\texact\t-\t"<<nbQueries/t<<"\t1"<<std::endl;
+
+	int nlist=std::max(1,(int)std::sqrt((double)base.rows));
+	start=getTickCount();
+	index.train(nlist);
+	std::cout<<name<<"\ttrain "<<nlist<<" lists\t-\t"<<(getTickCount()-start)/getTickFrequency()<<" s\t-"<<std::endl;
+	for(int nprobe=1;nprobe<=64 && nprobe<=nlist;nprobe*=2){
+		start=getTickCount();
+		index.knnSearch(queries,found,k,nprobe);
+		t=(getTickCount()-start)/getTickFrequency();
+		std::cout<<name<<"\tivf\t"<<nprobe<<"\t"<<nbQueries/t<<"\t"<<recall(found,exact)<<std::endl;
+	}
+	// Probing all the lists is an exhaustive search
+	index.knnSearch(queries,found,k,nlist);
+	check.expect(name+" ivf with all the lists vs exact",1-recall(found,exact),0.);
+}
+
+int main(int argc,char** argv){
+	int nbDescriptors=argc>1 ? atoi(argv[1]) : 100000;
+	RNG rng(0);
+	BenchCheck check;
+
+	std::cout<<"set\tsearch\tnprobe\tqueries/s\trecall@10"<<std::endl;
+
+	// Gaussian clusters
+	const int dim=32,nbClusters=200;
+	Mat centers(nbClusters,dim,CV_32F);
+	rng.fill(centers,RNG::UNIFORM,-1,1);
+	Mat X(nbDescriptors,dim,CV_32F);
+	for(int i=0;i<X.rows;i++){
+		int c=rng.uniform(0,nbClusters);
+		for(int j=0;j<dim;j++)
+			X.at<float>(i,j)=centers.at<float>(c,j)+(float)rng.gaussian(0.2);
+	}
+	run("synthetic",X,false,check);
+
+	Mat D;
+	if(argc>2){
+		DescriptorStore store(argv[2]);
+		D=store.getRows(0,store.getNbRows(),CV_32F);
+	}
+	else{
+		// Descriptors of smooth random images: fewer images since they must be computed
+		const int size=31;
+		vector<Mat> images(std::max(nbDescriptors/10,2000));
+		for(size_t i=0;i<images.size();i++){
+			Mat small(size/8+1,size/8+1,CV_8UC3);
+			rng.fill(small,RNG::UNIFORM,0,256);
+			resize(small,images[i],Size(size,size),0,0,INTER_CUBIC);
+		}
+		Mat Biv=(Mat_<double>(1,3) << 1,0,0);
+		DescriptorBatchf batch(GCFD3_DESCRIPTOR,Biv);
+		D=batch.compute(images);
+	}
+	run("descriptors",D,true,check);
+	return check.getExitCode();
+}
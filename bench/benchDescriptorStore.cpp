@@ -0,0 +1,187 @@
+/**
+ * \file benchDescriptorStore.cpp
+ * \brief Loading time of descriptors saved as text and in a DescriptorStore
+ * \version 1.0
+ * \date October 17, 2026
+ *
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the distribution
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Usage: benchDescriptorStore [nbDescriptors [imageSize [directory]]]
+ *
+ * Writes random GCFD3 descriptors as text (one descriptor per line, as printed by
+ * MyTools::printVector) and in a DescriptorStore with each encoding, then prints for each file
+ * its size, the time to load it into a Mat of double, and the time to open the store and get
+ * the zero-copy view. The program fails if a decoded value differs from the written one by more
+ * than the precision of the encoding, relative to the largest magnitude of its column, or if a
+ * truncated or corrupt header is not rejected by DescriptorStore and DescriptorStoreWriter.
+ */
+
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <iterator>
+#include <cstring>
+#include <cstdlib>
+#include <sys/stat.h>
+#include <opencv/cv.h>
+#include "../DescriptorStore.h"
+#include "BenchCheck.h"
+
+using namespace cv;
+
+static double seconds(const int64& start){
+	return (getTickCount()-start)/getTickFrequency();
+}
+
+static long long fileSize(const string& path){
+	struct stat st;
+	return stat(path.c_str(),&st)==0 ? (long long)st.st_size : 0;
+}
+
+// Largest difference of a column relative to the largest magnitude of the column
+static double columnError(const Mat& D,const Mat& R){
+	double err=0;
+	for(int j=0;j<D.cols;j++){
+		double scale=norm(D.col(j),NORM_INF);
+		err=std::max(err,norm(D.col(j),R.col(j),NORM_INF)/(scale>0 ? scale : 1));
+	}
+	return err;
+}
+
+// True if both the reader and the writer refuse to open the file
+static bool isRejected(const string& path){
+	int nbRejected=0;
+	try{
+		DescriptorStore store(path);
+	}
+	catch(const cv::Exception&){
+		nbRejected++;
+	}
+	try{
+		DescriptorStoreWriter writer(path);
+	}
+	catch(const cv::Exception&){
+		nbRejected++;
+	}
+	return nbRejected==2;
+}
+
+// Write the first size bytes of a valid store, with the int32 at the position field set to value
+static void writeCorrupt(const string& path,const vector<char>& valid,const size_t& size,const int& field,const int& value){
+	vector<char> bytes(valid.begin(),valid.begin()+size);
+	if(field>=0)
+		memcpy(&bytes[field],&value,sizeof(value));
+	std::ofstream out(path.c_str(),std::ios::binary);
+	out.write(&bytes[0],bytes.size());
+}
+
+int main(int argc,char** argv){
+	int nbDescriptors=argc>1 ? atoi(argv[1]) : 200000;
+	int size=argc>2 ? atoi(argv[2]) : 63;
+	string dir=argc>3 ? argv[3] : "/tmp";
+
+	Mat Biv=(Mat_<double>(1,3) << 1,0,0);
+	DescriptorStoreHeader header(GCFD3_DESCRIPTOR,Biv,Size(size,size),ENCODING_FLOAT64);
+	Mat D(nbDescriptors,header.dim,CV_64F);
+	RNG rng(0);
+	rng.fill(D,RNG::UNIFORM,0,1);
+	for(int i=0;i<nbDescriptors;i++)
+		D.at<double>(i,0)=rng.uniform(1e6,1e9);
+
+	BenchCheck check;
+	std::cout<<"format\tsize (MB)\tload (s)\topen+view (s)"<<std::endl;
+
+	string textPath=dir+"/benchDescriptorStore.txt";
+	{
+		std::ofstream out(textPath.c_str());
+		out<<std::setprecision(17);
+		for(int i=0;i<D.rows;i++){
+			for(int k=0;k<D.cols;k++)
+				out<<D.at<double>(i,k)<<" ";
+			out<<std::endl;
+		}
+	}
+	int64 start=getTickCount();
+	Mat T(nbDescriptors,header.dim,CV_64F);
+	{
+		std::ifstream in(textPath.c_str());
+		for(int i=0;i<T.rows;i++)
+			for(int k=0;k<T.cols;k++)
+				in>>T.at<double>(i,k);
+	}
+	std::cout<<"text\t"<<fileSize(textPath)/1048576.<<"\t"<<seconds(start)<<"\t-"<<std::endl;
+	check.expect("text",columnError(D,T),0.);
+	remove(textPath.c_str());
+
+	const char* names[4]={"float64","float32","float16","int8"};
+	// Rounding of each encoding: none, float, half float, half of the int8 step over [-127,127]
+	const double tolerances[4]={0,1e-7,1e-3,1./254};
+	for(int e=0;e<4;e++){
+		string path=dir+"/benchDescriptorStore.cfd";
+		header.encoding=(DescriptorEncoding)e;
+		{
+			DescriptorStoreWriter writer(path,header);
+			if(e>=ENCODING_FLOAT16)
+				writer.setQuantization(D);
+			writer.append(D);
+		}
+		start=getTickCount();
+		double tView;
+		Mat R;
+		{
+			DescriptorStore store(path);
+			Mat view=store.getView();
+			tView=seconds(start);
+			R=store.getRows(0,store.getNbRows());
+		}
+		std::cout<<names[e]<<"\t"<<fileSize(path)/1048576.<<"\t"<<seconds(start)<<"\t"<<tView<<std::endl;
+		check.expect(names[e],columnError(D,R),tolerances[e]);
+		remove(path.c_str());
+	}
+
+	// The fields of the 128 bytes header are at fixed positions: encoding at 20, stride at 40
+	string path=dir+"/benchDescriptorStore.cfd";
+	header.encoding=ENCODING_FLOAT32;
+	{
+		DescriptorStoreWriter writer(path,header);
+		writer.append(D.rowRange(0,std::min(D.rows,4)));
+	}
+	vector<char> valid;
+	{
+		std::ifstream in(path.c_str(),std::ios::binary);
+		valid.assign(std::istreambuf_iterator<char>(in),std::istreambuf_iterator<char>());
+	}
+	writeCorrupt(path,valid,64,-1,0);
+	check.expect("truncated header rejected",isRejected(path));
+	writeCorrupt(path,valid,valid.size(),40,0);
+	check.expect("stride 0 rejected",isRejected(path));
+	writeCorrupt(path,valid,valid.size(),40,8);
+	check.expect("short stride rejected",isRejected(path));
+	writeCorrupt(path,valid,valid.size(),20,7);
+	check.expect("encoding out of range rejected",isRejected(path));
+	remove(path.c_str());
+	return check.getExitCode();
+}
@@ -0,0 +1,95 @@
+/**
+ * \file benchFixedSize.cpp
+ * \brief Benchmark of the integrations compiled for fixed sizes
+ * \version 1.0
+ * \date October 17, 2026
+ *
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the distribution
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Usage: benchFixedSize [gfd1|gcfd1|gcfd3]
+ *
+ * For the images of 64, 128 and 256 pixels, computes the CFT of a random image (in double) and
+ * prints the time of 1000 integrations of the descriptor (default GCFD3):
+ *   - generic: DescriptorBatch_::integrate with the CircleTable of the size;
+ *   - fixed: the FixedSizeKernel_ of the size, used by DescriptorExtractor_.
+ * The largest relative difference between both descriptors is printed and the program fails
+ * if it is above 1e-12.
+ */
+
+#include <iostream>
+#include <cstdlib>
+#include <cmath>
+#include <cstring>
+#include <opencv/cv.h>
+#include "../FixedSizeKernel.h"
+#include "../DescriptorBatch.h"
+#include "../CircleTableCache.h"
+#include "../MyTools.h"
+#include "BenchCheck.h"
+
+using namespace cv;
+
+int main(int argc,char** argv){
+	DescriptorType type=GCFD3_DESCRIPTOR;
+	if(argc>1 && strcmp(argv[1],"gfd1")==0)
+		type=GFD1_DESCRIPTOR;
+	if(argc>1 && strcmp(argv[1],"gcfd1")==0)
+		type=GCFD1_DESCRIPTOR;
+	const int sizes[]={64,128,256};
+	const int nbRuns=1000;
+	Mat Biv=(Mat_<double>(1,3) << 1,0,0);
+	RNG rng(0);
+	BenchCheck check;
+
+	std::cout<<"size\tgeneric us\tfixed us\tspeedup\tmax diff"<<std::endl;
+	for(int s=0;s<3;s++){
+		Mat im(sizes[s],sizes[s],CV_8UC3);
+		rng.fill(im,RNG::UNIFORM,0,256);
+		Mat X=CFTPlan::cropToOddSize(im);
+		CFTPlan plan(X.rows,X.cols,Biv);
+		Mat par,orth;
+		DescriptorBatch::transform(type,plan,X,par,orth);
+		Ptr<const CircleTable> table=CircleTableCache::get(X.size());
+		Ptr<FixedSizeKernelBase_<double> > kernel=FixedSizeKernelBase_<double>::create(*table);
+		const int D=DescriptorBatch::getDescriptorSize(type,X.size());
+		vector<double> generic(D),fixed(D);
+
+		int64 start=getTickCount();
+		for(int r=0;r<nbRuns;r++)
+			DescriptorBatch::integrate(type,*table,par,orth,&generic[0]);
+		double tGeneric=(getTickCount()-start)/getTickFrequency();
+
+		start=getTickCount();
+		for(int r=0;r<nbRuns;r++)
+			kernel->integrate(type,par,orth,&fixed[0]);
+		double tFixed=(getTickCount()-start)/getTickFrequency();
+
+		double diff=BenchCheck::relativeDiff(Mat(fixed),Mat(generic));
+		std::cout<<sizes[s]<<"\t"<<1e6*tGeneric/nbRuns<<"\t"<<1e6*tFixed/nbRuns<<"\t"<<tGeneric/tFixed<<"\t"<<diff<<std::endl;
+		check.expect("fixed vs generic "+MyTools::Int2Str(sizes[s]),diff,1e-12);
+	}
+	return check.getExitCode();
+}
@@ -0,0 +1,155 @@
+/**
+ * \file benchMatArena.cpp
+ * \brief Benchmark of the arena of the spectra against heap temporaries with several threads
+ * \version 1.0
+ * \date October 17, 2026
+ *
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the distribution
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Usage: benchMatArena [nbImages [size]]
+ *
+ * Computes the GCFD3 descriptors of random images (default 4000 images of 127x127) with 1, 2,
+ * 4... threads up to the number of CPUs, as the constructors of the descriptors taking a plan:
+ *   - heap: the spectra are new Mat for each image (cv::fastMalloc and cv::fastFree);
+ *   - arena: the spectra are taken from the MatArena of the thread;
+ *   - batch: DescriptorBatch, whose extractors keep their buffers from one image to the next
+ *     and do not use the arena.
+ * Prints the throughput of the three, the speedup of the arena and of the batch over the heap,
+ * and the number of Mat served by the arenas against the number of chunks they have allocated
+ * on the heap. The program fails if the heap and the arena do not give exactly the same
+ * descriptors, or if the batch does not give the same descriptors up to the rounding errors.
+ */
+
+#include <iostream>
+#include <cstdlib>
+#include <opencv/cv.h>
+#include "../MatArena.h"
+#include "../CFTPlan.h"
+#include "../CircleTableCache.h"
+#include "../DescriptorBatch.h"
+#include "BenchCheck.h"
+
+using namespace cv;
+
+/*! \class ArenaBody
+   * \brief One stripe of images per thread, with its own plan
+   */
+class ArenaBody : public ParallelLoopBody {
+private:
+	const vector<Mat>* images;		/*!< The images */
+	const Mat* Biv;					/*!< The color vector */
+	const CircleTable* table;		/*!< The circles */
+	bool useArena;					/*!< Take the spectra from the arena */
+	Mat* res;						/*!< The descriptors */
+	MatArenaStats* stats;			/*!< The counters of the arenas, summed over the stripes */
+	Mutex* statsMutex;				/*!< Protect stats */
+public:
+	ArenaBody(const vector<Mat>* images,const Mat* Biv,const CircleTable* table,const bool& useArena,Mat* res,MatArenaStats* stats,Mutex* statsMutex)
+		: images(images), Biv(Biv), table(table), useArena(useArena), res(res), stats(stats), statsMutex(statsMutex) {
+	}
+	virtual void operator()(const Range& range) const{
+		const Mat& first=(*images)[range.start];
+		CFTPlan plan(first.rows,first.cols,*Biv);
+		MatArena& arena=MatArena::getThreadArena();
+		MatArenaStats before=arena.getStats();
+		for(int i=range.start;i<range.end;i++){
+			const Mat& im=(*images)[i];
+			if(useArena){
+				MatArenaScope scope(arena);
+				Mat par=scope.create(im.rows,im.cols,CV_64FC1);
+				Mat orth=scope.create(im.rows,im.cols,CV_64FC2);
+				plan.executePacked(im,par,orth);
+				table->integrateCCS(par,orth,res->ptr<double>(i));
+			}
+			else{
+				Mat par,orth;
+				plan.executePacked(im,par,orth);
+				table->integrateCCS(par,orth,res->ptr<double>(i));
+			}
+		}
+		MatArenaStats after=arena.getStats();
+		AutoLock lock(*statsMutex);
+		stats->allocations+=after.allocations-before.allocations;
+		stats->chunkAllocations+=after.chunkAllocations-before.chunkAllocations;
+	}
+};
+
+/*!
+ *  \brief Compute the descriptors of all the images and return the throughput
+ */
+static double run(const vector<Mat>& images,const Mat& Biv,const CircleTable& table,const bool& useArena,const int& nbThreads,Mat& res,MatArenaStats& stats){
+	Mutex statsMutex;
+	stats.allocations=0;
+	stats.chunkAllocations=0;
+	int64 start=getTickCount();
+	parallel_for_(Range(0,(int)images.size()),ArenaBody(&images,&Biv,&table,useArena,&res,&stats,&statsMutex),nbThreads);
+	return images.size()/((getTickCount()-start)/getTickFrequency());
+}
+
+/*!
+ *  \brief Compute the descriptors of all the images with a DescriptorBatch and return the throughput
+ */
+static double runBatch(const vector<Mat>& images,const Mat& Biv,Mat& res){
+	int64 start=getTickCount();
+	DescriptorBatch batch(GCFD3_DESCRIPTOR,Biv);
+	res=batch.compute(images);
+	return images.size()/((getTickCount()-start)/getTickFrequency());
+}
+
+int main(int argc,char** argv){
+	int nbImages=argc>1 ? atoi(argv[1]) : 4000;
+	int size=argc>2 ? atoi(argv[2]) : 127;
+	size-=size%2==0;
+
+	RNG rng(0);
+	vector<Mat> images(nbImages);
+	for(int i=0;i<nbImages;i++){
+		images[i].create(size,size,CV_8UC3);
+		rng.fill(images[i],RNG::UNIFORM,0,256);
+	}
+	Mat Biv=(Mat_<double>(1,3) << 1,0,0);
+	Ptr<const CircleTable> table=CircleTableCache::get(size/2);
+	Mat heap(nbImages,size/2+1,CV_64F),arena(nbImages,size/2+1,CV_64F),batch;
+
+	int nbCPUs=getNumberOfCPUs();
+	std::cout<<"threads\theap images/s\tarena images/s\tspeedup\tbatch images/s\tspeedup\tarena Mat\tarena chunks"<<std::endl;
+	for(int nbThreads=1;;nbThreads=std::min(2*nbThreads,nbCPUs)){
+		setNumThreads(nbThreads);
+		MatArenaStats stats;
+		double tHeap=run(images,Biv,*table,false,nbThreads,heap,stats);
+		double tArena=run(images,Biv,*table,true,nbThreads,arena,stats);
+		double tBatch=runBatch(images,Biv,batch);
+		std::cout<<nbThreads<<"\t"<<tHeap<<"\t"<<tArena<<"\t"<<tArena/tHeap<<"\t"<<tBatch<<"\t"<<tBatch/tHeap<<"\t"<<stats.allocations<<"\t"<<stats.chunkAllocations<<std::endl;
+		if(nbThreads==nbCPUs)
+			break;
+	}
+	double diff=norm(heap,arena,NORM_INF);
+	std::cout<<"max diff "<<diff<<std::endl;
+	BenchCheck check;
+	check.expect("arena vs heap",diff,0.);
+	check.expect("batch vs heap",BenchCheck::relativeDiff(batch,heap),1e-9);
+	return check.getExitCode();
+}
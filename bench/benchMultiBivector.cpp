@@ -0,0 +1,89 @@
+/**
+ * \file benchMultiBivector.cpp
+ * \brief Descriptors of several bivectors: one DescriptorBatch per bivector against MultiBivectorDescriptors
+ * \version 1.0
+ * \date October 17, 2026
+ *
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the distribution
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Usage: benchMultiBivector [size [nbImages]]
+ *
+ * Computes the GCFD1 of random color images for 1 to 8 bivectors, first with one
+ * DescriptorBatch per bivector, then with one MultiBivectorDescriptors, and prints the time
+ * per image of both and the largest relative difference between their descriptors. The
+ * program fails if it is above 1e-9.
+ */
+
+#include <iostream>
+#include <cstdlib>
+#include <cmath>
+#include <opencv/cv.h>
+#include "../MultiBivectorCFT.h"
+#include "BenchCheck.h"
+
+using namespace cv;
+
+int main(int argc,char** argv){
+	int size=argc>1 ? atoi(argv[1]) : 127;
+	int nbImages=argc>2 ? atoi(argv[2]) : 200;
+
+	RNG rng(0);
+	vector<Mat> images(nbImages);
+	for(int i=0;i<nbImages;i++){
+		images[i].create(size,size,CV_8UC3);
+		rng.fill(images[i],RNG::UNIFORM,0,256);
+	}
+	BenchCheck check;
+
+	std::cout<<"bivectors\tbatches ms/img\tmulti ms/img\tmax diff"<<std::endl;
+	for(int nbBiv=1;nbBiv<=8;nbBiv*=2){
+		vector<Mat> Bivs(nbBiv);
+		for(int k=0;k<nbBiv;k++){
+			Bivs[k].create(1,3,CV_64F);
+			rng.fill(Bivs[k],RNG::UNIFORM,0.1,1);
+		}
+
+		int64 start=getTickCount();
+		vector<Mat> single(nbBiv);
+		for(int k=0;k<nbBiv;k++){
+			DescriptorBatch batch(GCFD1_DESCRIPTOR,Bivs[k]);
+			single[k]=batch.compute(images);
+		}
+		double tSingle=(getTickCount()-start)/getTickFrequency();
+
+		start=getTickCount();
+		MultiBivectorDescriptors multi(GCFD1_DESCRIPTOR,Bivs);
+		vector<Mat> res=multi.compute(images);
+		double tMulti=(getTickCount()-start)/getTickFrequency();
+
+		double diff=0;
+		for(int k=0;k<nbBiv;k++)
+			diff=std::max(diff,BenchCheck::relativeDiff(res[k],single[k]));
+		std::cout<<nbBiv<<"\t"<<1000*tSingle/nbImages<<"\t"<<1000*tMulti/nbImages<<"\t"<<diff<<std::endl;
+		check.expect("multi vs batches with "+MyTools::Int2Str(nbBiv)+" bivector(s)",diff,1e-9);
+	}
+	return check.getExitCode();
+}
@@ -0,0 +1,142 @@
+/**
+ * \file benchMultiScale.cpp
+ * \brief Pyramid descriptors from one CFT against resize and recompute
+ * \version 1.0
+ * \date October 17, 2026
+ *
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the distribution
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Usage: benchMultiScale [width height [nbScales [gfd1|gcfd1|gcfd3]]]
+ *
+ * Computes the pyramid descriptors (scale factor 0.5) of 50 random smooth images in three
+ * ways and prints their time per image:
+ *   - legacy: cv::resize of the image to each scale and legacy descriptor (with the circles
+ *     computed beforehand), as done before MultiScaleDescriptors;
+ *   - extractor: cv::resize and one DescriptorExtractor per scale;
+ *   - multiscale: MultiScaleDescriptors, one CFT at the base level.
+ * The largest difference between the multiscale and the extractor descriptors is printed for
+ * each scale, without the energy at the null frequency: it comes from the filter of cv::resize
+ * (INTER_AREA), which is not the ideal low-pass filter of the crop of the spectrum.
+ * The program fails if a relative difference between the extractor and the legacy
+ * descriptors, or between the multiscale and the extractor descriptors of the base level, is
+ * above 1e-9.
+ */
+
+#include <iostream>
+#include <cstdlib>
+#include <cmath>
+#include <cstring>
+#include <opencv/cv.h>
+#include "../MultiScaleDescriptors.h"
+#include "BenchCheck.h"
+#include "BenchLegacy.h"
+
+using namespace cv;
+
+int main(int argc,char** argv){
+	int width=argc>2 ? atoi(argv[1]) : 256;
+	int height=argc>2 ? atoi(argv[2]) : 256;
+	int nbScales=argc>3 ? atoi(argv[3]) : 3;
+	DescriptorType type=GCFD3_DESCRIPTOR;
+	if(argc>4 && strcmp(argv[4],"gfd1")==0)
+		type=GFD1_DESCRIPTOR;
+	if(argc>4 && strcmp(argv[4],"gcfd1")==0)
+		type=GCFD1_DESCRIPTOR;
+	const int nbImages=50;
+
+	RNG rng(0);
+	vector<Mat> images(nbImages);
+	for(int i=0;i<nbImages;i++){
+		images[i].create(height,width,CV_8UC3);
+		rng.fill(images[i],RNG::UNIFORM,0,256);
+		GaussianBlur(images[i],images[i],Size(0,0),2);
+	}
+	Mat Biv=(Mat_<double>(1,3) << 1,0,0);
+	MultiScaleDescriptors multiScale(type,Biv,Size(width,height),nbScales);
+	const int D=multiScale.getDescriptorSize();
+	vector<Size> sizes(nbScales);
+	vector<vector<Mat> > Dcircles(nbScales);
+	vector<Ptr<DescriptorExtractor> > extractors(nbScales);
+	for(int k=0;k<nbScales;k++){
+		double f=std::pow(0.5,k);
+		sizes[k]=Size(cvRound(width*f),cvRound(height*f));
+		Dcircles[k]=MyTools::computeDiscreteCircles(std::min(multiScale.getScaleSize(k).width,multiScale.getScaleSize(k).height)/2);
+		extractors[k]=new DescriptorExtractor(type,Biv,sizes[k]);
+	}
+
+	Mat legacy(nbImages,D,CV_64F),naive(nbImages,D,CV_64F),fast(nbImages,D,CV_64F);
+	int64 start=getTickCount();
+	for(int i=0;i<nbImages;i++){
+		for(int k=0;k<nbScales;k++){
+			Mat small=images[i];
+			if(k>0)
+				resize(images[i],small,sizes[k],0,0,INTER_AREA);
+			vector<double> d=legacyDescriptor(type,small,Biv,Dcircles[k]);
+			std::copy(d.begin(),d.end(),legacy.ptr<double>(i)+multiScale.getScaleOffset(k));
+		}
+	}
+	double tLegacy=(getTickCount()-start)/getTickFrequency();
+
+	start=getTickCount();
+	for(int i=0;i<nbImages;i++){
+		for(int k=0;k<nbScales;k++){
+			Mat small=images[i];
+			if(k>0)
+				resize(images[i],small,sizes[k],0,0,INTER_AREA);
+			extractors[k]->extract(small,naive.ptr<double>(i)+multiScale.getScaleOffset(k));
+		}
+	}
+	double tNaive=(getTickCount()-start)/getTickFrequency();
+
+	start=getTickCount();
+	for(int i=0;i<nbImages;i++)
+		multiScale.extract(images[i],fast.ptr<double>(i));
+	double tFast=(getTickCount()-start)/getTickFrequency();
+
+	std::cout<<"size "<<width<<"x"<<height<<", "<<nbScales<<" scales, "<<D<<" values"<<std::endl;
+	std::cout<<"legacy ms/image\textractor ms/image\tmultiscale ms/image\tspeedup"<<std::endl;
+	std::cout<<1000*tLegacy/nbImages<<"\t"<<1000*tNaive/nbImages<<"\t"<<1000*tFast/nbImages<<"\t"<<tNaive/tFast<<std::endl;
+	std::cout<<"scale\tsize\tmax diff"<<std::endl;
+	BenchCheck check;
+	for(int k=0;k<nbScales;k++){
+		int first=multiScale.getScaleOffset(k);
+		int end=k+1<nbScales ? multiScale.getScaleOffset(k+1) : D;
+		int n=(end-first)/(type==GCFD1_DESCRIPTOR ? 2 : 1);
+		double diff=0,baseDiff=0,legacyDiff=0;
+		for(int i=0;i<nbImages;i++){
+			for(int j=first;j<end;j++)
+				if((j-first)%n!=0)
+					diff=std::max(diff,std::abs(fast.at<double>(i,j)-naive.at<double>(i,j)));
+			baseDiff=std::max(baseDiff,BenchCheck::relativeDiff(fast.row(i).colRange(first,end),naive.row(i).colRange(first,end)));
+			legacyDiff=std::max(legacyDiff,BenchCheck::relativeDiff(naive.row(i).colRange(first,end),legacy.row(i).colRange(first,end)));
+		}
+		std::cout<<k<<"\t"<<multiScale.getScaleSize(k).width<<"x"<<multiScale.getScaleSize(k).height<<"\t"<<diff<<std::endl;
+		check.expect("extractor vs legacy at scale "+MyTools::Int2Str(k),legacyDiff,1e-9);
+		if(k==0)
+			check.expect("multiscale vs extractor at the base level",baseDiff,1e-9);
+	}
+	return check.getExitCode();
+}
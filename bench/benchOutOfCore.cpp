@@ -0,0 +1,121 @@
+/**
+ * \file benchOutOfCore.cpp
+ * \brief Benchmark of the out of core CFT against the in-memory one
+ * \version 1.0
+ * \date October 17, 2026
+ *
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the distribution
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Usage: benchOutOfCore [width height [budgetMB [dir]]]
+ *
+ * Writes a random smooth image of width x height (default 4096x4096) in a file mapped in dir
+ * (default /tmp), then computes its CFT in double and prints the time of:
+ *   - memory: CFTPlan on the image loaded in memory;
+ *   - outofcore: OutOfCoreCFT from the mapped image to mapped spectra, with a budget of
+ *     budgetMB (default 64) for the columns;
+ *   - inverse and filter: the inverse CFT and a band pass filter, out of core.
+ * The largest difference between both spectra, relative to the largest magnitude of the
+ * spectra, and the error of the inverse are printed. The program fails if the difference is
+ * above 1e-9 or if the inverse does not give back the image. The mapped files are removed at
+ * the end.
+ */
+
+#include <iostream>
+#include <cstdlib>
+#include <cstdio>
+#include <opencv/cv.h>
+#include "../OutOfCoreCFT.h"
+#include "../CFTPlan.h"
+#include "BenchCheck.h"
+
+using namespace cv;
+
+int main(int argc,char** argv){
+	int width=argc>2 ? atoi(argv[1]) : 4096;
+	int height=argc>2 ? atoi(argv[2]) : 4096;
+	size_t budget=(size_t)(argc>3 ? atoi(argv[3]) : 64)<<20;
+	string dir=argc>4 ? argv[4] : "/tmp";
+	string imagePath=dir+"/benchOutOfCore.image";
+	string spectraPath=dir+"/benchOutOfCore.spectra";
+
+	MappedMat image;
+	image.create(imagePath,height,width,CV_8UC3);
+	Mat im=image.getMat();
+	RNG rng(0);
+	rng.fill(im,RNG::UNIFORM,0,256);
+	GaussianBlur(im,im,Size(0,0),2);
+	image.flush();
+
+	Mat Biv=(Mat_<double>(1,3) << 1,0,0);
+	OutOfCoreConfig config;
+	config.memoryBudget=budget;
+	config.tempDir=dir;
+	OutOfCoreCFT outOfCore(height,width,Biv,config);
+	std::cout<<"size "<<width<<"x"<<height<<", budget "<<(budget>>20)<<" MB, "<<outOfCore.getBlockCols()<<" columns per block, "
+		<<(outOfCore.getTemporarySize()>>20)<<" MB of spectra"<<std::endl;
+
+	int64 start=getTickCount();
+	CFTPlan plan(height,width,Biv);
+	Mat par,orth;
+	plan.execute(im.clone(),par,orth);
+	double tMemory=(getTickCount()-start)/getTickFrequency();
+
+	MappedMat spectra;
+	spectra.create(spectraPath,2*height,width,CV_64FC2);
+	Mat mappedPar=spectra.getMat().rowRange(0,height);
+	Mat mappedOrth=spectra.getMat().rowRange(height,2*height);
+	start=getTickCount();
+	outOfCore.forward(im,mappedPar,mappedOrth);
+	double tForward=(getTickCount()-start)/getTickFrequency();
+
+	double diff=std::max(norm(par,mappedPar,NORM_INF),norm(orth,mappedOrth,NORM_INF))/std::max(norm(par,NORM_INF),norm(orth,NORM_INF));
+	par.release();
+	orth.release();
+
+	Mat back;
+	start=getTickCount();
+	outOfCore.inverse(mappedPar,mappedOrth,back);
+	double tInverse=(getTickCount()-start)/getTickFrequency();
+	double error=norm(back,im,NORM_INF);
+
+	Mat filtered;
+	start=getTickCount();
+	outOfCore.filter(im,filtered,RadialBandMask(0.05,0.25));
+	double tFilter=(getTickCount()-start)/getTickFrequency();
+
+	std::cout<<"memory s\toutofcore s\tinverse s\tfilter s"<<std::endl;
+	std::cout<<tMemory<<"\t"<<tForward<<"\t"<<tInverse<<"\t"<<tFilter<<std::endl;
+	std::cout<<"max diff of the spectra "<<diff<<", max error of the inverse "<<error<<std::endl;
+	BenchCheck check;
+	check.expect("outofcore vs memory spectra",diff,1e-9);
+	check.expect("inverse vs image",error,0.);
+
+	spectra.close();
+	image.close();
+	remove(spectraPath.c_str());
+	remove(imagePath.c_str());
+	return check.getExitCode();
+}
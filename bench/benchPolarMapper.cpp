@@ -0,0 +1,95 @@
+/**
+ * \file benchPolarMapper.cpp
+ * \brief Speed and equality of PolarMapper against MyTools::imCart2Pol and colImCart2Pol
+ * \version 1.0
+ * \date October 17, 2026
+ *
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the distribution
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Usage: benchPolarMapper [size [nbImages]]
+ *
+ * Converts random gray level and color images to polar images with the legacy functions of
+ * MyTools and with PolarMapper, for both methods, and prints the time per image of both and
+ * the largest difference between their outputs. The program fails if the outputs are not the
+ * same.
+ */
+
+#include <iostream>
+#include <cstdlib>
+#include <opencv/cv.h>
+#include "../MyTools.h"
+#include "../PolarMapper.h"
+#include "BenchCheck.h"
+
+using namespace cv;
+
+int main(int argc,char** argv){
+	int size=argc>1 ? atoi(argv[1]) : 127;
+	int nbImages=argc>2 ? atoi(argv[2]) : 200;
+
+	RNG rng(0);
+	vector<Mat> gray(nbImages),color(nbImages);
+	for(int i=0;i<nbImages;i++){
+		gray[i].create(size,size+6,CV_8UC1);
+		color[i].create(size,size+6,CV_8UC3);
+		rng.fill(gray[i],RNG::UNIFORM,0,256);
+		rng.fill(color[i],RNG::UNIFORM,0,256);
+	}
+
+	const char* methods[2]={"full","crop"};
+	BenchCheck check;
+	std::cout<<"image\tmethod\tlegacy ms/img\tmapper ms/img\tmax diff"<<std::endl;
+	for(int m=0;m<2;m++){
+		for(int c=0;c<2;c++){
+			const vector<Mat>& images=c==0 ? gray : color;
+			vector<Mat> legacy(nbImages),polar(nbImages);
+			int64 start=getTickCount();
+			for(int i=0;i<nbImages;i++)
+				legacy[i]=c==0 ? MyTools::imCart2Pol(images[i],methods[m]) : MyTools::colImCart2Pol(images[i],methods[m]);
+			double tLegacy=(getTickCount()-start)/getTickFrequency();
+
+			start=getTickCount();
+			PolarMapper mapper(images[0].size(),PolarMapper::parseMethod(methods[m]));
+			for(int i=0;i<nbImages;i++)
+				mapper.apply(images[i],polar[i]);
+			double tMapper=(getTickCount()-start)/getTickFrequency();
+
+			string name=string(c==0 ? "gray" : "color")+" "+methods[m];
+			double diff=0;
+			bool sameFormat=true;
+			for(int i=0;i<nbImages && sameFormat;i++){
+				sameFormat=legacy[i].size()==polar[i].size() && legacy[i].type()==polar[i].type();
+				if(sameFormat)
+					diff=std::max(diff,norm(legacy[i],polar[i],NORM_INF));
+			}
+			check.expect(name+": size and type of the polar images",sameFormat);
+			std::cout<<(c==0 ? "gray" : "color")<<"\t"<<methods[m]<<"\t"<<1000*tLegacy/nbImages<<"\t"
+					<<1000*tMapper/nbImages<<"\t"<<diff<<std::endl;
+			check.expect(name+": mapper vs legacy",diff,0.);
+		}
+	}
+	return check.getExitCode();
+}
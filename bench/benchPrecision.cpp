@@ -0,0 +1,126 @@
+/**
+ * \file benchPrecision.cpp
+ * \brief Accuracy and throughput of the float descriptors against the double ones
+ * \version 1.0
+ * \date October 17, 2026
+ *
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the distribution
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Usage: benchPrecision [nbImages [size]]
+ *
+ * Computes the GFD1, GCFD1 and GCFD3 of random images with DescriptorBatch (double) and
+ * DescriptorBatchf (float) and prints, for each descriptor, the throughput of both, the
+ * maximum and mean relative error of the float descriptors, and the fraction of queries
+ * whose nearest neighbour (L2) is the same with both precisions. The program fails if the mean
+ * relative error is above 1e-4 or if less than 99% of the nearest neighbours are the same (the
+ * maximum relative error is not checked, it comes from the values close to 0).
+ */
+
+#include <iostream>
+#include <cstdlib>
+#include <cmath>
+#include <opencv/cv.h>
+#include "../DescriptorBatch.h"
+#include "BenchCheck.h"
+
+using namespace cv;
+
+/*!
+ *  \brief Compute the descriptors of a set of images and measure the throughput
+ */
+template<typename T> Mat run(const DescriptorType& type,const Mat& Biv,const vector<Mat>& images,double& throughput){
+	DescriptorBatch_<T> batch(type,Biv);
+	batch.compute(vector<Mat>(images.begin(),images.begin()+1));
+	int64 start=getTickCount();
+	Mat res=batch.compute(images);
+	throughput=images.size()/((getTickCount()-start)/getTickFrequency());
+	Mat res64;
+	res.convertTo(res64,CV_64F);
+	return res64;
+}
+
+/*!
+ *  \brief Index of the nearest neighbour (other than itself) of each row
+ */
+static vector<int> nearestNeighbours(const Mat& D){
+	vector<int> nn(D.rows,-1);
+	for(int i=0;i<D.rows;i++){
+		double best=0;
+		for(int j=0;j<D.rows;j++){
+			if(j==i)
+				continue;
+			double d=norm(D.row(i)-D.row(j));
+			if(nn[i]<0 || d<best){
+				best=d;
+				nn[i]=j;
+			}
+		}
+	}
+	return nn;
+}
+
+int main(int argc,char** argv){
+	int nbImages=argc>1 ? atoi(argv[1]) : 500;
+	int size=argc>2 ? atoi(argv[2]) : 63;
+
+	RNG rng(0);
+	vector<Mat> images(nbImages);
+	for(int i=0;i<nbImages;i++){
+		// Smooth random images, closer to natural images than white noise
+		Mat small(size/8+1,size/8+1,CV_8UC3);
+		rng.fill(small,RNG::UNIFORM,0,256);
+		resize(small,images[i],Size(size,size),0,0,INTER_CUBIC);
+	}
+	Mat Biv=(Mat_<double>(1,3) << 1,0,0);
+
+	const char* names[3]={"GFD1","GCFD1","GCFD3"};
+	BenchCheck check;
+	std::cout<<"descriptor\tdouble img/s\tfloat img/s\tspeedup\tmax rel err\tmean rel err\tsame NN"<<std::endl;
+	for(int t=0;t<3;t++){
+		double tDouble,tFloat;
+		Mat D=run<double>((DescriptorType)t,Biv,images,tDouble);
+		Mat F=run<float>((DescriptorType)t,Biv,images,tFloat);
+		double maxErr=0,meanErr=0;
+		for(int i=0;i<D.rows;i++){
+			for(int k=0;k<D.cols;k++){
+				double ref=std::fabs(D.at<double>(i,k));
+				double err=ref>0 ? std::fabs(F.at<double>(i,k)-D.at<double>(i,k))/ref : 0;
+				maxErr=std::max(maxErr,err);
+				meanErr+=err;
+			}
+		}
+		meanErr/=D.total();
+		vector<int> nnD=nearestNeighbours(D),nnF=nearestNeighbours(F);
+		int same=0;
+		for(int i=0;i<D.rows;i++)
+			same+=nnD[i]==nnF[i];
+		std::cout<<names[t]<<"\t"<<tDouble<<"\t"<<tFloat<<"\t"<<tFloat/tDouble<<"\t"
+				<<maxErr<<"\t"<<meanErr<<"\t"<<(double)same/D.rows<<std::endl;
+		check.expect(string(names[t])+" mean relative error of float",meanErr,1e-4);
+		check.expect(string(names[t])+" nearest neighbours not found with float",1-(double)same/D.rows,0.01);
+	}
+	return check.getExitCode();
+}
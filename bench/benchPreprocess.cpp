@@ -0,0 +1,137 @@
+/**
+ * \file benchPreprocess.cpp
+ * \brief Benchmark of the fused color preprocessing against the legacy passes
+ * \version 1.0
+ * \date October 17, 2026
+ *
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the distribution
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Usage: benchPreprocess [width height [nbImages]]
+ *
+ * Converts random BGR images to the parallel and orthogonal parts of the CFT and prints the
+ * time per image of:
+ *   - legacy: MyTools::reorderColorChannel, convertTo double and division by 255, then one
+ *     MyTools::projImOnVec per vector of the basis, each step being a pass on the image;
+ *   - the fused ColorPreprocessor for an interleaved uchar image, its planes (cv::split), a
+ *     float image and a gray image, in double and in float.
+ * The largest difference between the parts of the planar, float and interleaved images, and
+ * with the legacy parts of the last image, is printed. The program fails if the planar parts
+ * are not the same as the interleaved ones, or if the others differ by more than 1e-12.
+ */
+
+#include <iostream>
+#include <cstdlib>
+#include <opencv/cv.h>
+#include "../MyTools.h"
+#include "../CFTPlan.h"
+#include "../ColorPreprocessor.h"
+#include "BenchCheck.h"
+
+using namespace cv;
+
+template<typename T> static double timeProject(const ColorPreprocessor_<T>& preprocessor,const vector<Mat>& images,const bool& planar,Mat& par,Mat& orth){
+	Mat buffer;
+	vector<Mat> planes;
+	const int nbImages=(int)images.size();
+	double t=0;
+	for(int i=0;i<nbImages;i++){
+		if(planar)
+			split(images[i],planes);
+		int64 start=getTickCount();
+		if(planar)
+			preprocessor.project(planes,par,&orth,buffer);
+		else
+			preprocessor.project(images[i],par,&orth,buffer);
+		t+=(getTickCount()-start)/getTickFrequency();
+	}
+	return 1000*t/nbImages;
+}
+
+int main(int argc,char** argv){
+	int width=argc>2 ? atoi(argv[1]) : 512;
+	int height=argc>2 ? atoi(argv[2]) : 512;
+	int nbImages=argc>3 ? atoi(argv[3]) : 50;
+
+	RNG rng(0);
+	vector<Mat> images(nbImages),floatImages(nbImages),grayImages(nbImages);
+	for(int i=0;i<nbImages;i++){
+		images[i].create(height,width,CV_8UC3);
+		rng.fill(images[i],RNG::UNIFORM,0,256);
+		images[i].convertTo(floatImages[i],CV_32F);
+		grayImages[i].create(height,width,CV_8UC1);
+		rng.fill(grayImages[i],RNG::UNIFORM,0,256);
+	}
+	Mat Biv=(Mat_<double>(1,3) << 1,0,0);
+	double Cn[3],Vn[3],Wn[3];
+	CFTPlan::getBasis(Biv,Cn,Vn,Wn);
+	Mat vecs[3]={Mat(1,3,CV_64F,Cn),Mat(1,3,CV_64F,Vn),Mat(1,3,CV_64F,Wn)};
+
+	Mat parts[3];
+	int64 start=getTickCount();
+	for(int i=0;i<nbImages;i++){
+		Mat im=images[i].clone();
+		MyTools::reorderColorChannel(im);
+		Mat x;
+		im.convertTo(x,CV_64F,1/255.);
+		for(int k=0;k<3;k++)
+			parts[k]=MyTools::projImOnVec(x,vecs[k]);
+	}
+	double tLegacy=1000*(getTickCount()-start)/getTickFrequency()/nbImages;
+	// The legacy parts of the last image, as the complex parts of ColorPreprocessor
+	Mat legacyPar,legacyOrth;
+	for(int k=0;k<3;k++)
+		parts[k].convertTo(parts[k],CV_64F);
+	Mat parPlanes[2]={parts[0],Mat::zeros(height,width,CV_64F)};
+	merge(parPlanes,2,legacyPar);
+	merge(parts+1,2,legacyOrth);
+
+	ColorPreprocessor preprocessor(Biv);
+	ColorPreprocessorf preprocessorf(Biv);
+	Mat par(height,width,CV_64FC2),orth(height,width,CV_64FC2);
+	Mat parf(height,width,CV_32FC2),orthf(height,width,CV_32FC2);
+	Mat refPar,refOrth;
+	double tInterleaved=timeProject(preprocessor,images,false,par,orth);
+	par.copyTo(refPar);
+	orth.copyTo(refOrth);
+	double diffLegacy=std::max(norm(legacyPar,refPar,NORM_INF),norm(legacyOrth,refOrth,NORM_INF));
+	double tPlanar=timeProject(preprocessor,images,true,par,orth);
+	double diffPlanar=std::max(norm(par,refPar,NORM_INF),norm(orth,refOrth,NORM_INF));
+	double tFloat=timeProject(preprocessor,floatImages,false,par,orth);
+	double diffFloat=std::max(norm(par,refPar,NORM_INF),norm(orth,refOrth,NORM_INF));
+	double tGray=timeProject(preprocessor,grayImages,false,par,orth);
+	double tInterleavedf=timeProject(preprocessorf,images,false,parf,orthf);
+	double tFloatf=timeProject(preprocessorf,floatImages,false,parf,orthf);
+
+	std::cout<<"size "<<width<<"x"<<height<<", "<<nbImages<<" images, ms/image"<<std::endl;
+	std::cout<<"legacy\tuchar\tplanar\tfloat\tgray\tuchar (float)\tfloat (float)\tspeedup"<<std::endl;
+	std::cout<<tLegacy<<"\t"<<tInterleaved<<"\t"<<tPlanar<<"\t"<<tFloat<<"\t"<<tGray<<"\t"<<tInterleavedf<<"\t"<<tFloatf<<"\t"<<tLegacy/tInterleaved<<std::endl;
+	std::cout<<"max diff planar "<<diffPlanar<<", float "<<diffFloat<<", legacy "<<diffLegacy<<std::endl;
+	BenchCheck check;
+	check.expect("planar vs interleaved",diffPlanar,0.);
+	check.expect("float vs interleaved",diffFloat,1e-12);
+	check.expect("interleaved vs legacy",diffLegacy,1e-12);
+	return check.getExitCode();
+}
@@ -0,0 +1,136 @@
+/**
+ * \file benchRotation.cpp
+ * \brief Benchmark of the batched rotation augmentation against the legacy rotations
+ * \version 1.0
+ * \date October 17, 2026
+ *
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the distribution
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Usage: benchRotation [width height [nbAngles [gfd1|gcfd1|gcfd3]]]
+ *
+ * Computes the descriptors of 20 random smooth images rotated by nbAngles angles regularly
+ * spaced in [0,360[ (square frame of MyTools::rotateColIm) in two ways and prints their time
+ * per rotated image:
+ *   - legacy: MyTools::rotateColIm and legacy descriptor (with the circles computed
+ *     beforehand), one pair after the other;
+ *   - augmenter: RotationAugmenter, precomputed maps and parallel (image,angle) pairs.
+ * The largest difference between the two descriptors, relative to the largest value of the
+ * descriptors, is printed, then the drift of the descriptors for each angle (see RotationDrift).
+ * The program fails if a rotated image differs from the one of rotateColIm by more than one
+ * gray level, or if the relative difference of the descriptors is above 1e-2.
+ */
+
+#include <iostream>
+#include <cstdlib>
+#include <cmath>
+#include <cstring>
+#include <opencv/cv.h>
+#include "../RotationAugmenter.h"
+#include "BenchCheck.h"
+#include "BenchLegacy.h"
+
+using namespace cv;
+
+int main(int argc,char** argv){
+	int width=argc>2 ? atoi(argv[1]) : 128;
+	int height=argc>2 ? atoi(argv[2]) : 128;
+	int nbAngles=argc>3 ? atoi(argv[3]) : 12;
+	DescriptorType type=GCFD3_DESCRIPTOR;
+	if(argc>4 && strcmp(argv[4],"gfd1")==0)
+		type=GFD1_DESCRIPTOR;
+	if(argc>4 && strcmp(argv[4],"gcfd1")==0)
+		type=GCFD1_DESCRIPTOR;
+	const int nbImages=20;
+
+	RNG rng(0);
+	vector<Mat> images(nbImages);
+	for(int i=0;i<nbImages;i++){
+		images[i].create(height,width,CV_8UC3);
+		rng.fill(images[i],RNG::UNIFORM,0,256);
+		GaussianBlur(images[i],images[i],Size(0,0),2);
+	}
+	vector<double> angles(nbAngles);
+	for(int a=0;a<nbAngles;a++)
+		angles[a]=360.*a/nbAngles;
+	Mat Biv=(Mat_<double>(1,3) << 1,0,0);
+	RotationAugmenter augmenter(type,Biv,Size(width,height),angles,ROTATION_SQUARE);
+	const int D=augmenter.getDescriptorSize();
+	const Size rotatedSize=augmenter.getRotatedSize();
+	vector<Mat> Dcircles=MyTools::computeDiscreteCircles((std::min(rotatedSize.width,rotatedSize.height)-1)/2);
+
+	Mat legacy(nbImages*nbAngles,D,CV_64F);
+	int64 start=getTickCount();
+	for(int i=0;i<nbImages;i++){
+		for(int a=0;a<nbAngles;a++){
+			Mat rotated=MyTools::rotateColIm(images[i],angles[a]);
+			vector<double> d=legacyDescriptor(type,rotated,Biv,Dcircles);
+			std::copy(d.begin(),d.end(),legacy.ptr<double>(i*nbAngles+a));
+		}
+	}
+	double tLegacy=(getTickCount()-start)/getTickFrequency();
+
+	start=getTickCount();
+	Mat fast=augmenter.compute(images);
+	double tFast=(getTickCount()-start)/getTickFrequency();
+
+	// The maps round the interpolation coefficients as cv::warpAffine does, the rest is the
+	// difference of the legacy and of the extractor descriptors
+	double diff=0,scale=0;
+	const int n=type==GCFD1_DESCRIPTOR ? D/2 : D;
+	for(int r=0;r<fast.rows;r++){
+		for(int k=0;k<D;k++){
+			if(k%n!=0){
+				diff=std::max(diff,std::abs(fast.at<double>(r,k)-legacy.at<double>(r,k)));
+				scale=std::max(scale,std::abs(legacy.at<double>(r,k)));
+			}
+		}
+	}
+	diff/=scale>0 ? scale : 1;
+
+	BenchCheck check;
+	double imageDiff=0;
+	bool sameFormat=true;
+	for(int a=0;a<nbAngles && sameFormat;a++){
+		Mat rotated=MyTools::rotateColIm(images[0],angles[a]);
+		Mat mapped=RotationMapper(images[0].size(),angles[a],ROTATION_SQUARE).apply(images[0]);
+		sameFormat=rotated.size()==mapped.size() && rotated.type()==mapped.type();
+		if(sameFormat)
+			imageDiff=std::max(imageDiff,norm(rotated,mapped,NORM_INF));
+	}
+	check.expect("size and type of the rotated images",sameFormat);
+	check.expect("rotated images vs rotateColIm",imageDiff,1.);
+	check.expect("augmenter vs legacy descriptors",diff,1e-2);
+
+	std::cout<<"size "<<width<<"x"<<height<<" rotated in "<<rotatedSize.width<<"x"<<rotatedSize.height<<", "<<nbAngles<<" angles, "<<D<<" values"<<std::endl;
+	std::cout<<"legacy ms/image\taugmenter ms/image\tspeedup\tmax diff"<<std::endl;
+	std::cout<<1000*tLegacy/fast.rows<<"\t"<<1000*tFast/fast.rows<<"\t"<<tLegacy/tFast<<"\t"<<diff<<std::endl;
+
+	vector<RotationDrift> drift=augmenter.validate(images);
+	std::cout<<"angle\tmean drift\tstd dev\tmax drift"<<std::endl;
+	for(size_t a=0;a<drift.size();a++)
+		std::cout<<drift[a].angle<<"\t"<<drift[a].mean<<"\t"<<drift[a].stdDev<<"\t"<<drift[a].max<<std::endl;
+	return check.getExitCode();
+}
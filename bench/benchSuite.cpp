@@ -0,0 +1,351 @@
+/**
+ * \file benchSuite.cpp
+ * \brief Benchmarks of the functions of the library on synthetic images
+ * \version 1.0
+ * \date October 17, 2026
+ *
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the distribution
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Usage: benchSuite [--filter=text] [--sizes=WxH,...] [--image=noise|smooth|shapes]
+ *                   [--min-time=s] [--json=file] [--baseline=file] [--tolerance=t] [--list]
+ *
+ * Measures the legacy functions (FFT2, CFT, MyTools, GFD1, GCFD1, GCFD3) and the
+ * plan-based ones which replace them, for square and non-square images of 64 to 1024 pixels.
+ * Typical use:
+ *   benchSuite --json=baseline.json          (before a change)
+ *   benchSuite --baseline=baseline.json      (after: prints the speedups, fails on a changed output)
+ * Each new function is also compared to the legacy one it replaces (see the equivalences at the
+ * end of main), and the program fails if their outputs differ, baseline or not.
+ * The benchmarks which use the masks of MyTools::computeDiscreteCircles are skipped for the
+ * images larger than 256 pixels: the masks of a 512x512 image take more than 500 MB.
+ */
+
+#include <iostream>
+#include <opencv/cv.h>
+#include "BenchHarness.h"
+#include "SyntheticImages.h"
+#include "../FFT2.h"
+#include "../CFT.h"
+#include "../MyTools.h"
+#include "../GFD1.h"
+#include "../GCFD1.h"
+#include "../GCFD3.h"
+#include "../CFTPlan.h"
+#include "../CircleTable.h"
+#include "../CircleTableCache.h"
+#include "../PolarMapper.h"
+#include "../SpectrumTools.h"
+
+using namespace cv;
+
+/*! Largest size of the images for which the masks of the discrete circles are built */
+static const int maxCircleSize=256;
+
+static Mat biv(){
+	return (Mat_<double>(1,3) << 1,0,0);
+}
+
+static Mat grayImage(const BenchState& state,const int& depth){
+	Mat im=SyntheticImages::generate(state.getSize(),state.getKind(),1);
+	Mat res;
+	im.convertTo(res,depth);
+	return res;
+}
+
+static bool checkCircleSize(BenchState& state){
+	if(std::min(state.getSize().width,state.getSize().height)<=maxCircleSize)
+		return true;
+	state.skip("the discrete circles are too large");
+	return false;
+}
+
+/*!
+ *  \brief The cropped spectrum integrated by the descriptors
+ */
+static Mat descriptorSpectrum(const BenchState& state){
+	Mat X=CFTPlan::cropToOddSize(grayImage(state,CV_64F)).clone();
+	FFT2 F(X);
+	Mat spectrum=F;
+	FFT2::cropSpectrum(spectrum);
+	return spectrum;
+}
+
+static void benchFFT2Forward(BenchState& state){
+	Mat X=grayImage(state,CV_64F);
+	Mat res;
+	while(state.keepRunning()){
+		FFT2 F(X);
+		res=F;
+	}
+	state.setResult(res);
+}
+
+static void benchFFT2Inverse(BenchState& state){
+	FFT2 F(grayImage(state,CV_64F));
+	Mat spectrum=F;
+	Mat res;
+	while(state.keepRunning()){
+		FFT2 I(spectrum,-1);
+		res=I;
+	}
+	state.setResult(res);
+}
+
+/*!
+ *  \brief The spectrum is copied at each iteration so that the result does not depend on their number
+ */
+static void benchFFT2Shift(BenchState& state){
+	FFT2 F(grayImage(state,CV_64F));
+	Mat spectrum=F;
+	Mat res;
+	while(state.keepRunning()){
+		spectrum.copyTo(res);
+		FFT2::fftshift(res);
+	}
+	state.setResult(res);
+}
+
+static void benchSpectrumShift(BenchState& state){
+	FFT2 F(grayImage(state,CV_64F));
+	Mat spectrum=F;
+	Mat res;
+	while(state.keepRunning()){
+		spectrum.copyTo(res);
+		SpectrumTools::fftshift(res);
+	}
+	state.setResult(res);
+}
+
+static void benchFFT2Crop(BenchState& state){
+	FFT2 F(grayImage(state,CV_64F));
+	Mat spectrum=F;
+	Mat buffer,res;
+	while(state.keepRunning()){
+		spectrum.copyTo(buffer);
+		res=buffer;
+		FFT2::cropSpectrum(res);
+	}
+	state.setResult(res);
+}
+
+static void benchSpectrumCrop(BenchState& state){
+	FFT2 F(grayImage(state,CV_64F));
+	Mat spectrum=F;
+	Mat buffer,res;
+	while(state.keepRunning()){
+		spectrum.copyTo(buffer);
+		res=buffer;
+		SpectrumTools::cropSpectrum(res);
+	}
+	state.setResult(res);
+}
+
+static void benchSpectrumMagnitude(BenchState& state){
+	FFT2 F(grayImage(state,CV_64F));
+	Mat spectrum=F;
+	Mat res;
+	while(state.keepRunning())
+		SpectrumTools::magnitude(spectrum,res,SPECTRUM_SHIFT|SPECTRUM_CROP);
+	state.setResult(res);
+}
+
+static void benchCFTForward(BenchState& state){
+	Mat X=SyntheticImages::generate(state.getSize(),state.getKind());
+	Mat Biv=biv();
+	CFT cft;
+	vector<Mat> res;
+	while(state.keepRunning())
+		res=cft.computeCFT(X,Biv);
+	// Only the parallel and orthogonal parts, as CFTPlan/execute
+	res.resize(2);
+	state.setResult(res);
+}
+
+static void benchCFTInverse(BenchState& state){
+	Mat X;
+	SyntheticImages::generate(state.getSize(),state.getKind()).convertTo(X,CV_64F,1./255);
+	Mat Biv=biv();
+	CFT cft;
+	vector<Mat> res;
+	while(state.keepRunning())
+		res=cft.computeICFT(X,Biv);
+	state.setResult(res);
+}
+
+static void benchCFTPlan(BenchState& state){
+	Mat X=SyntheticImages::generate(state.getSize(),state.getKind());
+	CFTPlan plan(X.rows,X.cols,biv());
+	vector<Mat> res(2);
+	while(state.keepRunning())
+		plan.execute(X,res[0],res[1]);
+	state.setResult(res);
+}
+
+static void benchCFTPlanPacked(BenchState& state){
+	Mat X=SyntheticImages::generate(state.getSize(),state.getKind());
+	CFTPlan plan(X.rows,X.cols,biv());
+	vector<Mat> res(2);
+	while(state.keepRunning())
+		plan.executePacked(X,res[0],res[1]);
+	state.setResult(res);
+}
+
+static void benchImCart2Pol(BenchState& state){
+	Mat X=grayImage(state,CV_8U);
+	Mat res;
+	while(state.keepRunning())
+		res=MyTools::imCart2Pol(X,"full");
+	state.setResult(res);
+}
+
+static void benchPolarMapper(BenchState& state){
+	Mat X=grayImage(state,CV_8U);
+	PolarMapper mapper(X.size(),POLAR_FULL);
+	Mat res;
+	while(state.keepRunning())
+		mapper.apply(X,res);
+	state.setResult(res);
+}
+
+static void benchComputeDiscreteCircles(BenchState& state){
+	if(!checkCircleSize(state))
+		return;
+	int maxR=std::min(state.getSize().width,state.getSize().height)/2;
+	vector<Mat> res;
+	while(state.keepRunning())
+		res=MyTools::computeDiscreteCircles(maxR);
+	state.setResult(res);
+}
+
+static void benchIntegrOnCircles(BenchState& state){
+	if(!checkCircleSize(state))
+		return;
+	Mat spectrum=descriptorSpectrum(state);
+	vector<Mat> Dcircles=MyTools::computeDiscreteCircles(spectrum.rows/2);
+	vector<double> res;
+	while(state.keepRunning())
+		res=MyTools::integrOnCircles(spectrum,Dcircles);
+	state.setResult(res);
+}
+
+static void benchCircleTable(BenchState& state){
+	if(!checkCircleSize(state))
+		return;
+	Mat spectrum=descriptorSpectrum(state);
+	CircleTable table(spectrum.rows/2);
+	vector<double> res(table.getNbCircles()+1);
+	while(state.keepRunning())
+		table.integrate(spectrum,&res[0]);
+	state.setResult(res);
+}
+
+static void benchCircleTableCache(BenchState& state){
+	if(!checkCircleSize(state))
+		return;
+	Mat spectrum=descriptorSpectrum(state);
+	CircleTableCache::get(spectrum.rows/2);
+	vector<double> res;
+	while(state.keepRunning())
+		res=CircleTableCache::get(spectrum.rows/2)->integrate(spectrum);
+	state.setResult(res);
+}
+
+template<typename D> static void benchDescriptor(BenchState& state){
+	if(!checkCircleSize(state))
+		return;
+	Mat im=SyntheticImages::generate(state.getSize(),state.getKind());
+	Mat Biv=biv();
+	int maxR=std::min(im.rows-(im.rows%2==0),im.cols-(im.cols%2==0))/2;
+	vector<Mat> Dcircles=MyTools::computeDiscreteCircles(maxR);
+	vector<double> res;
+	while(state.keepRunning()){
+		D d(im,Biv,Dcircles);
+		res=d;
+	}
+	state.setResult(res);
+}
+
+template<typename D> static void benchDescriptorPlan(BenchState& state){
+	if(!checkCircleSize(state))
+		return;
+	Mat im=SyntheticImages::generate(state.getSize(),state.getKind());
+	Mat X=CFTPlan::cropToOddSize(im);
+	CFTPlan plan(X.rows,X.cols,biv());
+	CircleTable table(std::min(X.rows,X.cols)/2);
+	vector<double> res;
+	while(state.keepRunning()){
+		D d(im,plan,table);
+		res=d;
+	}
+	state.setResult(res);
+}
+
+int main(int argc,char** argv){
+	vector<Size> sizes;
+	for(int s=64;s<=1024;s*=2)
+		sizes.push_back(Size(s,s));
+	sizes.push_back(Size(96,64));
+	sizes.push_back(Size(640,480));
+	sizes.push_back(Size(1024,768));
+
+	BenchHarness harness(sizes);
+	harness.add("FFT2/forward",benchFFT2Forward);
+	harness.add("FFT2/inverse",benchFFT2Inverse);
+	harness.add("FFT2/fftshift",benchFFT2Shift);
+	harness.add("SpectrumTools/fftshift",benchSpectrumShift);
+	harness.add("FFT2/cropSpectrum",benchFFT2Crop);
+	harness.add("SpectrumTools/cropSpectrum",benchSpectrumCrop);
+	harness.add("SpectrumTools/magnitude",benchSpectrumMagnitude);
+	harness.add("CFT/computeCFT",benchCFTForward);
+	harness.add("CFT/computeICFT",benchCFTInverse);
+	harness.add("CFTPlan/execute",benchCFTPlan);
+	harness.add("CFTPlan/executePacked",benchCFTPlanPacked);
+	harness.add("MyTools/imCart2Pol",benchImCart2Pol);
+	harness.add("PolarMapper/apply",benchPolarMapper);
+	harness.add("MyTools/computeDiscreteCircles",benchComputeDiscreteCircles);
+	harness.add("MyTools/integrOnCircles",benchIntegrOnCircles);
+	harness.add("CircleTable/integrate",benchCircleTable);
+	harness.add("CircleTableCache/integrate",benchCircleTableCache);
+	harness.add("GFD1/computeFeatures",benchDescriptor<GFD1>);
+	harness.add("GCFD1/computeFeatures",benchDescriptor<GCFD1>);
+	harness.add("GCFD3/computeFeatures",benchDescriptor<GCFD3>);
+	harness.add("GFD1/plan",benchDescriptorPlan<GFD1>);
+	harness.add("GCFD1/plan",benchDescriptorPlan<GCFD1>);
+	harness.add("GCFD3/plan",benchDescriptorPlan<GCFD3>);
+
+	// The new functions against the legacy ones: the differences of the spectra are relative to
+	// their largest magnitude, the ones of the energies and of the descriptors to each value
+	harness.addEquivalence("SpectrumTools/fftshift","FFT2/fftshift",0);
+	harness.addEquivalence("SpectrumTools/cropSpectrum","FFT2/cropSpectrum",0);
+	harness.addEquivalence("CFTPlan/execute","CFT/computeCFT",1e-9);
+	harness.addEquivalence("PolarMapper/apply","MyTools/imCart2Pol",0);
+	harness.addEquivalence("CircleTable/integrate","MyTools/integrOnCircles",1e-12,true);
+	harness.addEquivalence("CircleTableCache/integrate","MyTools/integrOnCircles",1e-12,true);
+	harness.addEquivalence("GFD1/plan","GFD1/computeFeatures",1e-9,true);
+	harness.addEquivalence("GCFD1/plan","GCFD1/computeFeatures",1e-9,true);
+	harness.addEquivalence("GCFD3/plan","GCFD3/computeFeatures",1e-9,true);
+	return harness.run(argc,argv);
+}
@@ -0,0 +1,113 @@
+/**
+ * \file testCFTPlan.cpp
+ * \brief Regression test of CFTPlan against CFT::computeCFT
+ * \version 1.0
+ * \date October 17, 2026
+ *
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the distribution
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Usage: testCFTPlan
+ *
+ * Computes the CFT of random images of odd and even, square and non-square sizes, in uchar
+ * BGR and BGRA and in double BGR, for several color vectors, with CFT::computeCFT and with:
+ *   - CFTPlan::execute;
+ *   - CFTPlan::executePacked, with the parallel part unpacked by RealFFT2::unpack (BGR only);
+ *   - CFTPlanf::execute.
+ * Fails if a part differs from the legacy one by more than 1e-12 (1e-5 for CFTPlanf),
+ * relative to the largest magnitude of the legacy part.
+ */
+
+#include <iostream>
+#include <opencv/cv.h>
+#include "../MyTools.h"
+#include "../CFT.h"
+#include "../CFTPlan.h"
+#include "../RealFFT2.h"
+#include "../bench/BenchCheck.h"
+
+using namespace cv;
+
+/*!
+ *  \brief Largest difference between two complex spectra, relative to the largest value of the reference
+ */
+static double spectrumDiff(const Mat& res,const Mat& ref){
+	if(res.size()!=ref.size() || res.channels()!=ref.channels())
+		return HUGE_VAL;
+	Mat res64,ref64;
+	res.convertTo(res64,CV_64F);
+	ref.convertTo(ref64,CV_64F);
+	double scale=norm(ref64,NORM_INF);
+	return norm(res64-ref64,NORM_INF)/(scale>0 ? scale : 1.);
+}
+
+int main(){
+	const Size sizes[]={Size(15,15),Size(16,16),Size(15,11),Size(16,12),Size(11,17),Size(18,12)};
+	const int nbSizes=sizeof(sizes)/sizeof(sizes[0]);
+	const int types[]={CV_8UC3,CV_8UC4,CV_64FC3};
+	const int nbTypes=sizeof(types)/sizeof(types[0]);
+	const double tolerance=1e-12,tolerancef=1e-5;
+	RNG rng(0);
+	vector<Mat> vectors;
+	vectors.push_back((Mat_<double>(1,3) << 1,0,0));
+	vectors.push_back((Mat_<double>(1,3) << 1,1,1));
+	vectors.push_back((Mat_<double>(1,3) << rng.uniform(0.,1.),rng.uniform(0.,1.),rng.uniform(0.,1.)));
+	BenchCheck check;
+	CFT cft;
+	for(int s=0;s<nbSizes;s++){
+		for(int t=0;t<nbTypes;t++){
+			Mat im(sizes[s],types[t]);
+			if(CV_MAT_DEPTH(types[t])==CV_8U)
+				rng.fill(im,RNG::UNIFORM,0,256);
+			else
+				rng.fill(im,RNG::UNIFORM,0.,255.);
+			for(size_t v=0;v<vectors.size();v++){
+				vector<Mat> ref=cft.computeCFT(im,vectors[v]);
+				string name=MyTools::Int2Str(sizes[s].width)+"x"+MyTools::Int2Str(sizes[s].height)
+					+" type "+MyTools::Int2Str(types[t])+" vector "+MyTools::Int2Str((int)v);
+
+				Mat par,orth;
+				CFTPlan plan(im.rows,im.cols,vectors[v]);
+				plan.execute(im,par,orth);
+				check.expect(name+": execute, parallel part",spectrumDiff(par,ref[0]),tolerance);
+				check.expect(name+": execute, orthogonal part",spectrumDiff(orth,ref[1]),tolerance);
+
+				if(im.channels()==3){
+					Mat packed,unpacked;
+					plan.executePacked(im,packed,orth);
+					RealFFT2::unpack(packed,unpacked);
+					check.expect(name+": executePacked, parallel part",spectrumDiff(unpacked,ref[0]),tolerance);
+					check.expect(name+": executePacked, orthogonal part",spectrumDiff(orth,ref[1]),tolerance);
+				}
+
+				CFTPlanf planf(im.rows,im.cols,vectors[v]);
+				planf.execute(im,par,orth);
+				check.expect(name+": CFTPlanf, parallel part",spectrumDiff(par,ref[0]),tolerancef);
+				check.expect(name+": CFTPlanf, orthogonal part",spectrumDiff(orth,ref[1]),tolerancef);
+			}
+		}
+	}
+	return check.getExitCode();
+}
@@ -0,0 +1,88 @@
+/**
+ * \file testCircleTable.cpp
+ * \brief Regression test of CircleTable against MyTools::integrOnCircles
+ * \version 1.0
+ * \date October 17, 2026
+ *
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the distribution
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Usage: testCircleTable
+ *
+ * Integrates the spectra of random images of odd and even, square and non-square sizes,
+ * cropped to odd sizes as done by the descriptors, with MyTools::integrOnCircles on the
+ * spectrum cropped by FFT2::cropSpectrum, and with CircleTable:
+ *   - integrate on the cropped spectrum, with the table of the radius and with the table
+ *     compiled from the masks of MyTools::computeDiscreteCircles;
+ *   - integrate on the whole spectrum, read up to the radius of the table;
+ *   - integrateCCS on the packed spectrum of RealFFT2.
+ * Fails if a value differs from the legacy one by more than 1e-12, relative to the legacy
+ * value.
+ */
+
+#include <iostream>
+#include <opencv/cv.h>
+#include "../MyTools.h"
+#include "../FFT2.h"
+#include "../CFTPlan.h"
+#include "../CircleTable.h"
+#include "../RealFFT2.h"
+#include "../bench/BenchCheck.h"
+
+using namespace cv;
+
+int main(){
+	const Size sizes[]={Size(63,63),Size(64,64),Size(63,47),Size(64,48),Size(47,95),Size(96,64)};
+	const int nbSizes=sizeof(sizes)/sizeof(sizes[0]);
+	const double tolerance=1e-12;
+	RNG rng(0);
+	BenchCheck check;
+	for(int s=0;s<nbSizes;s++){
+		Mat im(sizes[s],CV_8UC1);
+		rng.fill(im,RNG::UNIFORM,0,256);
+		Mat X;
+		CFTPlan::cropToOddSize(im).convertTo(X,CV_64F);
+		FFT2 F(X);
+		Mat spectrum=F;
+		Mat cropped=spectrum.clone();
+		FFT2::cropSpectrum(cropped);
+		const int maxR=cropped.rows/2;
+		vector<Mat> Dcircles=MyTools::computeDiscreteCircles(maxR);
+		vector<double> ref=MyTools::integrOnCircles(cropped,Dcircles);
+
+		string name=MyTools::Int2Str(sizes[s].width)+"x"+MyTools::Int2Str(sizes[s].height);
+		CircleTable table(maxR),tableOfMasks(Dcircles);
+		check.expect(name+": integrate",BenchCheck::relativeDiff(Mat(table.integrate(cropped)),Mat(ref)),tolerance);
+		check.expect(name+": integrate with the table of the masks",BenchCheck::relativeDiff(Mat(tableOfMasks.integrate(cropped)),Mat(ref)),tolerance);
+		check.expect(name+": integrate of the whole spectrum",BenchCheck::relativeDiff(Mat(table.integrate(spectrum)),Mat(ref)),tolerance);
+
+		Mat ccs;
+		RealFFT2::computeFFT2(X,ccs);
+		vector<double> packed(table.getNbCircles()+1);
+		table.integrateCCS(ccs,&packed[0]);
+		check.expect(name+": integrateCCS",BenchCheck::relativeDiff(Mat(packed),Mat(ref)),tolerance);
+	}
+	return check.getExitCode();
+}
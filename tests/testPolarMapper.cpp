@@ -0,0 +1,101 @@
+/**
+ * \file testPolarMapper.cpp
+ * \brief Regression test of PolarMapper against MyTools::imCart2Pol and colImCart2Pol
+ * \version 1.0
+ * \date October 17, 2026
+ *
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the distribution
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Usage: testPolarMapper
+ *
+ * Converts random gray level and color images of odd and even, square and non-square sizes
+ * to polar images, for both methods, with the legacy functions and with PolarMapper:
+ *   - imCart2Pol(im,method) and colImCart2Pol(im,method) against the mapper of the size and
+ *     of the method, whose full radius is not an integer for most of the sizes;
+ *   - imCart2Pol(im,method,center) and colImCart2Pol(im,method,center) against the mapper of
+ *     the center, whose radius is truncated to an integer, for the center given by
+ *     getImageCenter and for a center away from the middle of the image.
+ * Fails if a polar image differs from the legacy one, in size, in type or in value.
+ */
+
+#include <iostream>
+#include <opencv/cv.h>
+#include "../MyTools.h"
+#include "../PolarMapper.h"
+#include "../bench/BenchCheck.h"
+
+using namespace cv;
+
+/*!
+ *  \brief Largest difference between two polar images, HUGE_VAL if their sizes or types differ
+ */
+static double polarDiff(const Mat& res,const Mat& ref){
+	if(res.size()!=ref.size() || res.type()!=ref.type())
+		return HUGE_VAL;
+	return norm(res,ref,NORM_INF);
+}
+
+int main(){
+	const Size sizes[]={Size(15,15),Size(16,16),Size(15,11),Size(16,12),Size(11,17),Size(18,12)};
+	const int nbSizes=sizeof(sizes)/sizeof(sizes[0]);
+	const int types[]={CV_8UC1,CV_64FC1,CV_8UC3};
+	const int nbTypes=sizeof(types)/sizeof(types[0]);
+	const char* methods[2]={"full","crop"};
+	RNG rng(0);
+	BenchCheck check;
+	for(int s=0;s<nbSizes;s++){
+		for(int t=0;t<nbTypes;t++){
+			Mat im(sizes[s],types[t]);
+			if(CV_MAT_DEPTH(types[t])==CV_8U)
+				rng.fill(im,RNG::UNIFORM,0,256);
+			else
+				rng.fill(im,RNG::UNIFORM,0.,1.);
+			const bool color=im.channels()==3;
+			vector<vector<double> > centers;
+			centers.push_back(MyTools::getImageCenter(im));
+			vector<double> offCenter(2);
+			offCenter[0]=im.rows/3.+0.25;
+			offCenter[1]=im.cols/4.+0.5;
+			centers.push_back(offCenter);
+			for(int m=0;m<2;m++){
+				string name=MyTools::Int2Str(sizes[s].width)+"x"+MyTools::Int2Str(sizes[s].height)
+					+" type "+MyTools::Int2Str(types[t])+" "+methods[m];
+				PolarMethod method=PolarMapper::parseMethod(methods[m]);
+
+				Mat ref=color ? MyTools::colImCart2Pol(im,methods[m]) : MyTools::imCart2Pol(im,methods[m]);
+				PolarMapper mapper(im.size(),method);
+				check.expect(name,polarDiff(mapper.apply(im),ref),0.);
+
+				for(size_t c=0;c<centers.size();c++){
+					ref=color ? MyTools::colImCart2Pol(im,methods[m],centers[c]) : MyTools::imCart2Pol(im,methods[m],centers[c]);
+					PolarMapper centered(im.size(),centers[c],method);
+					check.expect(name+" center "+MyTools::Int2Str((int)c),polarDiff(centered.apply(im),ref),0.);
+				}
+			}
+		}
+	}
+	return check.getExitCode();
+}
@@ -0,0 +1,105 @@
+/**
+ * \file testSpectrumTools.cpp
+ * \brief Regression test of SpectrumTools against FFT2::fftshift and FFT2::cropSpectrum
+ * \version 1.0
+ * \date October 17, 2026
+ *
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the distribution
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Usage: testSpectrumTools
+ *
+ * Shifts and crops random spectra of odd and even, square and non-square sizes, of one and
+ * two channels of double, of float and of uchar, with FFT2 and with SpectrumTools:
+ *   - fftshift against FFT2::fftshift, and ifftshift of the result against the spectrum;
+ *   - cropSpectrum against FFT2::cropSpectrum;
+ *   - magnitude with SPECTRUM_CROP|SPECTRUM_SHIFT against FFT2::cropSpectrum, then
+ *     MyTools::magnitude, then FFT2::fftshift (float and double only).
+ * Fails if a shifted or cropped spectrum is not identical to the legacy one, or if a
+ * magnitude differs from the legacy one by more than 1e-14 (1e-6 for float), relative to
+ * the legacy value.
+ */
+
+#include <iostream>
+#include <cstring>
+#include <opencv/cv.h>
+#include "../MyTools.h"
+#include "../FFT2.h"
+#include "../SpectrumTools.h"
+#include "../bench/BenchCheck.h"
+
+using namespace cv;
+
+/*!
+ *  \brief Check if two Mats have the same size, the same type and the same bytes
+ */
+static bool identical(const Mat& res,const Mat& ref){
+	if(res.size()!=ref.size() || res.type()!=ref.type())
+		return false;
+	for(int i=0;i<ref.rows;i++)
+		if(std::memcmp(res.ptr(i),ref.ptr(i),ref.cols*ref.elemSize())!=0)
+			return false;
+	return true;
+}
+
+int main(){
+	const Size sizes[]={Size(15,15),Size(16,16),Size(15,11),Size(16,12),Size(11,16),Size(12,17),Size(1,7),Size(8,1)};
+	const int nbSizes=sizeof(sizes)/sizeof(sizes[0]);
+	const int types[]={CV_64FC2,CV_64FC1,CV_32FC2,CV_8UC1};
+	const int nbTypes=sizeof(types)/sizeof(types[0]);
+	const double tolerance=1e-14,tolerancef=1e-6;
+	RNG rng(0);
+	BenchCheck check;
+	for(int s=0;s<nbSizes;s++){
+		for(int t=0;t<nbTypes;t++){
+			Mat X(sizes[s],types[t]);
+			rng.fill(X,RNG::UNIFORM,0,256);
+			string name=MyTools::Int2Str(sizes[s].width)+"x"+MyTools::Int2Str(sizes[s].height)
+				+" type "+MyTools::Int2Str(types[t]);
+
+			Mat ref=X.clone(),res=X.clone();
+			FFT2::fftshift(ref);
+			SpectrumTools::fftshift(res);
+			check.expect(name+": fftshift",identical(res,ref));
+			SpectrumTools::ifftshift(res);
+			check.expect(name+": ifftshift",identical(res,X));
+
+			ref=X.clone();
+			res=X.clone();
+			FFT2::cropSpectrum(ref);
+			SpectrumTools::cropSpectrum(res);
+			check.expect(name+": cropSpectrum",identical(res,ref));
+
+			if(X.depth()==CV_8U)
+				continue;
+			Mat mag;
+			ref=MyTools::magnitude(ref);
+			FFT2::fftshift(ref);
+			SpectrumTools::magnitude(X,mag,SPECTRUM_CROP|SPECTRUM_SHIFT);
+			check.expect(name+": magnitude",BenchCheck::relativeDiff(mag,ref),X.depth()==CV_32F ? tolerancef : tolerance);
+		}
+	}
+	return check.getExitCode();
+}